@@ -13,6 +13,7 @@
 #include "Utils/HighResolutionClock.h"
 #include "Utils/Logging.h"
 #include "Utils/SurfMath.h"
+#include "Utils/SurfMathBenchmark.h"
 
 #include <entt/entt.hpp>
 
@@ -31,6 +32,11 @@ struct
 	float3 ambient = float3{ 0.02f, 0.02f, 0.04f };
 } lightData;
 
+struct
+{
+	std::vector<SurfMathBenchmarkResult> results;
+} mathBenchmarkData;
+
 static void ResizeTargets(u32 w, u32 h)
 {
 	w = Max(w, 1u);
@@ -54,6 +60,31 @@ static void ResizeTargets(u32 w, u32 h)
 	screenData.DepthTex = CreateTexture(desc);
 }
 
+static void DrawMathBenchmarkUI()
+{
+	if (!ImGui::Begin("SurfMath"))
+	{
+		// Early out if the window is collapsed, as an optimization.
+		ImGui::End();
+		return;
+	}
+
+	ImGui::Text("Backend: %s", SurfMath_GetBackendName());
+
+	if (ImGui::Button("Run Benchmarks"))
+	{
+		SurfMath_RunBenchmarks(mathBenchmarkData.results);
+
+		for (const SurfMathBenchmarkResult& result : mathBenchmarkData.results)
+			LOGINFO("SurfMath %s: scalar %.2fns simd %.2fns (x%.2f) max error %g", result.name, result.scalarNs, result.simdNs, result.scalarNs / result.simdNs, result.maxError);
+	}
+
+	for (const SurfMathBenchmarkResult& result : mathBenchmarkData.results)
+		ImGui::Text("%-16s scalar %6.2fns simd %6.2fns x%.2f", result.name, result.scalarNs, result.simdNs, result.scalarNs / result.simdNs);
+
+	ImGui::End();
+}
+
 union MaterialID
 {
 	struct
@@ -363,6 +394,8 @@ int main()
 
 		ImGui::ShowDemoWindow();
 
+		DrawMathBenchmarkUI();
+
 		ImGui::Render();
 
 		updateClock.Tick();
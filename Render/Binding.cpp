@@ -1,7 +1,7 @@
 #include "Binding.h"
 #include "Textures.h"
 #include "Impl/BindingImpl.h"
-#include "IDArray.h"
+#include "ConcurrentIDArray.h"
 
 // TODO: Bindings should hold resource references, currently its the other way round
 
@@ -58,57 +58,81 @@ struct ViewData
 	{}
 };
 
-IDArray<ShaderResourceView_t, ViewData> g_SRVs;
-IDArray<UnorderedAccessView_t, ViewData> g_UAVs;
-IDArray<RenderTargetView_t, ViewData> g_RTVs;
-IDArray<DepthStencilView_t, ViewData> g_DSVs;
+ConcurrentIDArray<ShaderResourceView_t, ViewData> g_SRVs;
+ConcurrentIDArray<UnorderedAccessView_t, ViewData> g_UAVs;
+ConcurrentIDArray<RenderTargetView_t, ViewData> g_RTVs;
+ConcurrentIDArray<DepthStencilView_t, ViewData> g_DSVs;
 
 ShaderResourceView_t CreateTextureSRV(Texture_t tex, RenderFormat format, TextureDimension dim, uint32_t mipLevels, uint32_t arraySize)
+{
+	return CreateTextureSRV(tex, format, dim, 0u, mipLevels, 0u, arraySize);
+}
+
+UnorderedAccessView_t CreateTextureUAV(Texture_t tex, RenderFormat format, uint32_t arraySize)
+{
+	return CreateTextureUAV(tex, format, 0u, 0u, arraySize);
+}
+
+RenderTargetView_t CreateTextureRTV(Texture_t tex, RenderFormat format, uint32_t arraySize)
+{
+	return CreateTextureRTV(tex, format, 0u, 0u, arraySize);
+}
+
+DepthStencilView_t CreateTextureDSV(Texture_t tex, RenderFormat format, uint32_t arraySize)
+{
+	return CreateTextureDSV(tex, format, 0u, 0u, arraySize);
+}
+
+ShaderResourceView_t CreateTextureSRV(Texture_t tex, RenderFormat format, TextureDimension dim, uint32_t firstMip, uint32_t mipLevels, uint32_t firstSlice, uint32_t arraySize)
 {
 	ShaderResourceView_t srv = g_SRVs.Create(ViewData(tex, format));
 
-	if (!CreateTextureSRVImpl(srv, tex, format, dim, mipLevels, arraySize))
+	if (!CreateTextureSRVImpl(srv, tex, format, dim, firstMip, mipLevels, firstSlice, arraySize))
 	{
 		g_SRVs.Release(srv);
+		g_SRVs.Free(srv);
 		return ShaderResourceView_t::INVALID;
 	}
 
 	return srv;
 }
 
-UnorderedAccessView_t CreateTextureUAV(Texture_t tex, RenderFormat format, uint32_t arraySize)
+UnorderedAccessView_t CreateTextureUAV(Texture_t tex, RenderFormat format, uint32_t mipSlice, uint32_t firstSlice, uint32_t arraySize)
 {
 	UnorderedAccessView_t uav = g_UAVs.Create(ViewData(tex, format));
 
-	if (!CreateTextureUAVImpl(uav, tex, format, arraySize))
+	if (!CreateTextureUAVImpl(uav, tex, format, mipSlice, firstSlice, arraySize))
 	{
 		g_UAVs.Release(uav);
+		g_UAVs.Free(uav);
 		return UnorderedAccessView_t::INVALID;
 	}
 
 	return uav;
 }
 
-RenderTargetView_t CreateTextureRTV(Texture_t tex, RenderFormat format, uint32_t arraySize)
+RenderTargetView_t CreateTextureRTV(Texture_t tex, RenderFormat format, uint32_t mipSlice, uint32_t firstSlice, uint32_t arraySize)
 {
 	RenderTargetView_t rtv = g_RTVs.Create(ViewData(tex, format));
 
-	if (!CreateTextureRTVImpl(rtv, tex, format, arraySize))
+	if (!CreateTextureRTVImpl(rtv, tex, format, mipSlice, firstSlice, arraySize))
 	{
 		g_RTVs.Release(rtv);
+		g_RTVs.Free(rtv);
 		return RenderTargetView_t::INVALID;
 	}
 
 	return rtv;
 }
 
-DepthStencilView_t CreateTextureDSV(Texture_t tex, RenderFormat format, uint32_t arraySize)
+DepthStencilView_t CreateTextureDSV(Texture_t tex, RenderFormat format, uint32_t mipSlice, uint32_t firstSlice, uint32_t arraySize)
 {
 	DepthStencilView_t dsv = g_DSVs.Create(ViewData(tex, format));
 
-	if (!CreateTextureDSVImpl(dsv, tex, format, arraySize))
+	if (!CreateTextureDSVImpl(dsv, tex, format, mipSlice, firstSlice, arraySize))
 	{
 		g_DSVs.Release(dsv);
+		g_DSVs.Free(dsv);
 		return DepthStencilView_t::INVALID;
 	}
 
@@ -122,6 +146,7 @@ ShaderResourceView_t CreateStructuredBufferSRV(StructuredBuffer_t buf, uint32_t
 	if (!CreateStructuredBufferSRVImpl(srv, buf, firstElem, numElems))
 	{
 		g_SRVs.Release(srv);
+		g_SRVs.Free(srv);
 		return ShaderResourceView_t::INVALID;
 	}
 
@@ -135,6 +160,7 @@ UnorderedAccessView_t CreateStructuredBufferUAV(StructuredBuffer_t buf, uint32_t
 	if (!CreateStructuredBufferUAVImpl(uav, buf, firstElem, numElems))
 	{
 		g_UAVs.Release(uav);
+		g_UAVs.Free(uav);
 		return UnorderedAccessView_t::INVALID;
 	}
 
@@ -153,9 +179,10 @@ RenderTargetView_t AllocTextureRTV(RenderFormat format, uint32_t arraySize)
 {
 	RenderTargetView_t rtv = g_RTVs.Create(ViewData(Texture_t::INVALID, format));
 
-	if (!CreateTextureRTVImpl(rtv, Texture_t::INVALID, format, arraySize))
+	if (!CreateTextureRTVImpl(rtv, Texture_t::INVALID, format, 0u, 0u, arraySize))
 	{
 		g_RTVs.Release(rtv);
+		g_RTVs.Free(rtv);
 		return RenderTargetView_t::INVALID;
 	}
 
@@ -185,25 +212,37 @@ RenderFormat GetDSVFormat(DepthStencilView_t dsv)
 void ReleaseSRV(ShaderResourceView_t srv)
 {
 	if (g_SRVs.Release(srv))
+	{
 		DestroySRV(srv);
+		g_SRVs.Free(srv);
+	}
 }
 
 void ReleaseUAV(UnorderedAccessView_t uav)
 {
 	if (g_UAVs.Release(uav))
+	{
 		DestroyUAV(uav);
+		g_UAVs.Free(uav);
+	}
 }
 
 void ReleaseRTV(RenderTargetView_t rtv)
 {
 	if (g_RTVs.Release(rtv))
+	{
 		DestroyRTV(rtv);
+		g_RTVs.Free(rtv);
+	}
 }
 
 void ReleaseDSV(DepthStencilView_t dsv)
 {
 	if (g_DSVs.Release(dsv))
+	{
 		DestroyDSV(dsv);
+		g_DSVs.Free(dsv);
+	}
 }
 
 void Render_Release(ShaderResourceView_t srv)
@@ -245,3 +284,11 @@ size_t Bindings_GetDepthStencilViewCount()
 {
 	return g_DSVs.UsedSize();
 }
+
+void Bindings_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports)
+{
+	reports.push_back(g_SRVs.GetMemoryReport("Shader Resource Views"));
+	reports.push_back(g_UAVs.GetMemoryReport("Unordered Access Views"));
+	reports.push_back(g_RTVs.GetMemoryReport("Render Target Views"));
+	reports.push_back(g_DSVs.GetMemoryReport("Depth Stencil Views"));
+}
@@ -17,6 +17,13 @@ UnorderedAccessView_t CreateTextureUAV(Texture_t tex, RenderFormat format, uint3
 RenderTargetView_t CreateTextureRTV(Texture_t tex, RenderFormat format, uint32_t arraySize);
 DepthStencilView_t CreateTextureDSV(Texture_t tex, RenderFormat format, uint32_t arraySize);
 
+// Views of part of a texture. The SRV covers mipLevels mips from firstMip, ~0u for every remaining
+// mip, the other views a single mip. Each covers arraySize slices from firstSlice.
+ShaderResourceView_t CreateTextureSRV(Texture_t tex, RenderFormat format, TextureDimension dim, uint32_t firstMip, uint32_t mipLevels, uint32_t firstSlice, uint32_t arraySize);
+UnorderedAccessView_t CreateTextureUAV(Texture_t tex, RenderFormat format, uint32_t mipSlice, uint32_t firstSlice, uint32_t arraySize);
+RenderTargetView_t CreateTextureRTV(Texture_t tex, RenderFormat format, uint32_t mipSlice, uint32_t firstSlice, uint32_t arraySize);
+DepthStencilView_t CreateTextureDSV(Texture_t tex, RenderFormat format, uint32_t mipSlice, uint32_t firstSlice, uint32_t arraySize);
+
 ShaderResourceView_t CreateStructuredBufferSRV(StructuredBuffer_t buf, uint32_t firstElem, uint32_t numElems);
 UnorderedAccessView_t CreateStructuredBufferUAV(StructuredBuffer_t buf, uint32_t firstElem, uint32_t numElems);
 
@@ -41,4 +48,6 @@ void Render_Release(DepthStencilView_t dsv);
 size_t Bindings_GetShaderResourceViewCount();
 size_t Bindings_GetUnorderedAccessViewCount();
 size_t Bindings_GetRenderTargetViewCount();
-size_t Bindings_GetDepthStencilViewCount();
\ No newline at end of file
+size_t Bindings_GetDepthStencilViewCount();
+
+void Bindings_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports);
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include "Buffers.h"
-#include "IDArray.h"
+#include "ConcurrentIDArray.h"
 
 #include "Impl/BuffersImpl.h"
 
+#include <cstring>
+#include <mutex>
+
 struct BufferData
 {
 	size_t size;
@@ -12,10 +15,37 @@ struct BufferData
 	{}
 };
 
-IDArray<VertexBuffer_t, BufferData> g_VertexBuffers;
-IDArray<IndexBuffer_t, BufferData> g_IndexBuffers;
-IDArray<StructuredBuffer_t, BufferData> g_StructuredBuffers;
-IDArray<ConstantBuffer_t, BufferData> g_ConstantBuffers;
+ConcurrentIDArray<VertexBuffer_t, BufferData> g_VertexBuffers;
+ConcurrentIDArray<IndexBuffer_t, BufferData> g_IndexBuffers;
+ConcurrentIDArray<StructuredBuffer_t, BufferData> g_StructuredBuffers;
+ConcurrentIDArray<ConstantBuffer_t, BufferData> g_ConstantBuffers;
+
+static constexpr uint32_t kDynamicBufferFrameCount = 3;
+static constexpr size_t kDynamicBufferPageSize = 1024u * 1024u;
+static constexpr size_t kDynamicGeometryBufferAlignment = 16u;
+
+struct DynamicBufferPage
+{
+	std::unique_ptr<uint8_t[]> data;
+	size_t size = 0;
+	size_t used = 0;
+	size_t uploaded = 0;
+};
+
+// Pages owned by one frame in flight, allocation moves through them linearly.
+struct DynamicBufferFrame
+{
+	std::vector<uint32_t> pages[(size_t)DynamicBufferPageType::Count];
+	size_t currentPage[(size_t)DynamicBufferPageType::Count] = {};
+};
+
+// Dynamic buffers can be created while command lists are recorded on worker threads.
+std::vector<DynamicBufferPage> g_DynamicBufferPages;
+DynamicBufferFrame g_DynamicBufferFrames[kDynamicBufferFrameCount];
+uint32_t g_DynamicBufferFrameIndex = 0;
+DynamicBufferStats g_DynamicBufferStats;
+DynamicBufferStats g_DynamicBufferLastStats;
+std::mutex g_DynamicBuffersMutex;
 
 VertexBuffer_t CreateVertexBuffer(const void* const data, size_t size)
 {
@@ -24,6 +54,7 @@ VertexBuffer_t CreateVertexBuffer(const void* const data, size_t size)
 	if (!CreateVertexBufferImpl(newBuf, data, size))
 	{
 		g_VertexBuffers.Release(newBuf);
+		g_VertexBuffers.Free(newBuf);
 		return VertexBuffer_t::INVALID;
 	}
 
@@ -37,6 +68,7 @@ IndexBuffer_t CreateIndexBuffer(const void* const data, size_t size)
 	if (!CreateIndexBufferImpl(newBuf, data, size))
 	{
 		g_IndexBuffers.Release(newBuf);
+		g_IndexBuffers.Free(newBuf);
 		return IndexBuffer_t::INVALID;
 	}
 
@@ -50,6 +82,7 @@ StructuredBuffer_t CreateStructuredBuffer(const void* const data, size_t size, s
 	if (!CreateStructuredBufferImpl(newBuf, data, size, stride, flags))
 	{
 		g_StructuredBuffers.Release(newBuf);
+		g_StructuredBuffers.Free(newBuf);
 		return StructuredBuffer_t::INVALID;
 	}
 
@@ -63,12 +96,161 @@ ConstantBuffer_t CreateConstantBuffer(const void* const data, size_t size)
 	if (!CreateConstantBufferImpl(newBuf, data, size))
 	{
 		g_ConstantBuffers.Release(newBuf);
+		g_ConstantBuffers.Free(newBuf);
 		return ConstantBuffer_t::INVALID;
 	}
 
 	return newBuf;
 }
 
+static DynamicBuffer_t EncodeDynamicBuffer(uint32_t pageIndex, size_t offset, size_t alignedSize)
+{
+	return (DynamicBuffer_t)(((uint64_t)(pageIndex + 1) << 56) | ((uint64_t)(alignedSize / 16) << 32) | (uint64_t)offset);
+}
+
+static DynamicBuffer_t AllocateDynamicBuffer(DynamicBufferPageType type, const void* const data, size_t size)
+{
+	const size_t alignment = type == DynamicBufferPageType::Constant ? kDynamicConstantBufferAlignment : kDynamicGeometryBufferAlignment;
+	const size_t alignedSize = (size + alignment - 1) & ~(alignment - 1);
+
+	assert(alignedSize / 16 <= 0xffffff && "AllocateDynamicBuffer allocation too large");
+
+	std::lock_guard<std::mutex> lock(g_DynamicBuffersMutex);
+
+	DynamicBufferFrame& frame = g_DynamicBufferFrames[g_DynamicBufferFrameIndex];
+	std::vector<uint32_t>& pages = frame.pages[(size_t)type];
+	size_t& currentPage = frame.currentPage[(size_t)type];
+
+	// Allocations never straddle pages, move on to the next page with room for the whole allocation.
+	while (currentPage < pages.size() && g_DynamicBufferPages[pages[currentPage]].used + alignedSize > g_DynamicBufferPages[pages[currentPage]].size)
+		currentPage++;
+
+	if (currentPage == pages.size())
+	{
+		const uint32_t pageIndex = (uint32_t)g_DynamicBufferPages.size();
+		if (pageIndex >= kMaxDynamicBufferPages)
+		{
+			assert(0 && "AllocateDynamicBuffer out of dynamic buffer pages");
+			return DynamicBuffer_t::INVALID;
+		}
+
+		const size_t pageSize = alignedSize > kDynamicBufferPageSize ? alignedSize : kDynamicBufferPageSize;
+
+		if (!CreateDynamicBufferPageImpl(pageIndex, type, pageSize))
+			return DynamicBuffer_t::INVALID;
+
+		DynamicBufferPage& page = g_DynamicBufferPages.emplace_back();
+		page.data = std::make_unique<uint8_t[]>(pageSize);
+		page.size = pageSize;
+
+		pages.push_back(pageIndex);
+
+		g_DynamicBufferStats.pageCount++;
+		g_DynamicBufferStats.pageBytes += pageSize;
+	}
+
+	const uint32_t pageIndex = pages[currentPage];
+	DynamicBufferPage& page = g_DynamicBufferPages[pageIndex];
+
+	const size_t offset = page.used;
+	page.used += alignedSize;
+
+	if (data)
+		memcpy(page.data.get() + offset, data, size);
+
+	g_DynamicBufferStats.allocations++;
+	g_DynamicBufferStats.bytes += size;
+	g_DynamicBufferStats.alignmentBytes += alignedSize - size;
+
+	return EncodeDynamicBuffer(pageIndex, offset, alignedSize);
+}
+
+DynamicBuffer_t CreateDynamicVertexBuffer(const void* const data, size_t size)
+{
+	return AllocateDynamicBuffer(DynamicBufferPageType::Geometry, data, size);
+}
+
+DynamicBuffer_t CreateDynamicIndexBuffer(const void* const data, size_t size)
+{
+	return AllocateDynamicBuffer(DynamicBufferPageType::Geometry, data, size);
+}
+
+DynamicBuffer_t CreateDynamicConstantBuffer(const void* const data, size_t size)
+{
+	return AllocateDynamicBuffer(DynamicBufferPageType::Constant, data, size);
+}
+
+DynamicBuffer_t GetDynamicConstantBufferRange(DynamicBuffer_t db, size_t offset, size_t size)
+{
+	if (db == DynamicBuffer_t::INVALID)
+		return DynamicBuffer_t::INVALID;
+
+	const DynamicBufferAllocation alloc = DynamicBuffers_Decode(db);
+	const size_t alignedSize = (size + kDynamicConstantBufferAlignment - 1) & ~(kDynamicConstantBufferAlignment - 1);
+
+	if (offset % kDynamicConstantBufferAlignment != 0 || offset + alignedSize > alloc.size)
+	{
+		assert(0 && "GetDynamicConstantBufferRange range is misaligned or outside the buffer");
+		return DynamicBuffer_t::INVALID;
+	}
+
+	return EncodeDynamicBuffer(alloc.page, alloc.offset + offset, alignedSize);
+}
+
+void DynamicBuffers_NewFrame()
+{
+	std::lock_guard<std::mutex> lock(g_DynamicBuffersMutex);
+
+	g_DynamicBufferLastStats = g_DynamicBufferStats;
+
+	g_DynamicBufferFrameIndex = (g_DynamicBufferFrameIndex + 1) % kDynamicBufferFrameCount;
+
+	DynamicBufferFrame& frame = g_DynamicBufferFrames[g_DynamicBufferFrameIndex];
+
+	g_DynamicBufferStats = {};
+
+	for (size_t type = 0; type < (size_t)DynamicBufferPageType::Count; type++)
+	{
+		for (uint32_t pageIndex : frame.pages[type])
+		{
+			DynamicBufferPage& page = g_DynamicBufferPages[pageIndex];
+			page.used = 0;
+			page.uploaded = 0;
+
+			g_DynamicBufferStats.pageCount++;
+			g_DynamicBufferStats.pageBytes += page.size;
+		}
+
+		frame.currentPage[type] = 0;
+	}
+}
+
+void DynamicBuffers_Upload()
+{
+	std::lock_guard<std::mutex> lock(g_DynamicBuffersMutex);
+
+	const DynamicBufferFrame& frame = g_DynamicBufferFrames[g_DynamicBufferFrameIndex];
+
+	for (size_t type = 0; type < (size_t)DynamicBufferPageType::Count; type++)
+	{
+		for (uint32_t pageIndex : frame.pages[type])
+		{
+			DynamicBufferPage& page = g_DynamicBufferPages[pageIndex];
+
+			if (page.used > page.uploaded)
+			{
+				UploadDynamicBufferPageImpl(pageIndex, page.data.get(), page.uploaded, page.used);
+				page.uploaded = page.used;
+			}
+		}
+	}
+}
+
+const DynamicBufferStats& DynamicBuffers_GetStats()
+{
+	return g_DynamicBufferLastStats;
+}
+
 void UpdateVertexBuffer(VertexBuffer_t vb, const void* const data, size_t size)
 {
 	if (BufferData* bufData = g_VertexBuffers.Get(vb))
@@ -101,6 +283,7 @@ void Render_Release(VertexBuffer_t vb)
 	if (g_VertexBuffers.Release(vb))
 	{
 		DestroyVertexBuffer(vb);
+		g_VertexBuffers.Free(vb);
 	}
 }
 
@@ -109,6 +292,7 @@ void Render_Release(IndexBuffer_t ib)
 	if (g_IndexBuffers.Release(ib))
 	{
 		DestroyIndexBuffer(ib);
+		g_IndexBuffers.Free(ib);
 	}
 }
 
@@ -117,6 +301,7 @@ void Render_Release(StructuredBuffer_t sb)
 	if (g_StructuredBuffers.Release(sb))
 	{
 		DestroyStructuredBuffer(sb);
+		g_StructuredBuffers.Free(sb);
 	}
 }
 
@@ -125,6 +310,7 @@ void Render_Release(ConstantBuffer_t cb)
 	if (g_ConstantBuffers.Release(cb))
 	{
 		DestroyConstantBuffer(cb);
+		g_ConstantBuffers.Free(cb);
 	}
 }
 
@@ -166,4 +352,12 @@ size_t Buffers_GetStructuredBufferCount()
 size_t Buffers_GetConstantBufferCount()
 {
 	return g_ConstantBuffers.UsedSize();
+}
+
+void Buffers_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports)
+{
+	reports.push_back(g_VertexBuffers.GetMemoryReport("Vertex Buffers"));
+	reports.push_back(g_IndexBuffers.GetMemoryReport("Index Buffers"));
+	reports.push_back(g_StructuredBuffers.GetMemoryReport("Structured Buffers"));
+	reports.push_back(g_ConstantBuffers.GetMemoryReport("Constant Buffers"));
 }
\ No newline at end of file
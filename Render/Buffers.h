@@ -17,6 +17,13 @@ DynamicBuffer_t CreateDynamicVertexBuffer(const void* const data, size_t size);
 DynamicBuffer_t CreateDynamicIndexBuffer(const void* const data, size_t size);
 DynamicBuffer_t CreateDynamicConstantBuffer(const void* const data, size_t size);
 
+// Constant buffer allocations and the ranges bound from them are aligned to this.
+static constexpr size_t kDynamicConstantBufferAlignment = 256u;
+
+// Returns [offset, offset + size) of a dynamic constant buffer as its own buffer, so many small
+// constant blocks can be written with one allocation. offset must be aligned to kDynamicConstantBufferAlignment.
+DynamicBuffer_t GetDynamicConstantBufferRange(DynamicBuffer_t db, size_t offset, size_t size);
+
 void UpdateVertexBuffer(VertexBuffer_t vb, const void* const data, size_t size);
 void UpdateIndexBuffer(IndexBuffer_t ib, const void* const data, size_t size);
 void UpdateConstantBuffer(ConstantBuffer_t cb, const void* const data, size_t size);
@@ -31,9 +38,28 @@ void Render_Ref(IndexBuffer_t ib);
 void Render_Ref(StructuredBuffer_t sb);
 void Render_Ref(ConstantBuffer_t cb);
 
+struct DynamicBufferStats
+{
+	size_t allocations = 0;
+	size_t bytes = 0;
+	size_t alignmentBytes = 0;
+	size_t pageCount = 0;
+	size_t pageBytes = 0;
+};
+
+// Dynamic buffers live until the end of the frame they were created in. They are linearly allocated out of
+// per frame pages, NewFrame recycles the pages used kDynamicBufferFrameCount frames ago.
 void DynamicBuffers_NewFrame();
 
+// Copies dynamic buffer data written since the last upload to the backend, called before command lists execute.
+void DynamicBuffers_Upload();
+
+// Stats for the last completed frame.
+const DynamicBufferStats& DynamicBuffers_GetStats();
+
 size_t Buffers_GetVertexBufferCount();
 size_t Buffers_GetIndexBufferCount();
 size_t Buffers_GetStructuredBufferCount();
-size_t Buffers_GetConstantBufferCount();
\ No newline at end of file
+size_t Buffers_GetConstantBufferCount();
+
+void Buffers_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports);
\ No newline at end of file
@@ -1,3 +1,1013 @@
 #include "CommandList.h"
 
+#include "Buffers.h"
 #include "Textures.h"
+#include "Impl/CommandListImpl.h"
+
+std::vector<CommandListPtr> g_FreeCommandLists;
+CommandListStats g_CommandListStats;
+
+// Largest array a single recorded command can carry, matches the Dx11 shader resource slot count.
+static constexpr uint32_t kMaxCommandArrayCount = 128u;
+
+static constexpr uint32_t kMaxSRVSlots = 128u;
+static constexpr uint32_t kMaxCBVSlots = 14u;
+static constexpr uint32_t kMaxUAVSlots = 8u;
+static constexpr uint32_t kMaxVertexBufferSlots = 32u;
+
+// Barriers per recorded ResourceBarriers command, longer batches are recorded as several commands.
+static constexpr size_t kMaxRecordedBarriers = 64u;
+
+// Constant and dynamic buffers share CBV slots, tag dynamic buffers so the two never compare equal.
+static constexpr uint64_t kDynamicBufferTag = 1ull << 63ull;
+
+enum ShaderStage : uint32_t
+{
+	ShaderStage_Vertex,
+	ShaderStage_Geometry,
+	ShaderStage_Pixel,
+	ShaderStage_Compute,
+	ShaderStage_Count,
+};
+
+static_assert(kMaxSRVSlots % 64u == 0 && kMaxCBVSlots <= kMaxSRVSlots && kMaxUAVSlots <= kMaxSRVSlots && kMaxVertexBufferSlots <= kMaxSRVSlots, "BindRange is sized for the largest slot table");
+
+// Slots that have changed since the last flush, with the inclusive range they span. Slots inside the
+// range that weren't written are never sent, they may still hold the Invalidate() sentinel.
+struct BindRange
+{
+	uint32_t first = UINT32_MAX;
+	uint32_t last = 0;
+	uint64_t written[kMaxSRVSlots / 64u] = {};
+
+	bool Empty() const noexcept { return first > last; }
+	bool Contains(uint32_t slot) const noexcept { return (written[slot / 64u] >> (slot % 64u)) & 1u; }
+	void Clear() noexcept { *this = {}; }
+	void Add(uint32_t slot) noexcept
+	{
+		first = slot < first ? slot : first;
+		last = slot > last ? slot : last;
+		written[slot / 64u] |= 1ull << (slot % 64u);
+	}
+};
+
+// Shadow copy of everything bound through the list, used to drop binds that don't change anything.
+// Changed slots are only sent to the backend when a draw or dispatch needs them, so neighbouring
+// slots set by separate calls go out as one ranged call.
+struct CommandListBindCache
+{
+	uint64_t srvs[ShaderStage_Count][kMaxSRVSlots];
+	uint64_t cbvs[ShaderStage_Count][kMaxCBVSlots];
+	uint64_t uavs[kMaxUAVSlots];
+
+	uint64_t vertexBuffers[kMaxVertexBufferSlots];
+	uint32_t vertexStrides[kMaxVertexBufferSlots];
+	uint32_t vertexOffsets[kMaxVertexBufferSlots];
+
+	uint64_t indexBuffer;
+	RenderFormat indexFormat;
+	uint32_t indexOffset;
+
+	BindRange dirtySrvs[ShaderStage_Count];
+	BindRange dirtyCbvs[ShaderStage_Count];
+	BindRange dirtyUavs;
+	BindRange dirtyVertexBuffers;
+	bool dirty;
+
+	// Nothing is assumed about the backend state, the first bind to each slot always goes through.
+	void Invalidate()
+	{
+		memset(srvs, 0xff, sizeof(srvs));
+		memset(cbvs, 0xff, sizeof(cbvs));
+		memset(uavs, 0xff, sizeof(uavs));
+		memset(vertexBuffers, 0xff, sizeof(vertexBuffers));
+		memset(vertexStrides, 0xff, sizeof(vertexStrides));
+		memset(vertexOffsets, 0xff, sizeof(vertexOffsets));
+
+		indexBuffer = UINT64_MAX;
+		indexFormat = RenderFormat::UNKNOWN;
+		indexOffset = UINT32_MAX;
+
+		for (BindRange& range : dirtySrvs)
+			range.Clear();
+		for (BindRange& range : dirtyCbvs)
+			range.Clear();
+		dirtyUavs.Clear();
+		dirtyVertexBuffers.Clear();
+		dirty = false;
+	}
+
+	// Binding a resource as a render target, depth target or UAV makes the backend unbind any SRV
+	// holding it, so cached SRVs can no longer be trusted. Pending SRV binds still go through.
+	void InvalidateSRVs()
+	{
+		for (uint32_t stage = 0; stage < ShaderStage_Count; stage++)
+		{
+			for (uint32_t slot = 0; slot < kMaxSRVSlots; slot++)
+			{
+				if (!dirtySrvs[stage].Contains(slot))
+					srvs[stage][slot] = UINT64_MAX;
+			}
+		}
+	}
+};
+
+template<typename T>
+static inline uint64_t BindingKey(T value) { return (uint64_t)value; }
+static inline uint64_t BindingKey(DynamicBuffer_t value) { return (uint64_t)value | kDynamicBufferTag; }
+
+template<typename T>
+static inline T FromBindingKey(uint64_t key) { return (T)(key & ~kDynamicBufferTag); }
+
+static inline bool IsDynamicBindingKey(uint64_t key) { return (key & kDynamicBufferTag) != 0; }
+
+// Updates the cache with the slots that change and marks them dirty, returns false if none do.
+template<typename T>
+static bool FilterBinds(CommandListBindCache& bindCache, uint64_t* const cache, BindRange& dirty, uint32_t maxSlots, uint32_t startSlot, uint32_t count, const T* const values, CommandListStats& stats)
+{
+	stats.bindCalls++;
+
+	assert(startSlot + count <= maxSlots);
+	if (startSlot >= maxSlots)
+		return false;
+
+	count = startSlot + count > maxSlots ? maxSlots - startSlot : count;
+
+	bool changed = false;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const uint64_t key = BindingKey(values[i]);
+		if (cache[startSlot + i] == key)
+		{
+			stats.slotsSkipped++;
+			continue;
+		}
+
+		cache[startSlot + i] = key;
+		dirty.Add(startSlot + i);
+		changed = true;
+	}
+
+	if (!changed)
+	{
+		stats.bindCallsSkipped++;
+		return false;
+	}
+
+	bindCache.dirty = true;
+	return true;
+}
+
+template<typename T>
+static bool FilterVertexBuffers(CommandListBindCache& cache, uint32_t startSlot, uint32_t count, const T* const vbs, const uint32_t* const strides, const uint32_t* const offsets, CommandListStats& stats)
+{
+	stats.bindCalls++;
+
+	assert(startSlot + count <= kMaxVertexBufferSlots);
+	if (startSlot >= kMaxVertexBufferSlots)
+		return false;
+
+	count = startSlot + count > kMaxVertexBufferSlots ? kMaxVertexBufferSlots - startSlot : count;
+
+	bool changed = false;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const uint32_t slot = startSlot + i;
+		const uint64_t key = BindingKey(vbs[i]);
+		if (cache.vertexBuffers[slot] == key && cache.vertexStrides[slot] == strides[i] && cache.vertexOffsets[slot] == offsets[i])
+		{
+			stats.slotsSkipped++;
+			continue;
+		}
+
+		cache.vertexBuffers[slot] = key;
+		cache.vertexStrides[slot] = strides[i];
+		cache.vertexOffsets[slot] = offsets[i];
+		cache.dirtyVertexBuffers.Add(slot);
+		changed = true;
+	}
+
+	if (!changed)
+	{
+		stats.bindCallsSkipped++;
+		return false;
+	}
+
+	cache.dirty = true;
+	return true;
+}
+
+template<typename T>
+static bool FilterIndexBuffer(CommandListBindCache& cache, T ib, RenderFormat format, uint32_t indexOffset, CommandListStats& stats)
+{
+	stats.bindCalls++;
+
+	if (cache.indexBuffer == BindingKey(ib) && cache.indexFormat == format && cache.indexOffset == indexOffset)
+	{
+		stats.bindCallsSkipped++;
+		stats.slotsSkipped++;
+		return false;
+	}
+
+	cache.indexBuffer = BindingKey(ib);
+	cache.indexFormat = format;
+	cache.indexOffset = indexOffset;
+
+	return true;
+}
+
+// Calls func(startSlot, count, dynamic) for each run of contiguous written slots holding the same kind of buffer.
+template<typename Func>
+static void ForEachBindRun(const uint64_t* const keys, const BindRange& range, Func func)
+{
+	uint32_t slot = range.first;
+	while (slot <= range.last)
+	{
+		if (!range.Contains(slot))
+		{
+			slot++;
+			continue;
+		}
+
+		const uint32_t runStart = slot;
+		const bool dynamic = IsDynamicBindingKey(keys[runStart]);
+
+		do
+			slot++;
+		while (slot <= range.last && range.Contains(slot) && IsDynamicBindingKey(keys[slot]) == dynamic);
+
+		func(runStart, slot - runStart, dynamic);
+	}
+}
+
+typedef void (*BindSRVsImplFunc)(CommandListImpl*, uint32_t, uint32_t, const ShaderResourceView_t* const);
+typedef void (*BindCBVsImplFunc)(CommandListImpl*, uint32_t, uint32_t, const ConstantBuffer_t* const);
+typedef void (*BindDynamicCBVsImplFunc)(CommandListImpl*, uint32_t, uint32_t, const DynamicBuffer_t* const);
+
+struct StageBindFuncs
+{
+	CommandOp srvOp;
+	BindSRVsImplFunc srvImpl;
+	CommandOp cbvOp;
+	BindCBVsImplFunc cbvImpl;
+	CommandOp dynamicCbvOp;
+	BindDynamicCBVsImplFunc dynamicCbvImpl;
+};
+
+// There are no geometry shader SRV binds on CommandList.
+static const StageBindFuncs s_StageBindFuncs[ShaderStage_Count] =
+{
+	{ CommandOp::BindVertexSRVs, BindVertexSRVsImpl, CommandOp::BindVertexCBVs, BindVertexCBVsImpl, CommandOp::BindVertexDynamicCBVs, BindVertexCBVsImpl },
+	{ CommandOp::Count, nullptr, CommandOp::BindGeometryCBVs, BindGeometryCBVsImpl, CommandOp::BindGeometryDynamicCBVs, BindGeometryCBVsImpl },
+	{ CommandOp::BindPixelSRVs, BindPixelSRVsImpl, CommandOp::BindPixelCBVs, BindPixelCBVsImpl, CommandOp::BindPixelDynamicCBVs, BindPixelCBVsImpl },
+	{ CommandOp::BindComputeSRVs, BindComputeSRVsImpl, CommandOp::BindComputeCBVs, BindComputeCBVsImpl, CommandOp::BindComputeDynamicCBVs, BindComputeCBVsImpl },
+};
+
+template<typename T>
+static void RecordArray(CommandStream& stream, CommandOp op, uint32_t startSlot, uint32_t count, const T* const values)
+{
+	assert(count <= kMaxCommandArrayCount);
+
+	stream.Begin(op, sizeof(uint32_t) * 2 + sizeof(T) * count);
+	stream.Write(startSlot);
+	stream.Write(count);
+	stream.Write(values, count);
+}
+
+template<typename T>
+static void RecordVertexBuffers(CommandStream& stream, CommandOp op, uint32_t startSlot, uint32_t count, const T* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
+{
+	assert(count <= kMaxCommandArrayCount);
+
+	stream.Begin(op, sizeof(uint32_t) * 2 + (sizeof(T) + sizeof(uint32_t) * 2) * count);
+	stream.Write(startSlot);
+	stream.Write(count);
+	stream.Write(vbs, count);
+	stream.Write(strides, count);
+	stream.Write(offsets, count);
+}
+
+template<typename T>
+static void RecordCounted(CommandStream& stream, CommandOp op, const T* const values, size_t num)
+{
+	assert(num <= 8);
+
+	stream.Begin(op, sizeof(uint8_t) + sizeof(T) * num);
+	stream.Write((uint8_t)num);
+	stream.Write(values, num);
+}
+
+// Sends a range of cached bindings to the backend, or to the stream for recorded lists.
+template<typename T, typename ImplFunc>
+static void EmitBinds(CommandListImpl* impl, CommandStream* recordTo, CommandOp op, ImplFunc implFunc, const uint64_t* const keys, uint32_t startSlot, uint32_t count, CommandListStats& stats)
+{
+	T values[kMaxCommandArrayCount];
+	for (uint32_t i = 0; i < count; i++)
+		values[i] = FromBindingKey<T>(keys[startSlot + i]);
+
+	if (recordTo)
+		RecordArray(*recordTo, op, startSlot, count, values);
+	else
+		implFunc(impl, startSlot, count, values);
+
+	stats.bindCallsIssued++;
+}
+
+template<typename T>
+static void EmitVertexBuffers(CommandListImpl* impl, CommandStream* recordTo, CommandOp op, const CommandListBindCache& cache, uint32_t startSlot, uint32_t count, CommandListStats& stats)
+{
+	T vbs[kMaxVertexBufferSlots];
+	for (uint32_t i = 0; i < count; i++)
+		vbs[i] = FromBindingKey<T>(cache.vertexBuffers[startSlot + i]);
+
+	const uint32_t* const strides = &cache.vertexStrides[startSlot];
+	const uint32_t* const offsets = &cache.vertexOffsets[startSlot];
+
+	if (recordTo)
+		RecordVertexBuffers(*recordTo, op, startSlot, count, vbs, strides, offsets);
+	else
+		SetVertexBuffersImpl(impl, startSlot, count, vbs, strides, offsets);
+
+	stats.bindCallsIssued++;
+}
+
+template<typename T, typename Func>
+static void ReplayArray(CommandStreamReader& reader, Func func)
+{
+	T scratch[kMaxCommandArrayCount];
+
+	const uint32_t startSlot = reader.Read<uint32_t>();
+	const uint32_t count = reader.Read<uint32_t>();
+
+	func(startSlot, count, reader.Read(scratch, count));
+}
+
+template<typename T>
+static void ReplayVertexBuffers(CommandListImpl* cl, CommandStreamReader& reader)
+{
+	T vbs[kMaxCommandArrayCount];
+	uint32_t strides[kMaxCommandArrayCount];
+	uint32_t offsets[kMaxCommandArrayCount];
+
+	const uint32_t startSlot = reader.Read<uint32_t>();
+	const uint32_t count = reader.Read<uint32_t>();
+
+	reader.Read(vbs, count);
+	reader.Read(strides, count);
+	reader.Read(offsets, count);
+
+	SetVertexBuffersImpl(cl, startSlot, count, vbs, strides, offsets);
+}
+
+static void ReplayCommandStream(CommandListImpl* cl, const CommandStream& commands)
+{
+	CommandStreamReader reader(commands);
+	CommandHeader header;
+
+	while (reader.Next(header))
+	{
+		switch (header.op)
+		{
+		case CommandOp::ClearRenderTarget:
+		{
+			const RenderTargetView_t rtv = reader.Read<RenderTargetView_t>();
+			float col[4];
+			reader.Read(col, 4);
+			ClearRenderTargetImpl(cl, rtv, col);
+			break;
+		}
+		case CommandOp::ClearDepth:
+		{
+			const DepthStencilView_t dsv = reader.Read<DepthStencilView_t>();
+			ClearDepthImpl(cl, dsv, reader.Read<float>());
+			break;
+		}
+		case CommandOp::ClearUnorderedAccessView:
+		{
+			const UnorderedAccessView_t uav = reader.Read<UnorderedAccessView_t>();
+			float col[4];
+			reader.Read(col, 4);
+			ClearUnorderedAccessViewImpl(cl, uav, col);
+			break;
+		}
+		case CommandOp::ClearUnorderedAccessViewUint:
+		{
+			const UnorderedAccessView_t uav = reader.Read<UnorderedAccessView_t>();
+			uint32_t values[4];
+			reader.Read(values, 4);
+			ClearUnorderedAccessViewImpl(cl, uav, values);
+			break;
+		}
+		case CommandOp::SetRenderTargets:
+		{
+			RenderTargetView_t rtvs[8];
+			const uint8_t num = reader.Read<uint8_t>();
+			reader.Read(rtvs, num);
+			SetRenderTargetsImpl(cl, rtvs, num, reader.Read<DepthStencilView_t>());
+			break;
+		}
+		case CommandOp::SetViewports:
+		{
+			Viewport vps[8];
+			const uint8_t num = reader.Read<uint8_t>();
+			SetViewportsImpl(cl, reader.Read(vps, num), num);
+			break;
+		}
+		case CommandOp::SetDefaultScissor:
+			SetDefaultScissorImpl(cl);
+			break;
+		case CommandOp::SetScissors:
+		{
+			ScissorRect scissors[8];
+			const uint8_t num = reader.Read<uint8_t>();
+			SetScissorsImpl(cl, reader.Read(scissors, num), num);
+			break;
+		}
+		case CommandOp::SetGraphicsPipelineState:
+			SetGraphicsPipelineStateImpl(cl, reader.Read<GraphicsPipelineState_t>());
+			break;
+		case CommandOp::SetComputePipelineState:
+			SetComputePipelineStateImpl(cl, reader.Read<ComputePipelineState_t>());
+			break;
+		case CommandOp::SetVertexBuffers:
+			ReplayVertexBuffers<VertexBuffer_t>(cl, reader);
+			break;
+		case CommandOp::SetDynamicVertexBuffers:
+			ReplayVertexBuffers<DynamicBuffer_t>(cl, reader);
+			break;
+		case CommandOp::SetIndexBuffer:
+		{
+			const IndexBuffer_t ib = reader.Read<IndexBuffer_t>();
+			const RenderFormat format = reader.Read<RenderFormat>();
+			SetIndexBufferImpl(cl, ib, format, reader.Read<uint32_t>());
+			break;
+		}
+		case CommandOp::SetDynamicIndexBuffer:
+		{
+			const DynamicBuffer_t ib = reader.Read<DynamicBuffer_t>();
+			const RenderFormat format = reader.Read<RenderFormat>();
+			SetIndexBufferImpl(cl, ib, format, reader.Read<uint32_t>());
+			break;
+		}
+		case CommandOp::CopyTexture:
+		{
+			const Texture_t dst = reader.Read<Texture_t>();
+			CopyTextureImpl(cl, dst, reader.Read<Texture_t>());
+			break;
+		}
+		case CommandOp::ResourceBarriers:
+		{
+			ResourceBarrier barriers[kMaxRecordedBarriers];
+			const uint8_t num = reader.Read<uint8_t>();
+			ResourceBarriersImpl(cl, reader.Read(barriers, num), num);
+			break;
+		}
+		case CommandOp::DrawIndexedInstanced:
+		{
+			uint32_t args[5];
+			reader.Read(args, 5);
+			DrawIndexedInstancedImpl(cl, args[0], args[1], args[2], args[3], args[4]);
+			break;
+		}
+		case CommandOp::DrawInstanced:
+		{
+			uint32_t args[4];
+			reader.Read(args, 4);
+			DrawInstancedImpl(cl, args[0], args[1], args[2], args[3]);
+			break;
+		}
+		case CommandOp::Dispatch:
+		{
+			uint32_t args[3];
+			reader.Read(args, 3);
+			DispatchImpl(cl, args[0], args[1], args[2]);
+			break;
+		}
+
+#define REPLAY_BIND_CASE(Op, Type, ImplFunc)													\
+		case CommandOp::Op:																		\
+			ReplayArray<Type>(reader, [cl](uint32_t startSlot, uint32_t count, const Type* values)	\
+			{																					\
+				ImplFunc(cl, startSlot, count, values);											\
+			});																					\
+			break;																				\
+
+		REPLAY_BIND_CASE(BindVertexSRVs, ShaderResourceView_t, BindVertexSRVsImpl);
+		REPLAY_BIND_CASE(BindVertexCBVs, ConstantBuffer_t, BindVertexCBVsImpl);
+		REPLAY_BIND_CASE(BindVertexDynamicCBVs, DynamicBuffer_t, BindVertexCBVsImpl);
+		REPLAY_BIND_CASE(BindGeometryCBVs, ConstantBuffer_t, BindGeometryCBVsImpl);
+		REPLAY_BIND_CASE(BindGeometryDynamicCBVs, DynamicBuffer_t, BindGeometryCBVsImpl);
+		REPLAY_BIND_CASE(BindPixelSRVs, ShaderResourceView_t, BindPixelSRVsImpl);
+		REPLAY_BIND_CASE(BindPixelCBVs, ConstantBuffer_t, BindPixelCBVsImpl);
+		REPLAY_BIND_CASE(BindPixelDynamicCBVs, DynamicBuffer_t, BindPixelCBVsImpl);
+		REPLAY_BIND_CASE(BindComputeSRVs, ShaderResourceView_t, BindComputeSRVsImpl);
+		REPLAY_BIND_CASE(BindComputeUAVs, UnorderedAccessView_t, BindComputeUAVsImpl);
+		REPLAY_BIND_CASE(BindComputeCBVs, ConstantBuffer_t, BindComputeCBVsImpl);
+		REPLAY_BIND_CASE(BindComputeDynamicCBVs, DynamicBuffer_t, BindComputeCBVsImpl);
+
+#undef REPLAY_BIND_CASE
+
+		default:
+			assert(0 && "ReplayCommandStream unknown command");
+			reader.Skip(header.payloadSize);
+			break;
+		}
+	}
+}
+
+CommandList::CommandList(CommandListImpl* cl)
+	: impl(cl)
+	, bindCache(std::make_unique<CommandListBindCache>())
+{
+	bindCache->Invalidate();
+}
+
+CommandList::~CommandList()
+{
+	DestroyCommandListImpl(impl);
+}
+
+void CommandList::Begin()
+{
+	lastPipeline = GraphicsPipelineState_t::INVALID;
+	lastComputePipeline = ComputePipelineState_t::INVALID;
+
+	bindCache->Invalidate();
+	stats = {};
+
+	stream.Reset();
+
+	// Recorded lists don't touch the backend until they are executed.
+	if (mode == CommandListMode::Immediate)
+		BeginCommandListImpl(impl);
+}
+
+void CommandList::Finish()
+{
+	if (mode == CommandListMode::Recorded)
+	{
+		BeginCommandListImpl(impl);
+		ReplayCommandStream(impl, stream);
+	}
+
+	FinishCommandListImpl(impl);
+
+	lastPipeline = GraphicsPipelineState_t::INVALID;
+}
+
+void CommandList::FlushBinds()
+{
+	CommandListBindCache& cache = *bindCache;
+
+	if (!cache.dirty)
+		return;
+
+	CommandStream* recordTo = mode == CommandListMode::Recorded ? &stream : nullptr;
+
+	// UAVs go first so resources moving from UAV to SRV are never bound as both.
+	if (!cache.dirtyUavs.Empty())
+	{
+		ForEachBindRun(cache.uavs, cache.dirtyUavs, [&](uint32_t startSlot, uint32_t count, bool)
+		{
+			EmitBinds<UnorderedAccessView_t>(impl, recordTo, CommandOp::BindComputeUAVs, BindComputeUAVsImpl, cache.uavs, startSlot, count, stats);
+		});
+		cache.dirtyUavs.Clear();
+		cache.InvalidateSRVs();
+	}
+
+	for (uint32_t stage = 0; stage < ShaderStage_Count; stage++)
+	{
+		const StageBindFuncs& funcs = s_StageBindFuncs[stage];
+
+		if (!cache.dirtySrvs[stage].Empty())
+		{
+			const uint64_t* const keys = cache.srvs[stage];
+			ForEachBindRun(keys, cache.dirtySrvs[stage], [&](uint32_t startSlot, uint32_t count, bool)
+			{
+				EmitBinds<ShaderResourceView_t>(impl, recordTo, funcs.srvOp, funcs.srvImpl, keys, startSlot, count, stats);
+			});
+			cache.dirtySrvs[stage].Clear();
+		}
+
+		if (!cache.dirtyCbvs[stage].Empty())
+		{
+			const uint64_t* const keys = cache.cbvs[stage];
+			ForEachBindRun(keys, cache.dirtyCbvs[stage], [&](uint32_t startSlot, uint32_t count, bool dynamic)
+			{
+				if (dynamic)
+					EmitBinds<DynamicBuffer_t>(impl, recordTo, funcs.dynamicCbvOp, funcs.dynamicCbvImpl, keys, startSlot, count, stats);
+				else
+					EmitBinds<ConstantBuffer_t>(impl, recordTo, funcs.cbvOp, funcs.cbvImpl, keys, startSlot, count, stats);
+			});
+			cache.dirtyCbvs[stage].Clear();
+		}
+	}
+
+	if (!cache.dirtyVertexBuffers.Empty())
+	{
+		ForEachBindRun(cache.vertexBuffers, cache.dirtyVertexBuffers, [&](uint32_t startSlot, uint32_t count, bool dynamic)
+		{
+			if (dynamic)
+				EmitVertexBuffers<DynamicBuffer_t>(impl, recordTo, CommandOp::SetDynamicVertexBuffers, cache, startSlot, count, stats);
+			else
+				EmitVertexBuffers<VertexBuffer_t>(impl, recordTo, CommandOp::SetVertexBuffers, cache, startSlot, count, stats);
+		});
+		cache.dirtyVertexBuffers.Clear();
+	}
+
+	cache.dirty = false;
+}
+
+void CommandList::Replay(const CommandStream& commands)
+{
+	FlushBinds();
+
+	if (mode == CommandListMode::Immediate)
+	{
+		ReplayCommandStream(impl, commands);
+	}
+	else
+	{
+		CommandStreamReader reader(commands);
+		CommandHeader header;
+
+		while (reader.Next(header))
+		{
+			stream.Begin(header.op, header.payloadSize);
+			stream.Write(reader.Payload(), header.payloadSize);
+			reader.Skip(header.payloadSize);
+		}
+	}
+
+	// The stream may have changed pipelines and bindings behind our back.
+	bindCache->Invalidate();
+	lastPipeline = GraphicsPipelineState_t::INVALID;
+	lastComputePipeline = ComputePipelineState_t::INVALID;
+}
+
+void CommandList::ClearRenderTarget(RenderTargetView_t rtv, const float col[4])
+{
+	if (mode == CommandListMode::Immediate)
+	{
+		ClearRenderTargetImpl(impl, rtv, col);
+		return;
+	}
+
+	stream.Begin(CommandOp::ClearRenderTarget, sizeof(rtv) + sizeof(float) * 4);
+	stream.Write(rtv);
+	stream.Write(col, 4);
+}
+
+void CommandList::ClearDepth(DepthStencilView_t dsv, float depth)
+{
+	if (mode == CommandListMode::Immediate)
+	{
+		ClearDepthImpl(impl, dsv, depth);
+		return;
+	}
+
+	stream.Begin(CommandOp::ClearDepth, sizeof(dsv) + sizeof(depth));
+	stream.Write(dsv);
+	stream.Write(depth);
+}
+
+void CommandList::ClearUnorderedAccessView(UnorderedAccessView_t uav, const float col[4])
+{
+	if (mode == CommandListMode::Immediate)
+	{
+		ClearUnorderedAccessViewImpl(impl, uav, col);
+		return;
+	}
+
+	stream.Begin(CommandOp::ClearUnorderedAccessView, sizeof(uav) + sizeof(float) * 4);
+	stream.Write(uav);
+	stream.Write(col, 4);
+}
+
+void CommandList::ClearUnorderedAccessView(UnorderedAccessView_t uav, const uint32_t values[4])
+{
+	if (mode == CommandListMode::Immediate)
+	{
+		ClearUnorderedAccessViewImpl(impl, uav, values);
+		return;
+	}
+
+	stream.Begin(CommandOp::ClearUnorderedAccessViewUint, sizeof(uav) + sizeof(uint32_t) * 4);
+	stream.Write(uav);
+	stream.Write(values, 4);
+}
+
+void CommandList::SetRenderTargets(const RenderTargetView_t* const rtvs, size_t num, DepthStencilView_t dsv)
+{
+	assert(num <= 8);
+
+	// Pending binds may unbind resources that are about to become targets.
+	FlushBinds();
+	bindCache->InvalidateSRVs();
+
+	if (mode == CommandListMode::Immediate)
+	{
+		SetRenderTargetsImpl(impl, rtvs, num, dsv);
+		return;
+	}
+
+	stream.Begin(CommandOp::SetRenderTargets, sizeof(uint8_t) + sizeof(RenderTargetView_t) * num + sizeof(dsv));
+	stream.Write((uint8_t)num);
+	stream.Write(rtvs, num);
+	stream.Write(dsv);
+}
+
+void CommandList::SetViewports(const Viewport* const vps, size_t num)
+{
+	if (mode == CommandListMode::Immediate)
+	{
+		SetViewportsImpl(impl, vps, num);
+		return;
+	}
+
+	RecordCounted(stream, CommandOp::SetViewports, vps, num);
+}
+
+void CommandList::SetDefaultScissor()
+{
+	if (mode == CommandListMode::Immediate)
+	{
+		SetDefaultScissorImpl(impl);
+		return;
+	}
+
+	stream.Begin(CommandOp::SetDefaultScissor, 0);
+}
+
+void CommandList::SetScissors(const ScissorRect* const scissors, size_t num)
+{
+	if (mode == CommandListMode::Immediate)
+	{
+		SetScissorsImpl(impl, scissors, num);
+		return;
+	}
+
+	RecordCounted(stream, CommandOp::SetScissors, scissors, num);
+}
+
+void CommandList::SetPipelineState(GraphicsPipelineState_t pso)
+{
+	if (pso == lastPipeline)
+	{
+		stats.pipelineChangesSkipped++;
+		return;
+	}
+
+	if (mode == CommandListMode::Immediate)
+	{
+		SetGraphicsPipelineStateImpl(impl, pso);
+	}
+	else
+	{
+		stream.Begin(CommandOp::SetGraphicsPipelineState, sizeof(pso));
+		stream.Write(pso);
+	}
+
+	lastComputePipeline = ComputePipelineState_t::INVALID;
+	lastPipeline = pso;
+}
+
+void CommandList::SetPipelineState(ComputePipelineState_t pso)
+{
+	if (pso == lastComputePipeline)
+	{
+		stats.pipelineChangesSkipped++;
+		return;
+	}
+
+	if (mode == CommandListMode::Immediate)
+	{
+		SetComputePipelineStateImpl(impl, pso);
+	}
+	else
+	{
+		stream.Begin(CommandOp::SetComputePipelineState, sizeof(pso));
+		stream.Write(pso);
+	}
+
+	lastPipeline = GraphicsPipelineState_t::INVALID;
+	lastComputePipeline = pso;
+}
+
+void CommandList::SetVertexBuffers(uint32_t startSlot, uint32_t count, const VertexBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
+{
+	FilterVertexBuffers(*bindCache, startSlot, count, vbs, strides, offsets, stats);
+}
+
+void CommandList::SetVertexBuffers(uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
+{
+	FilterVertexBuffers(*bindCache, startSlot, count, vbs, strides, offsets, stats);
+}
+
+void CommandList::SetIndexBuffer(IndexBuffer_t ib, RenderFormat format, uint32_t indexOffset)
+{
+	if (!FilterIndexBuffer(*bindCache, ib, format, indexOffset, stats))
+		return;
+
+	if (mode == CommandListMode::Immediate)
+	{
+		SetIndexBufferImpl(impl, ib, format, indexOffset);
+		return;
+	}
+
+	stream.Begin(CommandOp::SetIndexBuffer, sizeof(ib) + sizeof(format) + sizeof(indexOffset));
+	stream.Write(ib);
+	stream.Write(format);
+	stream.Write(indexOffset);
+}
+
+void CommandList::SetIndexBuffer(DynamicBuffer_t ib, RenderFormat format, uint32_t indexOffset)
+{
+	if (!FilterIndexBuffer(*bindCache, ib, format, indexOffset, stats))
+		return;
+
+	if (mode == CommandListMode::Immediate)
+	{
+		SetIndexBufferImpl(impl, ib, format, indexOffset);
+		return;
+	}
+
+	stream.Begin(CommandOp::SetDynamicIndexBuffer, sizeof(ib) + sizeof(format) + sizeof(indexOffset));
+	stream.Write(ib);
+	stream.Write(format);
+	stream.Write(indexOffset);
+}
+
+void CommandList::CopyTexture(Texture_t dst, Texture_t src)
+{
+	if (mode == CommandListMode::Immediate)
+	{
+		CopyTextureImpl(impl, dst, src);
+		return;
+	}
+
+	stream.Begin(CommandOp::CopyTexture, sizeof(dst) + sizeof(src));
+	stream.Write(dst);
+	stream.Write(src);
+}
+
+void CommandList::ResourceBarriers(const ResourceBarrier* const barriers, size_t num)
+{
+	if (num == 0)
+		return;
+
+	if (mode == CommandListMode::Immediate)
+	{
+		ResourceBarriersImpl(impl, barriers, num);
+		return;
+	}
+
+	// Large batches are split over several commands to keep the payload size and replay scratch bounded.
+	for (size_t first = 0; first < num; first += kMaxRecordedBarriers)
+	{
+		const size_t count = num - first < kMaxRecordedBarriers ? num - first : kMaxRecordedBarriers;
+
+		stream.Begin(CommandOp::ResourceBarriers, sizeof(uint8_t) + sizeof(ResourceBarrier) * count);
+		stream.Write((uint8_t)count);
+		stream.Write(barriers + first, count);
+	}
+}
+
+void CommandList::DrawIndexedInstanced(uint32_t numIndices, uint32_t numInstances, uint32_t startIndex, uint32_t startVertex, uint32_t startInstance)
+{
+	FlushBinds();
+
+	if (mode == CommandListMode::Immediate)
+	{
+		DrawIndexedInstancedImpl(impl, numIndices, numInstances, startIndex, startVertex, startInstance);
+		return;
+	}
+
+	const uint32_t args[] = { numIndices, numInstances, startIndex, startVertex, startInstance };
+	stream.Begin(CommandOp::DrawIndexedInstanced, sizeof(args));
+	stream.Write(args);
+}
+
+void CommandList::DrawInstanced(uint32_t numVerts, uint32_t numInstances, uint32_t startVertex, uint32_t startInstance)
+{
+	FlushBinds();
+
+	if (mode == CommandListMode::Immediate)
+	{
+		DrawInstancedImpl(impl, numVerts, numInstances, startVertex, startInstance);
+		return;
+	}
+
+	const uint32_t args[] = { numVerts, numInstances, startVertex, startInstance };
+	stream.Begin(CommandOp::DrawInstanced, sizeof(args));
+	stream.Write(args);
+}
+
+void CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z)
+{
+	FlushBinds();
+
+	if (mode == CommandListMode::Immediate)
+	{
+		DispatchImpl(impl, x, y, z);
+		return;
+	}
+
+	const uint32_t args[] = { x, y, z };
+	stream.Begin(CommandOp::Dispatch, sizeof(args));
+	stream.Write(args);
+}
+
+// Dx11 Style Bind Commands
+#define BIND_COMMAND_IMPL(FuncName, Type, Cache, Dirty, MaxSlots)										\
+void CommandList::FuncName(uint32_t startSlot, uint32_t count, const Type* const values)				\
+{																										\
+	FilterBinds(*bindCache, bindCache->Cache, bindCache->Dirty, MaxSlots, startSlot, count, values, stats);	\
+}																										\
+
+BIND_COMMAND_IMPL(BindVertexSRVs, ShaderResourceView_t, srvs[ShaderStage_Vertex], dirtySrvs[ShaderStage_Vertex], kMaxSRVSlots);
+BIND_COMMAND_IMPL(BindVertexCBVs, ConstantBuffer_t, cbvs[ShaderStage_Vertex], dirtyCbvs[ShaderStage_Vertex], kMaxCBVSlots);
+BIND_COMMAND_IMPL(BindVertexCBVs, DynamicBuffer_t, cbvs[ShaderStage_Vertex], dirtyCbvs[ShaderStage_Vertex], kMaxCBVSlots);
+BIND_COMMAND_IMPL(BindGeometryCBVs, ConstantBuffer_t, cbvs[ShaderStage_Geometry], dirtyCbvs[ShaderStage_Geometry], kMaxCBVSlots);
+BIND_COMMAND_IMPL(BindGeometryCBVs, DynamicBuffer_t, cbvs[ShaderStage_Geometry], dirtyCbvs[ShaderStage_Geometry], kMaxCBVSlots);
+BIND_COMMAND_IMPL(BindPixelSRVs, ShaderResourceView_t, srvs[ShaderStage_Pixel], dirtySrvs[ShaderStage_Pixel], kMaxSRVSlots);
+BIND_COMMAND_IMPL(BindPixelCBVs, ConstantBuffer_t, cbvs[ShaderStage_Pixel], dirtyCbvs[ShaderStage_Pixel], kMaxCBVSlots);
+BIND_COMMAND_IMPL(BindPixelCBVs, DynamicBuffer_t, cbvs[ShaderStage_Pixel], dirtyCbvs[ShaderStage_Pixel], kMaxCBVSlots);
+BIND_COMMAND_IMPL(BindComputeSRVs, ShaderResourceView_t, srvs[ShaderStage_Compute], dirtySrvs[ShaderStage_Compute], kMaxSRVSlots);
+BIND_COMMAND_IMPL(BindComputeUAVs, UnorderedAccessView_t, uavs, dirtyUavs, kMaxUAVSlots);
+BIND_COMMAND_IMPL(BindComputeCBVs, ConstantBuffer_t, cbvs[ShaderStage_Compute], dirtyCbvs[ShaderStage_Compute], kMaxCBVSlots);
+BIND_COMMAND_IMPL(BindComputeCBVs, DynamicBuffer_t, cbvs[ShaderStage_Compute], dirtyCbvs[ShaderStage_Compute], kMaxCBVSlots);
+
+#undef BIND_COMMAND_IMPL
+
+CommandListPtr CommandList::Create(CommandListMode mode)
+{
+	CommandListPtr cl;
+
+	if (!g_FreeCommandLists.empty())
+	{
+		cl = g_FreeCommandLists.back();
+		g_FreeCommandLists.pop_back();
+	}
+	else
+	{
+		cl = std::make_shared<CommandList>(CreateCommandListImpl());
+	}
+
+	cl->mode = mode;
+	cl->Begin();
+
+	return cl;
+}
+
+static void AccumulateStats(const CommandListStats& stats)
+{
+	g_CommandListStats.bindCalls += stats.bindCalls;
+	g_CommandListStats.bindCallsSkipped += stats.bindCallsSkipped;
+	g_CommandListStats.slotsSkipped += stats.slotsSkipped;
+	g_CommandListStats.bindCallsIssued += stats.bindCallsIssued;
+	g_CommandListStats.pipelineChangesSkipped += stats.pipelineChangesSkipped;
+}
+
+void CommandList::Execute(CommandListPtr& cl)
+{
+	assert(cl);
+
+	cl->Finish();
+
+	AccumulateStats(cl->stats);
+
+	DynamicBuffers_Upload();
+
+	ExecuteCommandListImpl(cl->impl);
+
+	g_FreeCommandLists.push_back(cl);
+}
+
+void CommandList::ExecuteAndStall(CommandListPtr& cl)
+{
+	assert(cl);
+
+	cl->Finish();
+
+	AccumulateStats(cl->stats);
+
+	DynamicBuffers_Upload();
+
+	ExecuteAndStallCommandListImpl(cl->impl);
+}
+
+void CommandList::ReleaseAll()
+{
+	g_FreeCommandLists.clear();
+}
+
+const CommandListStats& CommandList_GetStats()
+{
+	return g_CommandListStats;
+}
+
+void CommandList_ResetStats()
+{
+	g_CommandListStats = {};
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "RenderTypes.h"
 #include "PipelineState.h"
+#include "CommandStream.h"
 
 #include <memory>
 
@@ -14,11 +15,44 @@ FWD_RENDER_TYPE(IndexBuffer_t);
 FWD_RENDER_TYPE(VertexBuffer_t);
 FWD_RENDER_TYPE(DynamicBuffer_t);
 FWD_RENDER_TYPE(Texture_t);
+FWD_RENDER_TYPE(StructuredBuffer_t);
 
 struct CommandListImpl;
+struct CommandListBindCache;
 
 typedef std::shared_ptr<struct CommandList> CommandListPtr;
 
+// Binds that were dropped because the slot already held the same value. Binds that do change state
+// are deferred until the next draw or dispatch, then sent as one ranged call per stage and type.
+struct CommandListStats
+{
+	size_t bindCalls = 0;
+	size_t bindCallsSkipped = 0;	// Calls where every slot was already bound.
+	size_t slotsSkipped = 0;		// Slots that were already bound, including those of skipped calls.
+	size_t bindCallsIssued = 0;		// Ranged bind calls sent to the backend.
+	size_t pipelineChangesSkipped = 0;
+};
+
+static constexpr uint32_t kAllSubresources = ~0u;
+
+// Transition of one subresource of a texture, or all of them with kAllSubresources. Barriers with
+// no texture transition the structured buffer instead, buffers have a single subresource. A barrier
+// from UnorderedAccess to UnorderedAccess orders UAV accesses without changing state.
+struct ResourceBarrier
+{
+	Texture_t texture = {};
+	StructuredBuffer_t buffer = {};
+	uint32_t subresource = kAllSubresources;
+	ResourceState before = ResourceState::Common;
+	ResourceState after = ResourceState::Common;
+};
+
+enum class CommandListMode : uint8_t
+{
+	Immediate,	// Commands are forwarded straight to the backend as they are called.
+	Recorded,	// Commands are packed into a CommandStream and replayed by the backend on Execute.
+};
+
 struct CommandList
 {
 	CommandList() = delete;
@@ -28,6 +62,8 @@ struct CommandList
 
 	void ClearRenderTarget(RenderTargetView_t rtv, const float col[4]);
 	void ClearDepth(DepthStencilView_t dsv, float depth);
+	void ClearUnorderedAccessView(UnorderedAccessView_t uav, const float col[4]);
+	void ClearUnorderedAccessView(UnorderedAccessView_t uav, const uint32_t values[4]);
 
 	void SetRenderTargets(const RenderTargetView_t* const rtvs, size_t num, DepthStencilView_t dsv);
 	void SetViewports(const Viewport* const vp, size_t num);
@@ -42,6 +78,10 @@ struct CommandList
 
 	void CopyTexture(Texture_t dst, Texture_t src);
 
+	// Batched state transitions for backends that track resource state explicitly. Dx11 tracks
+	// hazards itself and ignores them.
+	void ResourceBarriers(const ResourceBarrier* const barriers, size_t num);
+
 	void DrawIndexedInstanced(uint32_t numIndices, uint32_t numInstances, uint32_t startIndex, uint32_t startVertex, uint32_t startInstance);
 	void DrawInstanced(uint32_t numVerts, uint32_t numInstances, uint32_t startVertex, uint32_t startInstance);
 
@@ -67,7 +107,15 @@ struct CommandList
 	GraphicsPipelineState_t GetPreviousPSO() const noexcept { return lastPipeline; }
 	ComputePipelineState_t GetPreviousComputePSO() const noexcept { return lastComputePipeline; }
 
-	static CommandListPtr Create();
+	const CommandListStats& GetStats() const noexcept { return stats; }
+
+	CommandListMode GetMode() const noexcept { return mode; }
+	const CommandStream& GetStream() const noexcept { return stream; }
+
+	// Applies every command in the stream to this list, as if each had been called directly.
+	void Replay(const CommandStream& commands);
+
+	static CommandListPtr Create(CommandListMode mode = CommandListMode::Immediate);
 	static void Execute(CommandListPtr& cl);
 	static void ExecuteAndStall(CommandListPtr& cl);
 
@@ -93,11 +141,22 @@ public:
 	BIND_HELPER_IMPL(BindTexturesAsComputeUAVs, UnorderedAccessView_t, GetTextureUAV, BindComputeUAVs);
 
 private:
-	std::unique_ptr<CommandListImpl> impl;
+	CommandListImpl* impl = nullptr;
+
+	CommandListMode mode = CommandListMode::Immediate;
+	CommandStream stream;
+
+	std::unique_ptr<CommandListBindCache> bindCache;
+	CommandListStats stats;
 
 	GraphicsPipelineState_t lastPipeline = GraphicsPipelineState_t::INVALID;
 	ComputePipelineState_t lastComputePipeline = ComputePipelineState_t::INVALID;
 
 	void Begin();
 	void Finish();
-};
\ No newline at end of file
+	void FlushBinds();
+};
+
+// Totals of every executed command list's stats.
+const CommandListStats& CommandList_GetStats();
+void CommandList_ResetStats();
\ No newline at end of file
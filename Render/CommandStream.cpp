@@ -0,0 +1,179 @@
+#include "CommandStream.h"
+
+void CommandStream::Begin(CommandOp op, size_t payloadSize)
+{
+	assert(payloadSize <= UINT16_MAX && "CommandStream::Begin payload too large");
+
+	const size_t commandSize = kCommandHeaderSize + payloadSize;
+
+	// Commands never straddle blocks, move on to the next block with room for the whole command.
+	while (currentBlock < blocks.size() && blocks[currentBlock].used + commandSize > blocks[currentBlock].capacity)
+		currentBlock++;
+
+	if (currentBlock == blocks.size())
+	{
+		Block& block = blocks.emplace_back();
+		block.capacity = commandSize > kBlockSize ? commandSize : kBlockSize;
+		block.data = std::make_unique<uint8_t[]>(block.capacity);
+	}
+
+	Block& block = blocks[currentBlock];
+	cursor = block.data.get() + block.used;
+	block.used += commandSize;
+
+	commandCount++;
+
+	Write(op);
+	Write((uint16_t)payloadSize);
+}
+
+void CommandStream::Reset()
+{
+	for (Block& block : blocks)
+		block.used = 0;
+
+	currentBlock = 0;
+	cursor = nullptr;
+	commandCount = 0;
+}
+
+size_t CommandStream::GetSize() const noexcept
+{
+	size_t size = 0;
+	for (const Block& block : blocks)
+		size += block.used;
+
+	return size;
+}
+
+size_t CommandStream::GetCapacity() const noexcept
+{
+	size_t capacity = 0;
+	for (const Block& block : blocks)
+		capacity += block.capacity;
+
+	return capacity;
+}
+
+bool CommandStream::operator==(const CommandStream& other) const
+{
+	if (commandCount != other.commandCount)
+		return false;
+
+	CommandStreamReader a(*this);
+	CommandStreamReader b(other);
+
+	CommandHeader headerA;
+	CommandHeader headerB;
+
+	while (a.Next(headerA))
+	{
+		if (!b.Next(headerB) || headerA.op != headerB.op || headerA.payloadSize != headerB.payloadSize)
+			return false;
+
+		if (memcmp(a.Payload(), b.Payload(), headerA.payloadSize) != 0)
+			return false;
+
+		a.Skip(headerA.payloadSize);
+		b.Skip(headerB.payloadSize);
+	}
+
+	return !b.Next(headerB);
+}
+
+CommandStreamReader::CommandStreamReader(const CommandStream& s)
+	: stream(s)
+{
+	if (!stream.blocks.empty())
+	{
+		cursor = stream.blocks[0].data.get();
+		end = cursor + stream.blocks[0].used;
+	}
+}
+
+bool CommandStreamReader::Next(CommandHeader& header)
+{
+	while (cursor == end)
+	{
+		if (++block >= stream.blocks.size() || block > stream.currentBlock)
+			return false;
+
+		cursor = stream.blocks[block].data.get();
+		end = cursor + stream.blocks[block].used;
+	}
+
+	header.op = Read<CommandOp>();
+	header.payloadSize = Read<uint16_t>();
+
+	assert(header.op < CommandOp::Count);
+
+	return true;
+}
+
+const char* CommandStream_GetOpName(CommandOp op)
+{
+	switch (op)
+	{
+	case CommandOp::ClearRenderTarget:			return "ClearRenderTarget";
+	case CommandOp::ClearDepth:					return "ClearDepth";
+	case CommandOp::ClearUnorderedAccessView:	return "ClearUnorderedAccessView";
+	case CommandOp::ClearUnorderedAccessViewUint:	return "ClearUnorderedAccessViewUint";
+	case CommandOp::SetRenderTargets:			return "SetRenderTargets";
+	case CommandOp::SetViewports:				return "SetViewports";
+	case CommandOp::SetDefaultScissor:			return "SetDefaultScissor";
+	case CommandOp::SetScissors:				return "SetScissors";
+	case CommandOp::SetGraphicsPipelineState:	return "SetGraphicsPipelineState";
+	case CommandOp::SetComputePipelineState:	return "SetComputePipelineState";
+	case CommandOp::SetVertexBuffers:			return "SetVertexBuffers";
+	case CommandOp::SetDynamicVertexBuffers:	return "SetDynamicVertexBuffers";
+	case CommandOp::SetIndexBuffer:				return "SetIndexBuffer";
+	case CommandOp::SetDynamicIndexBuffer:		return "SetDynamicIndexBuffer";
+	case CommandOp::CopyTexture:				return "CopyTexture";
+	case CommandOp::ResourceBarriers:			return "ResourceBarriers";
+	case CommandOp::DrawIndexedInstanced:		return "DrawIndexedInstanced";
+	case CommandOp::DrawInstanced:				return "DrawInstanced";
+	case CommandOp::Dispatch:					return "Dispatch";
+	case CommandOp::BindVertexSRVs:				return "BindVertexSRVs";
+	case CommandOp::BindVertexCBVs:				return "BindVertexCBVs";
+	case CommandOp::BindVertexDynamicCBVs:		return "BindVertexDynamicCBVs";
+	case CommandOp::BindGeometryCBVs:			return "BindGeometryCBVs";
+	case CommandOp::BindGeometryDynamicCBVs:	return "BindGeometryDynamicCBVs";
+	case CommandOp::BindPixelSRVs:				return "BindPixelSRVs";
+	case CommandOp::BindPixelCBVs:				return "BindPixelCBVs";
+	case CommandOp::BindPixelDynamicCBVs:		return "BindPixelDynamicCBVs";
+	case CommandOp::BindComputeSRVs:			return "BindComputeSRVs";
+	case CommandOp::BindComputeUAVs:			return "BindComputeUAVs";
+	case CommandOp::BindComputeCBVs:			return "BindComputeCBVs";
+	case CommandOp::BindComputeDynamicCBVs:		return "BindComputeDynamicCBVs";
+	default:									break;
+	}
+
+	return "Unknown";
+}
+
+void CommandStream_Dump(const CommandStream& stream, std::string& out)
+{
+	static const char* kHex = "0123456789abcdef";
+
+	CommandStreamReader reader(stream);
+	CommandHeader header;
+
+	while (reader.Next(header))
+	{
+		out += CommandStream_GetOpName(header.op);
+
+		if (header.payloadSize > 0)
+			out += ' ';
+
+		const uint8_t* payload = reader.Payload();
+		for (uint16_t i = 0; i < header.payloadSize; i++)
+		{
+			out += kHex[payload[i] >> 4];
+			out += kHex[payload[i] & 0xf];
+		}
+
+		out += '\n';
+
+		reader.Skip(header.payloadSize);
+	}
+}
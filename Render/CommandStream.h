@@ -0,0 +1,143 @@
+#pragma once
+
+#include "RenderTypes.h"
+
+#include <cstring>
+
+// Compact binary command stream recorded by CommandList when created in CommandListMode::Recorded.
+// Each command is a packed header (op + payload size) followed by its payload, with no padding.
+// Memory comes from fixed size blocks which are kept between frames, so steady state recording
+// does not allocate.
+
+enum class CommandOp : uint8_t
+{
+	ClearRenderTarget,
+	ClearDepth,
+	ClearUnorderedAccessView,
+	ClearUnorderedAccessViewUint,
+	SetRenderTargets,
+	SetViewports,
+	SetDefaultScissor,
+	SetScissors,
+	SetGraphicsPipelineState,
+	SetComputePipelineState,
+	SetVertexBuffers,
+	SetDynamicVertexBuffers,
+	SetIndexBuffer,
+	SetDynamicIndexBuffer,
+	CopyTexture,
+	ResourceBarriers,
+	DrawIndexedInstanced,
+	DrawInstanced,
+	Dispatch,
+	BindVertexSRVs,
+	BindVertexCBVs,
+	BindVertexDynamicCBVs,
+	BindGeometryCBVs,
+	BindGeometryDynamicCBVs,
+	BindPixelSRVs,
+	BindPixelCBVs,
+	BindPixelDynamicCBVs,
+	BindComputeSRVs,
+	BindComputeUAVs,
+	BindComputeCBVs,
+	BindComputeDynamicCBVs,
+	Count
+};
+
+struct CommandHeader
+{
+	CommandOp op;
+	uint16_t payloadSize;
+};
+
+static constexpr size_t kCommandHeaderSize = sizeof(CommandOp) + sizeof(uint16_t);
+
+struct CommandStream
+{
+	static constexpr size_t kBlockSize = 64u * 1024u;
+
+	CommandStream() = default;
+	CommandStream(const CommandStream&) = delete;
+
+	// Reserves space for a command and writes its header, the payload is written with Write().
+	void Begin(CommandOp op, size_t payloadSize);
+
+	template<typename T>
+	void Write(const T& value)
+	{
+		memcpy(cursor, &value, sizeof(T));
+		cursor += sizeof(T);
+	}
+
+	template<typename T>
+	void Write(const T* const values, size_t count)
+	{
+		memcpy(cursor, values, sizeof(T) * count);
+		cursor += sizeof(T) * count;
+	}
+
+	void Reset();
+
+	size_t GetCommandCount() const noexcept { return commandCount; }
+	size_t GetSize() const noexcept;
+	size_t GetCapacity() const noexcept;
+
+	bool operator==(const CommandStream& other) const;
+
+private:
+	friend struct CommandStreamReader;
+
+	struct Block
+	{
+		std::unique_ptr<uint8_t[]> data;
+		size_t capacity = 0;
+		size_t used = 0;
+	};
+
+	std::vector<Block> blocks;
+	size_t currentBlock = 0;
+	uint8_t* cursor = nullptr;
+	size_t commandCount = 0;
+};
+
+struct CommandStreamReader
+{
+	explicit CommandStreamReader(const CommandStream& stream);
+
+	// Advances to the next command, returns false once the stream is exhausted.
+	bool Next(CommandHeader& header);
+
+	template<typename T>
+	T Read()
+	{
+		T value;
+		memcpy(&value, cursor, sizeof(T));
+		cursor += sizeof(T);
+		return value;
+	}
+
+	// Returns the next count elements in place. Data in the stream is unaligned so the elements
+	// are copied into the caller's scratch storage.
+	template<typename T>
+	const T* Read(T* scratch, size_t count)
+	{
+		memcpy(scratch, cursor, sizeof(T) * count);
+		cursor += sizeof(T) * count;
+		return scratch;
+	}
+
+	const uint8_t* Payload() const noexcept { return cursor; }
+	void Skip(size_t size) noexcept { cursor += size; }
+
+private:
+	const CommandStream& stream;
+	size_t block = 0;
+	const uint8_t* cursor = nullptr;
+	const uint8_t* end = nullptr;
+};
+
+const char* CommandStream_GetOpName(CommandOp op);
+
+// Writes one line per command with the op name and its payload as hex. Intended for diffing streams.
+void CommandStream_Dump(const CommandStream& stream, std::string& out);
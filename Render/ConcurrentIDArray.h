@@ -0,0 +1,226 @@
+#pragma once
+
+#include "IDArray.h"
+#include "PagedArray.h"
+
+// IDArray that can be created from, released from and read on any thread, so resources can be
+// streamed in by loader threads while the render thread uses the table.
+// - Slots live in a PagedArray, growing never moves them.
+// - Released slots go on a lock free free list, tagged with a counter to avoid ABA.
+// - Reference counts are atomic.
+// IDs carry the same generation as IDArray when IDARRAY_GENERATION_CHECKS is set.
+//
+// Unlike IDArray, a released slot is not reused until Free is called. The caller destroys the
+// backend objects for the slot in between, which would otherwise race with another thread creating
+// into the recycled slot.
+template<typename ID, typename DataType>
+struct ConcurrentIDArray
+{
+	ConcurrentIDArray()
+	{
+		Slots.Alloc(0);
+	}
+
+	ConcurrentIDArray(const ConcurrentIDArray&) = delete;
+
+	ID Create()
+	{
+		ID id = MakeID();
+		if (id != ID::INVALID)
+			Slots[(uint32_t)id].data = {};
+		return id;
+	}
+
+	ID Create(DataType&& data)
+	{
+		ID id = MakeID();
+		if (id != ID::INVALID)
+			Slots[(uint32_t)id].data = std::move(data);
+		return id;
+	}
+
+	ID Create(DataType** outData)
+	{
+		ID id = MakeID();
+		*outData = id != ID::INVALID ? &Slots[(uint32_t)id].data : nullptr;
+		return id;
+	}
+
+	void Update(ID id, DataType& data)
+	{
+		assert(IsValid(id) && "ConcurrentIDArray::Update stale or invalid ID");
+		Slots[(uint32_t)id].data = data;
+	}
+
+	void AddRef(ID id)
+	{
+		assert(IsValid(id) && "ConcurrentIDArray::AddRef stale or invalid ID");
+		Slots[(uint32_t)id].refCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Returns the slot data when the last reference is released, the slot is recycled by Free.
+	DataType* Release(ID id)
+	{
+		if (id == ID::INVALID)
+			return nullptr;
+
+		if (!IsValid(id))
+		{
+			assert(0 && "ConcurrentIDArray::Release stale or invalid ID");
+			return nullptr;
+		}
+
+		Slot& slot = Slots[(uint32_t)id];
+
+		if (slot.refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+#if IDARRAY_GENERATION_CHECKS
+			slot.generation.store((slot.generation.load(std::memory_order_relaxed) + 1) & kGenerationMask, std::memory_order_release);
+#endif
+			return &slot.data;
+		}
+
+		return nullptr;
+	}
+
+	// Makes a released slot available to Create again.
+	void Free(ID id)
+	{
+		const uint32_t index = (uint32_t)id;
+		assert(index > 0 && index < NextIndex.load(std::memory_order_relaxed) && Slots[index].refCount.load(std::memory_order_relaxed) == 0);
+
+		Slot& slot = Slots[index];
+
+		uint64_t head = FreeHead.load(std::memory_order_relaxed);
+		uint64_t newHead;
+		do
+		{
+			slot.nextFree.store((uint32_t)head, std::memory_order_relaxed);
+			newHead = ((head >> 32) + 1) << 32 | index;
+		} while (!FreeHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+
+		FreeCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	DataType* GetUnchecked(ID id) noexcept
+	{
+		Slot* slot = Slots.TryGet((uint32_t)id);
+		return slot ? &slot->data : nullptr;
+	}
+
+	DataType* Get(ID id)
+	{
+		return IsValid(id) ? &Slots[(uint32_t)id].data : nullptr;
+	}
+
+	// Current ID of the slot at index, for iterating the array. Dead slots still need checking with Get.
+	ID GetID(size_t index) const noexcept
+	{
+		const Slot* slot = Slots.TryGet(index);
+		return slot ? MakeHandle((uint32_t)index, *slot) : ID::INVALID;
+	}
+
+	// True if the ID refers to a live slot.
+	inline bool IsValid(ID id) const noexcept
+	{
+		const uint32_t index = (uint32_t)id;
+		if (index == 0 || index >= NextIndex.load(std::memory_order_acquire))
+			return false;
+
+		const Slot* slot = Slots.TryGet(index);
+		if (!slot || slot->refCount.load(std::memory_order_acquire) == 0)
+			return false;
+
+#if IDARRAY_GENERATION_CHECKS
+		return slot->generation.load(std::memory_order_acquire) == (uint32_t)((uint64_t)id >> kGenerationShift);
+#else
+		return true;
+#endif
+	}
+
+	inline uint32_t RefCount(ID id) const noexcept { return IsValid(id); }
+	inline size_t Size() const noexcept { return NextIndex.load(std::memory_order_acquire); }
+	inline size_t UsedSize() const noexcept { return Size() - FreeCount.load(std::memory_order_relaxed); }
+
+	ResourceTableMemoryReport GetMemoryReport(const char* name) const noexcept
+	{
+		ResourceTableMemoryReport report;
+		report.name = name;
+		report.used = UsedSize();
+		report.capacity = Slots.GetCapacity();
+		report.bytes = Slots.GetMemoryUsage();
+		return report;
+	}
+
+private:
+	static constexpr uint32_t kGenerationShift = 32;
+	static constexpr uint32_t kGenerationMask = 0xffffff;
+
+	struct Slot
+	{
+		DataType data = {};
+		std::atomic<uint32_t> refCount{0};
+		std::atomic<uint32_t> generation{0};
+		std::atomic<uint32_t> nextFree{0};
+	};
+
+	PagedArray<Slot> Slots;
+
+	// Index 0 is INVALID, so it doubles as the end of the free list.
+	std::atomic<uint32_t> NextIndex{1};
+
+	// Low 32 bits are the first free index, high 32 bits a counter bumped on every change.
+	std::atomic<uint64_t> FreeHead{0};
+	std::atomic<size_t> FreeCount{0};
+
+	ID MakeHandle(uint32_t index, const Slot& slot) const noexcept
+	{
+#if IDARRAY_GENERATION_CHECKS
+		return (ID)(((uint64_t)slot.generation.load(std::memory_order_acquire) << kGenerationShift) | index);
+#else
+		return (ID)index;
+#endif
+	}
+
+	bool PopFree(uint32_t& index)
+	{
+		uint64_t head = FreeHead.load(std::memory_order_acquire);
+		uint64_t newHead;
+		do
+		{
+			index = (uint32_t)head;
+			if (index == 0)
+				return false;
+
+			newHead = ((head >> 32) + 1) << 32 | Slots[index].nextFree.load(std::memory_order_relaxed);
+		} while (!FreeHead.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire));
+
+		FreeCount.fetch_sub(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	ID MakeID()
+	{
+		uint32_t index;
+		if (!PopFree(index))
+		{
+			index = NextIndex.load(std::memory_order_relaxed);
+
+			// Allocate the page before publishing the index so readers never see an index without storage.
+			do
+			{
+				if (!Slots.TryAlloc(index))
+				{
+					LOGERROR("ConcurrentIDArray is full, it holds at most %zu entries", Slots.kMaxSize);
+					return ID::INVALID;
+				}
+			} while (!NextIndex.compare_exchange_weak(index, index + 1, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		Slot& slot = Slots[index];
+		slot.refCount.store(1, std::memory_order_release);
+
+		return MakeHandle(index, slot);
+	}
+};
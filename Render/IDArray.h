@@ -1,56 +1,89 @@
 #pragma once
 
-#include <vector>
+#include "PagedArray.h"
+#include "RenderTypes.h"
+#include "../Utils/Logging.h"
+
+// Entries live in fixed size pages, growing the array never moves them so pointers returned by
+// Create and Get stay valid until the entry is released.
+// IDs are a 32 bit index into the array with a generation in the bits above it. The generation
+// of a slot is bumped when its last reference is released, so a stale ID to a recycled slot fails
+// validation instead of aliasing the new resource. Backends index their own tables with the low
+// 32 bits, (uint32_t)id.
+// Set IDARRAY_GENERATION_CHECKS to 0 to strip the generations, IDs are then plain indices.
+#ifndef IDARRAY_GENERATION_CHECKS
+#ifdef NDEBUG
+#define IDARRAY_GENERATION_CHECKS 0
+#else
+#define IDARRAY_GENERATION_CHECKS 1
+#endif
+#endif
 
 template<typename ID, typename DataType>
 struct IDArray
 {
 	explicit IDArray()
 	{
-		Data.push_back({});
-		RefCounts.push_back(0);
+		Slots.Alloc(0);
 	}
 
+	IDArray(const IDArray&) = delete;
+
 	ID Create()
 	{
 		ID id = MakeID();
-		Data[(uint32_t)id] = {};
+		if (id != ID::INVALID)
+			Slots[(uint32_t)id].data = {};
 		return id;
 	}
 
 	ID Create(DataType&& data)
 	{
 		ID id = MakeID();
-		Data[(uint32_t)id] = std::move(data);
+		if (id != ID::INVALID)
+			Slots[(uint32_t)id].data = std::move(data);
 		return id;
 	}
 
 	ID Create(DataType** outData)
 	{
 		ID id = MakeID();
-		*outData = &Data[(uint32_t)id];
+		*outData = id != ID::INVALID ? &Slots[(uint32_t)id].data : nullptr;
 		return id;
 	}
 
 	void Update(ID id, DataType& data)
 	{
-		Data[(uint32_t)id] = data;
+		assert(IsValid(id) && "IDArray::Update stale or invalid ID");
+		Slots[(uint32_t)id].data = data;
 	}
 
 	void AddRef(ID id)
 	{
-		RefCounts[(uint32_t)id]++;
+		assert(IsValid(id) && Slots[(uint32_t)id].refCount && "IDArray::AddRef stale or invalid ID");
+		Slots[(uint32_t)id].refCount++;
 	}
 
 	DataType* Release(ID id)
 	{
-		if (id == ID::INVALID || RefCounts[(uint32_t)id] == 0)
+		if (id == ID::INVALID)
 			return nullptr;
 
-		if (--RefCounts[(uint32_t)id] == 0)
+		if (!IsValid(id) || Slots[(uint32_t)id].refCount == 0)
+		{
+			assert(0 && "IDArray::Release stale or invalid ID");
+			return nullptr;
+		}
+
+		Slot& slot = Slots[(uint32_t)id];
+
+		if (--slot.refCount == 0)
 		{
-			FreeIDs.push_back(id);
-			return &Data[(uint32_t)id];
+#if IDARRAY_GENERATION_CHECKS
+			slot.generation = (slot.generation + 1) & kGenerationMask;
+#endif
+			FreeIDs.push_back((uint32_t)id);
+			return &slot.data;
 		}
 
 		return nullptr;
@@ -58,40 +91,92 @@ struct IDArray
 
 	DataType* GetUnchecked(ID id) noexcept
 	{
-		return (uint32_t)id <= Data.size() ? &Data[(uint32_t)id] : nullptr;
+		return (uint32_t)id < Count ? &Slots[(uint32_t)id].data : nullptr;
 	}
 
 	DataType* Get(ID id)
 	{
-		return RefCounts[(uint32_t)id] ? &Data[(uint32_t)id] : nullptr;
+		return IsValid(id) && Slots[(uint32_t)id].refCount ? &Slots[(uint32_t)id].data : nullptr;
+	}
+
+	// Current ID of the slot at index, for iterating the array. Dead slots still need checking with Get.
+	ID GetID(size_t index) const noexcept
+	{
+		return MakeHandle((uint32_t)index);
+	}
+
+	inline bool IsValid(ID id) const noexcept
+	{
+#if IDARRAY_GENERATION_CHECKS
+		return (uint32_t)id < Count && Slots[(uint32_t)id].generation == (uint32_t)((uint64_t)id >> kGenerationShift);
+#else
+		return (uint32_t)id < Count;
+#endif
 	}
 
-	inline std::vector<DataType>& GetArray() noexcept { return Data; }
-	inline uint32_t RefCount(ID id) const noexcept { return RefCounts[(uint32_t)id] > 0; }
-	inline size_t Size() const noexcept { return Data.size(); }
-	inline size_t UsedSize() const noexcept { return Data.size() - FreeIDs.size(); }
+	inline uint32_t RefCount(ID id) const noexcept { return IsValid(id) && Slots[(uint32_t)id].refCount > 0; }
+	inline size_t Size() const noexcept { return Count; }
+	inline size_t UsedSize() const noexcept { return Count - FreeIDs.size(); }
+
+	ResourceTableMemoryReport GetMemoryReport(const char* name) const noexcept
+	{
+		ResourceTableMemoryReport report;
+		report.name = name;
+		report.used = UsedSize();
+		report.capacity = Slots.GetCapacity();
+		report.bytes = Slots.GetMemoryUsage() + FreeIDs.capacity() * sizeof(uint32_t);
+		return report;
+	}
 
 private:
-	std::vector<ID>		FreeIDs;
-	std::vector<DataType> Data;
-	std::vector<uint32_t> RefCounts;
+	// 24 bits keeps the top byte of the handle clear for tagging by callers.
+	static constexpr uint32_t kGenerationShift = 32;
+	static constexpr uint32_t kGenerationMask = 0xffffff;
+
+	struct Slot
+	{
+		DataType data = {};
+		uint32_t refCount = 0;
+#if IDARRAY_GENERATION_CHECKS
+		uint32_t generation = 0;
+#endif
+	};
+
+	PagedArray<Slot> Slots;
+	uint32_t Count = 1;
+	std::vector<uint32_t> FreeIDs;
+
+	ID MakeHandle(uint32_t index) const noexcept
+	{
+#if IDARRAY_GENERATION_CHECKS
+		return (ID)(((uint64_t)Slots[index].generation << kGenerationShift) | index);
+#else
+		return (ID)index;
+#endif
+	}
 
 	ID MakeID()
 	{
 		if (!FreeIDs.empty())
 		{
-			ID id = FreeIDs.back();
+			const uint32_t index = FreeIDs.back();
 			FreeIDs.pop_back();
-			RefCounts[(uint32_t)id]++;
-			return id;
+			Slots[index].refCount++;
+			return MakeHandle(index);
 		}
 		else
 		{
-			ID id = (ID)Data.size();
-			Data.push_back({});
-			RefCounts.push_back(1);
+			Slot* slot = Slots.TryAlloc(Count);
+			if (!slot)
+			{
+				LOGERROR("IDArray is full, it holds at most %zu entries", Slots.kMaxSize);
+				return ID::INVALID;
+			}
+
+			const uint32_t index = Count++;
+			slot->refCount = 1;
 
-			return id;
+			return MakeHandle(index);
 		}
 	}
 };
@@ -14,4 +14,39 @@ void UpdateConstantBufferImpl(ConstantBuffer_t cb, const void* const data, size_
 void DestroyVertexBuffer(VertexBuffer_t handle);
 void DestroyIndexBuffer(IndexBuffer_t handle);
 void DestroyStructuredBuffer(StructuredBuffer_t handle);
-void DestroyConstantBuffer(ConstantBuffer_t handle);
\ No newline at end of file
+void DestroyConstantBuffer(ConstantBuffer_t handle);
+
+// Dynamic buffers are sub-allocated by the front end out of large pages which the backend creates
+// once and refills every frame. A DynamicBuffer_t encodes the page, offset and size of its range.
+
+static constexpr uint32_t kMaxDynamicBufferPages = 127;
+
+enum class DynamicBufferPageType : uint8_t
+{
+	Constant,
+	Geometry,
+	Count
+};
+
+struct DynamicBufferAllocation
+{
+	uint32_t page;
+	uint32_t offset;
+	uint32_t size;
+};
+
+inline DynamicBufferAllocation DynamicBuffers_Decode(DynamicBuffer_t db)
+{
+	const uint64_t bits = (uint64_t)db;
+
+	DynamicBufferAllocation alloc;
+	alloc.page = (uint32_t)((bits >> 56) & 0x7f) - 1;
+	alloc.offset = (uint32_t)bits;
+	alloc.size = (uint32_t)((bits >> 32) & 0xffffff) * 16;
+	return alloc;
+}
+
+bool CreateDynamicBufferPageImpl(uint32_t page, DynamicBufferPageType type, size_t size);
+
+// Uploads [begin, end) of the page from its CPU copy. begin is 0 for the first upload of the page in a frame.
+void UploadDynamicBufferPageImpl(uint32_t page, const uint8_t* const data, size_t begin, size_t end);
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../CommandList.h"
+
+CommandListImpl* CreateCommandListImpl();
+void DestroyCommandListImpl(CommandListImpl* cl);
+
+void BeginCommandListImpl(CommandListImpl* cl);
+void FinishCommandListImpl(CommandListImpl* cl);
+void ExecuteCommandListImpl(CommandListImpl* cl);
+void ExecuteAndStallCommandListImpl(CommandListImpl* cl);
+
+void ClearRenderTargetImpl(CommandListImpl* cl, RenderTargetView_t rtv, const float col[4]);
+void ClearDepthImpl(CommandListImpl* cl, DepthStencilView_t dsv, float depth);
+void ClearUnorderedAccessViewImpl(CommandListImpl* cl, UnorderedAccessView_t uav, const float col[4]);
+void ClearUnorderedAccessViewImpl(CommandListImpl* cl, UnorderedAccessView_t uav, const uint32_t values[4]);
+
+void SetRenderTargetsImpl(CommandListImpl* cl, const RenderTargetView_t* const rtvs, size_t num, DepthStencilView_t dsv);
+void SetViewportsImpl(CommandListImpl* cl, const Viewport* const vps, size_t num);
+void SetDefaultScissorImpl(CommandListImpl* cl);
+void SetScissorsImpl(CommandListImpl* cl, const ScissorRect* const scissors, size_t num);
+void SetGraphicsPipelineStateImpl(CommandListImpl* cl, GraphicsPipelineState_t pso);
+void SetComputePipelineStateImpl(CommandListImpl* cl, ComputePipelineState_t pso);
+void SetVertexBuffersImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const VertexBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets);
+void SetVertexBuffersImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets);
+void SetIndexBufferImpl(CommandListImpl* cl, IndexBuffer_t ib, RenderFormat format, uint32_t indexOffset);
+void SetIndexBufferImpl(CommandListImpl* cl, DynamicBuffer_t ib, RenderFormat format, uint32_t indexOffset);
+
+void CopyTextureImpl(CommandListImpl* cl, Texture_t dst, Texture_t src);
+void ResourceBarriersImpl(CommandListImpl* cl, const ResourceBarrier* const barriers, size_t num);
+
+void DrawIndexedInstancedImpl(CommandListImpl* cl, uint32_t numIndices, uint32_t numInstances, uint32_t startIndex, uint32_t startVertex, uint32_t startInstance);
+void DrawInstancedImpl(CommandListImpl* cl, uint32_t numVerts, uint32_t numInstances, uint32_t startVertex, uint32_t startInstance);
+
+void DispatchImpl(CommandListImpl* cl, uint32_t x, uint32_t y, uint32_t z);
+
+void BindVertexSRVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs);
+void BindVertexCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs);
+void BindVertexCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs);
+
+void BindGeometryCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs);
+void BindGeometryCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs);
+
+void BindPixelSRVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs);
+void BindPixelCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs);
+void BindPixelCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs);
+
+void BindComputeSRVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs);
+void BindComputeUAVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const UnorderedAccessView_t* const uavs);
+void BindComputeCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs);
+void BindComputeCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs);
\ No newline at end of file
@@ -1,48 +1,35 @@
 #include "../BindingImpl.h"
 
+#include "../../PagedArray.h"
 #include "RenderImpl.h"
 #include "../../Textures.h"
 
-#include <vector>
-
-std::vector<ComPtr<ID3D11ShaderResourceView>> g_SRVs;
-std::vector<ComPtr<ID3D11UnorderedAccessView>> g_UAVs;
-std::vector<ComPtr<ID3D11RenderTargetView>> g_RTVs;
-std::vector<ComPtr<ID3D11DepthStencilView>> g_DSVs;
+PagedArray<ComPtr<ID3D11ShaderResourceView>> g_SRVs;
+PagedArray<ComPtr<ID3D11UnorderedAccessView>> g_UAVs;
+PagedArray<ComPtr<ID3D11RenderTargetView>> g_RTVs;
+PagedArray<ComPtr<ID3D11DepthStencilView>> g_DSVs;
 
 static ComPtr<ID3D11ShaderResourceView>& AllocSRV(ShaderResourceView_t srv)
 {
-	if ((uint32_t)srv >= g_SRVs.size())
-		g_SRVs.resize((uint32_t)srv + 1);
-
-	return g_SRVs[(uint32_t)srv];
+	return g_SRVs.Alloc((uint32_t)srv);
 }
 
 static ComPtr<ID3D11UnorderedAccessView>& AllocUAV(UnorderedAccessView_t uav)
 {
-	if ((uint32_t)uav >= g_UAVs.size())
-		g_UAVs.resize((uint32_t)uav + 1);
-
-	return g_UAVs[(uint32_t)uav];
+	return g_UAVs.Alloc((uint32_t)uav);
 }
 
 static ComPtr<ID3D11RenderTargetView>& AllocRTV(RenderTargetView_t rtv)
 {
-	if ((uint32_t)rtv >= g_RTVs.size())
-		g_RTVs.resize((uint32_t)rtv + 1);
-
-	return g_RTVs[(uint32_t)rtv];
+	return g_RTVs.Alloc((uint32_t)rtv);
 }
 
 static ComPtr<ID3D11DepthStencilView>& AllocDSV(DepthStencilView_t dsv)
 {
-	if ((uint32_t)dsv >= g_DSVs.size())
-		g_DSVs.resize((uint32_t)dsv + 1);
-
-	return g_DSVs[(uint32_t)dsv];
+	return g_DSVs.Alloc((uint32_t)dsv);
 }
 
-bool CreateTextureSRVImpl(ShaderResourceView_t srv, Texture_t tex, RenderFormat format, TextureDimension dim, uint32_t mipLevels, uint32_t arraySize)
+bool CreateTextureSRVImpl(ShaderResourceView_t srv, Texture_t tex, RenderFormat format, TextureDimension dim, uint32_t firstMip, uint32_t mipLevels, uint32_t firstSlice, uint32_t arraySize)
 {
 	auto& dxSRV = AllocSRV(srv);
 
@@ -55,58 +42,68 @@ bool CreateTextureSRVImpl(ShaderResourceView_t srv, Texture_t tex, RenderFormat
 	desc.Format = Dx11_Format(format);
 	if (dim == TextureDimension::Tex1D)
 	{
-		if (arraySize > 1)
+		if (arraySize > 1 || firstSlice > 0)
 		{
 			desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE1DARRAY;
+			desc.Texture1DArray.FirstArraySlice = (UINT)firstSlice;
 			desc.Texture1DArray.ArraySize = (UINT)arraySize;
-			desc.Texture1DArray.MipLevels = (UINT)-1;
+			desc.Texture1DArray.MostDetailedMip = (UINT)firstMip;
+			desc.Texture1DArray.MipLevels = (UINT)mipLevels;
 		}
 		else
 		{
 			desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE1D;
-			desc.Texture1D.MipLevels = (UINT)-1;
+			desc.Texture1D.MostDetailedMip = (UINT)firstMip;
+			desc.Texture1D.MipLevels = (UINT)mipLevels;
 		}		
 		
 	}
 	else if (dim == TextureDimension::Tex2D)
 	{
-		if (arraySize > 1)
+		if (arraySize > 1 || firstSlice > 0)
 		{
 			desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+			desc.Texture2DArray.FirstArraySlice = (UINT)firstSlice;
 			desc.Texture2DArray.ArraySize = (UINT)arraySize;
-			desc.Texture2DArray.MipLevels = (UINT)-1;
+			desc.Texture2DArray.MostDetailedMip = (UINT)firstMip;
+			desc.Texture2DArray.MipLevels = (UINT)mipLevels;
 		}
 		else
 		{
 			desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-			desc.Texture2D.MipLevels = (UINT)-1;
+			desc.Texture2D.MostDetailedMip = (UINT)firstMip;
+			desc.Texture2D.MipLevels = (UINT)mipLevels;
 		}
 
 	}
 	else if (dim == TextureDimension::Tex3D)
 	{
 		desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE3D;
-		desc.Texture2D.MipLevels = (UINT)-1;
+		desc.Texture3D.MostDetailedMip = (UINT)firstMip;
+		desc.Texture3D.MipLevels = (UINT)mipLevels;
 	}
 	else if (dim == TextureDimension::Cubemap)
 	{
-		if (arraySize > 1)
+		if (arraySize > 1 || firstSlice > 0)
 		{
 			desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBEARRAY;
+			desc.TextureCubeArray.First2DArrayFace = (UINT)firstSlice;
 			desc.TextureCubeArray.NumCubes = arraySize / 6;
-			desc.TextureCubeArray.MipLevels = (UINT)-1;
+			desc.TextureCubeArray.MostDetailedMip = (UINT)firstMip;
+			desc.TextureCubeArray.MipLevels = (UINT)mipLevels;
 		}
 		else
 		{
 			desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
-			desc.TextureCube.MipLevels = (UINT)-1;
+			desc.TextureCube.MostDetailedMip = (UINT)firstMip;
+			desc.TextureCube.MipLevels = (UINT)mipLevels;
 		}
 		
 	}
 	return SUCCEEDED(g_render.device->CreateShaderResourceView(res, &desc, &dxSRV));
 }
 
-bool CreateTextureUAVImpl(UnorderedAccessView_t uav, Texture_t tex, RenderFormat format, uint32_t arraySize)
+bool CreateTextureUAVImpl(UnorderedAccessView_t uav, Texture_t tex, RenderFormat format, uint32_t mipSlice, uint32_t firstSlice, uint32_t arraySize)
 {
 	auto& dxUav = AllocUAV(uav);
 
@@ -118,23 +115,23 @@ bool CreateTextureUAVImpl(UnorderedAccessView_t uav, Texture_t tex, RenderFormat
 
 	desc.Format = Dx11_Format(format);
 
-	if (arraySize > 1)
+	if (arraySize > 1 || firstSlice > 0)
 	{
 		desc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2DARRAY;
 		desc.Texture2DArray.ArraySize = (UINT)arraySize;
-		desc.Texture2DArray.FirstArraySlice = 0;
-		desc.Texture2DArray.MipSlice = 0;
+		desc.Texture2DArray.FirstArraySlice = (UINT)firstSlice;
+		desc.Texture2DArray.MipSlice = (UINT)mipSlice;
 	}
 	else
 	{
 		desc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2D;
-		desc.Texture2D.MipSlice = 0;
+		desc.Texture2D.MipSlice = (UINT)mipSlice;
 	}
 
 	return SUCCEEDED(g_render.device->CreateUnorderedAccessView(res, &desc, &dxUav));
 }
 
-bool CreateTextureRTVImpl(RenderTargetView_t rtv, Texture_t tex, RenderFormat format, uint32_t arraySize)
+bool CreateTextureRTVImpl(RenderTargetView_t rtv, Texture_t tex, RenderFormat format, uint32_t mipSlice, uint32_t firstSlice, uint32_t arraySize)
 {
 	auto& dxRtv = AllocRTV(rtv);
 
@@ -146,24 +143,24 @@ bool CreateTextureRTVImpl(RenderTargetView_t rtv, Texture_t tex, RenderFormat fo
 
 	desc.Format = Dx11_Format(format);
 
-	if(arraySize > 1)
+	if (arraySize > 1 || firstSlice > 0)
 	{
-		desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
-		desc.Texture2D.MipSlice = 0;
+		desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2DARRAY;
+		desc.Texture2DArray.ArraySize = (UINT)arraySize;
+		desc.Texture2DArray.FirstArraySlice = (UINT)firstSlice;
+		desc.Texture2DArray.MipSlice = (UINT)mipSlice;
 	}
 	else
 	{
-		desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2DARRAY;
-		desc.Texture2DArray.ArraySize = (UINT)arraySize;
-		desc.Texture2DArray.FirstArraySlice = 0;
-		desc.Texture2DArray.MipSlice = 0;
+		desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
+		desc.Texture2D.MipSlice = (UINT)mipSlice;
 	}
 
 
 	return SUCCEEDED(g_render.device->CreateRenderTargetView(res, &desc, &dxRtv));
 }
 
-bool CreateTextureDSVImpl(DepthStencilView_t dsv, Texture_t tex, RenderFormat format, uint32_t arraySize)
+bool CreateTextureDSVImpl(DepthStencilView_t dsv, Texture_t tex, RenderFormat format, uint32_t mipSlice, uint32_t firstSlice, uint32_t arraySize)
 {
 	auto& dxDsv = AllocDSV(dsv);
 
@@ -175,17 +172,17 @@ bool CreateTextureDSVImpl(DepthStencilView_t dsv, Texture_t tex, RenderFormat fo
 
 	desc.Format = Dx11_Format(format);
 
-	if (arraySize > 1)
+	if (arraySize > 1 || firstSlice > 0)
 	{
 		desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
 		desc.Texture2DArray.ArraySize = (UINT)arraySize;
-		desc.Texture2DArray.FirstArraySlice = 0;
-		desc.Texture2DArray.MipSlice = 0;
+		desc.Texture2DArray.FirstArraySlice = (UINT)firstSlice;
+		desc.Texture2DArray.MipSlice = (UINT)mipSlice;
 	}
 	else
 	{
 		desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
-		desc.Texture2D.MipSlice = 0;
+		desc.Texture2D.MipSlice = (UINT)mipSlice;
 	}
 
 	return SUCCEEDED(g_render.device->CreateDepthStencilView(res, &desc, &dxDsv));
@@ -232,46 +229,50 @@ bool CreateStructuredBufferUAVImpl(UnorderedAccessView_t uav, StructuredBuffer_t
 
 void DestroySRV(ShaderResourceView_t srv)
 {
-	if ((uint32_t)srv < g_SRVs.size())
-		g_SRVs[(uint32_t)srv] = nullptr;
+	if (auto* view = g_SRVs.TryGet((uint32_t)srv))
+		*view = nullptr;
 }
 
 void DestroyUAV(UnorderedAccessView_t uav)
 {
-	if ((uint32_t)uav < g_UAVs.size())
-		g_UAVs[(uint32_t)uav] = nullptr;
+	if (auto* view = g_UAVs.TryGet((uint32_t)uav))
+		*view = nullptr;
 }
 
 void DestroyRTV(RenderTargetView_t rtv)
 {
-	if ((uint32_t)rtv < g_RTVs.size())
-		g_RTVs[(uint32_t)rtv] = nullptr;
+	if (auto* view = g_RTVs.TryGet((uint32_t)rtv))
+		*view = nullptr;
 }
 
 void DestroyDSV(DepthStencilView_t dsv)
 {
-	if ((uint32_t)dsv < g_DSVs.size())
-		g_DSVs[(uint32_t)dsv] = nullptr;
+	if (auto* view = g_DSVs.TryGet((uint32_t)dsv))
+		*view = nullptr;
 }
 
 ID3D11ShaderResourceView* Dx11_GetShaderResourceView(ShaderResourceView_t srv)
 {
-	return (size_t)srv > 0 && (size_t)srv < g_SRVs.size() ? g_SRVs[(size_t)srv].Get() : nullptr;
+	auto* view = g_SRVs.TryGet((uint32_t)srv);
+	return (uint32_t)srv > 0 && view ? view->Get() : nullptr;
 }
 
 ID3D11UnorderedAccessView* Dx11_GetUnorderedAccessView(UnorderedAccessView_t uav)
 {
-	return (size_t)uav > 0 && (size_t)uav < g_UAVs.size() ? g_UAVs[(size_t)uav].Get() : nullptr;
+	auto* view = g_UAVs.TryGet((uint32_t)uav);
+	return (uint32_t)uav > 0 && view ? view->Get() : nullptr;
 }
 
 ID3D11RenderTargetView* Dx11_GetRenderTargetView(RenderTargetView_t rtv)
 {
-	return (size_t)rtv > 0 && (size_t)rtv < g_RTVs.size() ? g_RTVs[(size_t)rtv].Get() : nullptr;
+	auto* view = g_RTVs.TryGet((uint32_t)rtv);
+	return (uint32_t)rtv > 0 && view ? view->Get() : nullptr;
 }
 
 ID3D11DepthStencilView* Dx11_GetDepthStencilView(DepthStencilView_t dsv)
 {
-	return (size_t)dsv > 0 && (size_t)dsv < g_DSVs.size() ? g_DSVs[(size_t)dsv].Get() : nullptr;
+	auto* view = g_DSVs.TryGet((uint32_t)dsv);
+	return (uint32_t)dsv > 0 && view ? view->Get() : nullptr;
 }
 
 void DX11_CreateBackBufferRTV(RenderTargetView_t rtv, ID3D11Resource* backBufferResource)
@@ -1,47 +1,40 @@
 #include "../BuffersImpl.h"
 
-#include "../../IDArray.h"
+#include "../../PagedArray.h"
 #include "RenderImpl.h"
 
-#include <vector>
+PagedArray<ComPtr<ID3D11Buffer>> g_DxVertexBuffers;
+PagedArray<ComPtr<ID3D11Buffer>> g_DxIndexBuffers;
+PagedArray<ComPtr<ID3D11Buffer>> g_DxStructuredBuffers;
+PagedArray<ComPtr<ID3D11Buffer>> g_DxConstantBuffers;
 
-std::vector<ComPtr<ID3D11Buffer>> g_DxVertexBuffers;
-std::vector<ComPtr<ID3D11Buffer>> g_DxIndexBuffers;
-std::vector<ComPtr<ID3D11Buffer>> g_DxStructuredBuffers;
-std::vector<ComPtr<ID3D11Buffer>> g_DxConstantBuffers;
+struct Dx11DynamicBufferPage
+{
+	ComPtr<ID3D11Buffer> buffer = nullptr;
+	bool noOverwrite = false;
+};
 
-std::vector<ComPtr<ID3D11Buffer>> g_DxDynamicBuffers;
+// Fixed size so pages created while command lists are recorded on worker threads never move.
+Dx11DynamicBufferPage g_DxDynamicBufferPages[kMaxDynamicBufferPages];
 
 static ComPtr<ID3D11Buffer>& AllocVertexBuffer(VertexBuffer_t vb)
 {
-	if ((size_t)vb >= g_DxVertexBuffers.size())
-		g_DxVertexBuffers.resize((uint32_t)vb + 1);
-
-	return g_DxVertexBuffers[(uint32_t)vb];
+	return g_DxVertexBuffers.Alloc((uint32_t)vb);
 }
 
 static ComPtr<ID3D11Buffer>& AllocIndexBuffer(IndexBuffer_t ib)
 {
-	if ((size_t)ib >= g_DxIndexBuffers.size())
-		g_DxIndexBuffers.resize((uint32_t)ib + 1);
-
-	return g_DxIndexBuffers[(uint32_t)ib];
+	return g_DxIndexBuffers.Alloc((uint32_t)ib);
 }
 
 static ComPtr<ID3D11Buffer>& AllocStructuredBuffer(StructuredBuffer_t sb)
 {
-	if ((size_t)sb >= g_DxStructuredBuffers.size())
-		g_DxStructuredBuffers.resize((uint32_t)sb + 1);
-
-	return g_DxStructuredBuffers[(uint32_t)sb];
+	return g_DxStructuredBuffers.Alloc((uint32_t)sb);
 }
 
 static ComPtr<ID3D11Buffer>& AllocConstantBuffer(ConstantBuffer_t cb)
 {
-	if ((size_t)cb >= g_DxConstantBuffers.size())
-		g_DxConstantBuffers.resize((uint32_t)cb + 1);
-
-	return g_DxConstantBuffers[(uint32_t)cb];
+	return g_DxConstantBuffers.Alloc((uint32_t)cb);
 }
 
 bool CreateBuffer(const void* const data, UINT size, D3D11_USAGE usage, UINT bind, UINT misc, UINT stride, ComPtr<ID3D11Buffer>& buffer)
@@ -170,40 +163,63 @@ ID3D11Buffer* Dx11_GetConstantBuffer(ConstantBuffer_t cb)
 	return g_DxConstantBuffers[(uint32_t)cb].Get();
 }
 
-ID3D11Buffer* Dx11_GetDynamicBuffer(DynamicBuffer_t db)
+ID3D11Buffer* Dx11_GetDynamicBuffer(DynamicBuffer_t db, UINT* offset, UINT* size)
 {
-	return g_DxDynamicBuffers[(uint32_t)db].Get();
+	if (db == DynamicBuffer_t::INVALID)
+	{
+		*offset = 0;
+		*size = 0;
+		return nullptr;
+	}
+
+	const DynamicBufferAllocation alloc = DynamicBuffers_Decode(db);
+	*offset = alloc.offset;
+	*size = alloc.size;
+
+	return g_DxDynamicBufferPages[alloc.page].buffer.Get();
 }
 
-static DynamicBuffer_t CreateDynamicBuffer(const void* const data, size_t size, D3D11_BIND_FLAG bind)
+bool CreateDynamicBufferPageImpl(uint32_t page, DynamicBufferPageType type, size_t size)
 {
-	ComPtr<ID3D11Buffer> dynBuf;
+	Dx11DynamicBufferPage& dxPage = g_DxDynamicBufferPages[page];
 
-	if (CreateBuffer(data, (UINT)size, D3D11_USAGE_IMMUTABLE, bind, 0, 0, dynBuf))
+	const UINT bind = type == DynamicBufferPageType::Constant ? D3D11_BIND_CONSTANT_BUFFER : D3D11_BIND_VERTEX_BUFFER | D3D11_BIND_INDEX_BUFFER;
+
+	if (!CreateBuffer(nullptr, (UINT)size, D3D11_USAGE_DYNAMIC, bind, 0, 0, dxPage.buffer))
+		return false;
+
+	// Appending to a constant buffer page with NO_OVERWRITE is optional on 11.1, otherwise the page is discarded and refilled.
+	dxPage.noOverwrite = true;
+	if (type == DynamicBufferPageType::Constant)
 	{
-		g_DxDynamicBuffers.push_back(dynBuf);
-		return (DynamicBuffer_t)(g_DxDynamicBuffers.size() - 1);
+		D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+		g_render.device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+
+		assert(options.ConstantBufferOffsetting && "CreateDynamicBufferPageImpl requires constant buffer offsetting");
+
+		dxPage.noOverwrite = options.MapNoOverwriteOnDynamicConstantBuffer;
 	}
-	
-	return DynamicBuffer_t::INVALID;
-}
 
-DynamicBuffer_t CreateDynamicVertexBuffer(const void* const data, size_t size)
-{
-	return CreateDynamicBuffer(data, size, D3D11_BIND_VERTEX_BUFFER);
+	return true;
 }
 
-DynamicBuffer_t CreateDynamicIndexBuffer(const void* const data, size_t size)
+void UploadDynamicBufferPageImpl(uint32_t page, const uint8_t* const data, size_t begin, size_t end)
 {
-	return CreateDynamicBuffer(data, size, D3D11_BIND_INDEX_BUFFER);
-}
+	Dx11DynamicBufferPage& dxPage = g_DxDynamicBufferPages[page];
 
-DynamicBuffer_t CreateDynamicConstantBuffer(const void* const data, size_t size)
-{
-	return CreateDynamicBuffer(data, size, D3D11_BIND_CONSTANT_BUFFER);
-}
+	if (!dxPage.noOverwrite)
+		begin = 0;
 
-void DynamicBuffers_NewFrame()
-{
-	g_DxDynamicBuffers.resize(1);
+	const D3D11_MAP mapType = begin == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+
+	D3D11_MAPPED_SUBRESOURCE subRes;
+	if (FAILED(g_render.context->Map(dxPage.buffer.Get(), 0, mapType, 0, &subRes)))
+	{
+		assert(0 && "UploadDynamicBufferPageImpl failed to map buffer");
+		return;
+	}
+
+	memcpy((uint8_t*)subRes.pData + begin, data + begin, end - begin);
+
+	g_render.context->Unmap(dxPage.buffer.Get(), 0);
 }
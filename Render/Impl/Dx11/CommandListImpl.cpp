@@ -1,57 +1,109 @@
-#include "../../CommandList.h"
+#include "../CommandListImpl.h"
 
 #include "RenderImpl.h"
 
-std::vector<CommandListPtr> g_FreeCommandLists;
-
 struct CommandListImpl
 {
 	ComPtr<ID3D11DeviceContext> context = nullptr;
+	ComPtr<ID3D11DeviceContext1> context1 = nullptr;
 	ComPtr<ID3D11CommandList> commandList = nullptr;
 };
 
-CommandList::CommandList(CommandListImpl* cl)
+CommandListImpl* CreateCommandListImpl()
 {
-	impl = std::unique_ptr<CommandListImpl>(cl);
+	CommandListImpl* cl = new CommandListImpl;
+
+	g_render.device->CreateDeferredContext(0, &cl->context);
+	cl->context.As(&cl->context1);
+
+	return cl;
 }
 
-CommandList::~CommandList()
+void DestroyCommandListImpl(CommandListImpl* cl)
 {
+	delete cl;
 }
 
-void CommandList::Begin()
+void BeginCommandListImpl(CommandListImpl* cl)
 {
-	impl->context->ClearState();
+	cl->context->ClearState();
 	const UINT samplerCount = (UINT)Dx11_GetSamplerCount();
 	for (UINT s = 0; s < samplerCount; s++)
 	{
 		ID3D11SamplerState* ss = Dx11_GetSampler(s);
 
-		impl->context->VSSetSamplers(s, 1, &ss);
-		impl->context->CSSetSamplers(s, 1, &ss);
-		impl->context->PSSetSamplers(s, 1, &ss);
+		cl->context->VSSetSamplers(s, 1, &ss);
+		cl->context->CSSetSamplers(s, 1, &ss);
+		cl->context->PSSetSamplers(s, 1, &ss);
 	}
 }
 
-void CommandList::Finish()
+void FinishCommandListImpl(CommandListImpl* cl)
+{
+	cl->context->FinishCommandList(FALSE, &cl->commandList);
+}
+
+void ExecuteCommandListImpl(CommandListImpl* cl)
+{
+	assert(cl->commandList);
+
+	g_render.context->ExecuteCommandList(cl->commandList.Get(), FALSE);
+}
+
+void ExecuteAndStallCommandListImpl(CommandListImpl* cl)
+{
+	D3D11_QUERY_DESC qDesc = {};
+	qDesc.Query = D3D11_QUERY_EVENT;
+
+	ComPtr<ID3D11Query> dxQuery;
+
+	g_render.device->CreateQuery(&qDesc, &dxQuery);
+
+	g_render.context->ExecuteCommandList(cl->commandList.Get(), FALSE);
+
+	g_render.context->End(dxQuery.Get());
+
+	UINT32 queryData;
+	while (g_render.context->GetData(dxQuery.Get(), &queryData, sizeof(queryData), 0) != S_OK)
+		Sleep(5);
+}
+
+// Dynamic constant buffers are bound as a window into their page, in 16 byte constants.
+static void GetDynamicConstantBuffers(uint32_t count, const DynamicBuffer_t* const cbvs, ID3D11Buffer** dxCbvs, UINT* firstConstants, UINT* numConstants)
 {
-	impl->context->FinishCommandList(FALSE, &impl->commandList);
-	lastPipeline = GraphicsPipelineState_t::INVALID;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		dxCbvs[i] = Dx11_GetDynamicBuffer(cbvs[i], &firstConstants[i], &numConstants[i]);
+		firstConstants[i] /= 16;
+		numConstants[i] /= 16;
+	}
 }
 
-void CommandList::ClearRenderTarget(RenderTargetView_t rtv, const float col[4])
+void ClearRenderTargetImpl(CommandListImpl* cl, RenderTargetView_t rtv, const float col[4])
 {
 	ID3D11RenderTargetView* dxRtv = Dx11_GetRenderTargetView(rtv);
-	impl->context->ClearRenderTargetView(dxRtv, col);
+	cl->context->ClearRenderTargetView(dxRtv, col);
 }
 
-void CommandList::ClearDepth(DepthStencilView_t dsv, float depth)
+void ClearDepthImpl(CommandListImpl* cl, DepthStencilView_t dsv, float depth)
 {
 	ID3D11DepthStencilView* dxDsv = Dx11_GetDepthStencilView(dsv);
-	impl->context->ClearDepthStencilView(dxDsv, D3D11_CLEAR_DEPTH, depth, 0);
+	cl->context->ClearDepthStencilView(dxDsv, D3D11_CLEAR_DEPTH, depth, 0);
 }
 
-void CommandList::SetRenderTargets(const RenderTargetView_t* const rtvs, size_t num, DepthStencilView_t dsv)
+void ClearUnorderedAccessViewImpl(CommandListImpl* cl, UnorderedAccessView_t uav, const float col[4])
+{
+	ID3D11UnorderedAccessView* dxUav = Dx11_GetUnorderedAccessView(uav);
+	cl->context->ClearUnorderedAccessViewFloat(dxUav, col);
+}
+
+void ClearUnorderedAccessViewImpl(CommandListImpl* cl, UnorderedAccessView_t uav, const uint32_t values[4])
+{
+	ID3D11UnorderedAccessView* dxUav = Dx11_GetUnorderedAccessView(uav);
+	cl->context->ClearUnorderedAccessViewUint(dxUav, values);
+}
+
+void SetRenderTargetsImpl(CommandListImpl* cl, const RenderTargetView_t* const rtvs, size_t num, DepthStencilView_t dsv)
 {
 	assert(num <= 8);
 
@@ -62,10 +114,10 @@ void CommandList::SetRenderTargets(const RenderTargetView_t* const rtvs, size_t
 
 	ID3D11DepthStencilView* dxDsv = Dx11_GetDepthStencilView(dsv);
 
-	impl->context->OMSetRenderTargets((UINT)num, dxRtvs, dxDsv);
+	cl->context->OMSetRenderTargets((UINT)num, dxRtvs, dxDsv);
 }
 
-void CommandList::SetViewports(const Viewport* const vps, size_t num)
+void SetViewportsImpl(CommandListImpl* cl, const Viewport* const vps, size_t num)
 {
 	assert(num <= 8);
 
@@ -80,16 +132,16 @@ void CommandList::SetViewports(const Viewport* const vps, size_t num)
 		dxVps[i].MaxDepth	= vps[i].maxDepth;
 	}
 
-	impl->context->RSSetViewports((UINT)num, dxVps);
+	cl->context->RSSetViewports((UINT)num, dxVps);
 }
 
-void CommandList::SetDefaultScissor()
+void SetDefaultScissorImpl(CommandListImpl* cl)
 {
 	D3D11_RECT rect = CD3D11_RECT(0, 0, LONG_MAX, LONG_MAX);
-	impl->context->RSSetScissorRects(1, &rect);
+	cl->context->RSSetScissorRects(1, &rect);
 }
 
-void CommandList::SetScissors(const ScissorRect* const scissors, size_t num)
+void SetScissorsImpl(CommandListImpl* cl, const ScissorRect* const scissors, size_t num)
 {
 	assert(num <= 8);
 	D3D11_RECT dxRects[8];
@@ -101,293 +153,233 @@ void CommandList::SetScissors(const ScissorRect* const scissors, size_t num)
 		dxRects[i].bottom = scissors[i].bottom;
 	}
 
-	impl->context->RSSetScissorRects((UINT)num, dxRects);
+	cl->context->RSSetScissorRects((UINT)num, dxRects);
 }
 
-void CommandList::SetPipelineState(GraphicsPipelineState_t pso)
+void SetGraphicsPipelineStateImpl(CommandListImpl* cl, GraphicsPipelineState_t pso)
 {
-	if (pso == lastPipeline)
-		return;
-
 	Dx11GraphicsPipelineState* dxPso = Dx11_GetGraphicsPipelineState(pso);
 
-	impl->context->IASetPrimitiveTopology(dxPso->pt);
-	impl->context->IASetInputLayout(dxPso->il.Get());
-	impl->context->OMSetDepthStencilState(dxPso->dss.Get(), 0);
-	impl->context->RSSetState(dxPso->rs.Get());
-	impl->context->OMSetBlendState(dxPso->bs.Get(), nullptr, 0xffffffff);
-	impl->context->VSSetShader(Dx11_GetVertexShader(dxPso->vs), nullptr, 0);
-	impl->context->GSSetShader(Dx11_GetGeometryShader(dxPso->gs), nullptr, 0);
-	impl->context->PSSetShader(Dx11_GetPixelShader(dxPso->ps), nullptr, 0);
-	impl->context->CSSetShader(nullptr, nullptr, 0);
-
-	lastComputePipeline = ComputePipelineState_t::INVALID;
-	lastPipeline = pso;
+	cl->context->IASetPrimitiveTopology(dxPso->pt);
+	cl->context->IASetInputLayout(dxPso->il.Get());
+	cl->context->OMSetDepthStencilState(dxPso->dss.Get(), 0);
+	cl->context->RSSetState(dxPso->rs.Get());
+	cl->context->OMSetBlendState(dxPso->bs.Get(), nullptr, 0xffffffff);
+	cl->context->VSSetShader(Dx11_GetVertexShader(dxPso->vs), nullptr, 0);
+	cl->context->GSSetShader(Dx11_GetGeometryShader(dxPso->gs), nullptr, 0);
+	cl->context->PSSetShader(Dx11_GetPixelShader(dxPso->ps), nullptr, 0);
+	cl->context->CSSetShader(nullptr, nullptr, 0);
 }
 
-void CommandList::SetPipelineState(ComputePipelineState_t pso)
+void SetComputePipelineStateImpl(CommandListImpl* cl, ComputePipelineState_t pso)
 {
-	if (pso == lastComputePipeline)
-		return;
-
 	Dx11ComputePipelineState* dxPso = Dx11_GetComputePipelineState(pso);
 
-	//impl->context->ClearState();
-	impl->context->CSSetShader(Dx11_GetComputeShader(dxPso->_cs), nullptr, 0);
-
-	lastPipeline = GraphicsPipelineState_t::INVALID;
-	lastComputePipeline = pso;
+	//cl->context->ClearState();
+	cl->context->CSSetShader(Dx11_GetComputeShader(dxPso->_cs), nullptr, 0);
 }
 
-void CommandList::SetVertexBuffers(uint32_t startSlot, uint32_t count, const VertexBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
+void SetVertexBuffersImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const VertexBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
 {
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; slot++, i++)
-	{
-		ID3D11Buffer* dxVb = Dx11_GetVertexBuffer(vbs[i]);
-		impl->context->IASetVertexBuffers(slot, 1, &dxVb, (const UINT*)(&strides[i]), (const UINT*)(&offsets[i]));
-	}
+	assert(count <= D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT);
+
+	ID3D11Buffer* dxVbs[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+	for (uint32_t i = 0; i < count; i++)
+		dxVbs[i] = Dx11_GetVertexBuffer(vbs[i]);
+
+	cl->context->IASetVertexBuffers(startSlot, count, dxVbs, (const UINT*)strides, (const UINT*)offsets);
 }
 
-void CommandList::SetVertexBuffers(uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
+void SetVertexBuffersImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
 {
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; slot++, i++)
+	assert(count <= D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT);
+
+	ID3D11Buffer* dxVbs[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+	UINT dxOffsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+	for (uint32_t i = 0; i < count; i++)
 	{
-		ID3D11Buffer* dxVb = Dx11_GetDynamicBuffer(vbs[i]);
-		impl->context->IASetVertexBuffers(slot, 1, &dxVb, (const UINT*)(&strides[i]), (const UINT*)(&offsets[i]));
+		UINT size;
+		dxVbs[i] = Dx11_GetDynamicBuffer(vbs[i], &dxOffsets[i], &size);
+		dxOffsets[i] += offsets[i];
 	}
+
+	cl->context->IASetVertexBuffers(startSlot, count, dxVbs, (const UINT*)strides, dxOffsets);
 }
 
-void CommandList::SetIndexBuffer(IndexBuffer_t ib, RenderFormat format, uint32_t indexOffset)
+void SetIndexBufferImpl(CommandListImpl* cl, IndexBuffer_t ib, RenderFormat format, uint32_t indexOffset)
 {
 	ID3D11Buffer* dxIb = Dx11_GetIndexBuffer(ib);
-	impl->context->IASetIndexBuffer(dxIb, Dx11_Format(format), (UINT)indexOffset);
+	cl->context->IASetIndexBuffer(dxIb, Dx11_Format(format), (UINT)indexOffset);
 }
 
-void CommandList::SetIndexBuffer(DynamicBuffer_t ib, RenderFormat format, uint32_t indexOffset)
+void SetIndexBufferImpl(CommandListImpl* cl, DynamicBuffer_t ib, RenderFormat format, uint32_t indexOffset)
 {
-	ID3D11Buffer* dxIb = Dx11_GetDynamicBuffer(ib);
-	impl->context->IASetIndexBuffer(dxIb, Dx11_Format(format), (UINT)indexOffset);
+	UINT offset, size;
+	ID3D11Buffer* dxIb = Dx11_GetDynamicBuffer(ib, &offset, &size);
+	cl->context->IASetIndexBuffer(dxIb, Dx11_Format(format), offset + (UINT)indexOffset);
 }
 
-void CommandList::CopyTexture(Texture_t dst, Texture_t src)
+void CopyTextureImpl(CommandListImpl* cl, Texture_t dst, Texture_t src)
 {
 	ID3D11Resource* dxDst = Dx11_GetTexture(dst);
 	ID3D11Resource* dxSrc = Dx11_GetTexture(src);
 
-	impl->context->CopyResource(dxDst, dxSrc);
+	cl->context->CopyResource(dxDst, dxSrc);
 }
 
-void CommandList::DrawIndexedInstanced(uint32_t numIndices, uint32_t numInstances, uint32_t startIndex, uint32_t startVertex, uint32_t startInstance)
+void ResourceBarriersImpl(CommandListImpl* cl, const ResourceBarrier* const barriers, size_t num)
 {
-	impl->context->DrawIndexedInstanced((UINT)numIndices, (UINT)numInstances, (UINT)startIndex, (UINT)startVertex, (UINT)startInstance);
+	// The Dx11 runtime tracks resource hazards itself.
 }
 
-void CommandList::DrawInstanced(uint32_t numVerts, uint32_t numInstances, uint32_t startVertex, uint32_t startInstance)
+void DrawIndexedInstancedImpl(CommandListImpl* cl, uint32_t numIndices, uint32_t numInstances, uint32_t startIndex, uint32_t startVertex, uint32_t startInstance)
 {
-	impl->context->DrawInstanced((UINT)numVerts, (UINT)numInstances, (UINT)startVertex, (UINT)startInstance);
+	cl->context->DrawIndexedInstanced((UINT)numIndices, (UINT)numInstances, (UINT)startIndex, (UINT)startVertex, (UINT)startInstance);
 }
 
-void CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z)
+void DrawInstancedImpl(CommandListImpl* cl, uint32_t numVerts, uint32_t numInstances, uint32_t startVertex, uint32_t startInstance)
 {
-	impl->context->Dispatch(x, y, z);
+	cl->context->DrawInstanced((UINT)numVerts, (UINT)numInstances, (UINT)startVertex, (UINT)startInstance);
 }
 
-// Dx11 Style Bind Commands
-void CommandList::BindVertexSRVs(uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs)
+void DispatchImpl(CommandListImpl* cl, uint32_t x, uint32_t y, uint32_t z)
 {
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11ShaderResourceView* dxSrv = Dx11_GetShaderResourceView(srvs[i]);
-		impl->context->VSSetShaderResources(slot, 1, &dxSrv);
-	}
+	cl->context->Dispatch(x, y, z);
 }
 
-void CommandList::BindVertexCBVs(uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
+// Dx11 Style Bind Commands
+void BindVertexSRVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs)
 {
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11Buffer* dxCbv = Dx11_GetConstantBuffer(cbvs[i]);
-		impl->context->VSSetConstantBuffers(slot, 1, &dxCbv);
-	}
-}
+	assert(count <= D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT);
 
-void CommandList::BindVertexCBVs(uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
-{
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11Buffer* dxCbv = Dx11_GetDynamicBuffer(cbvs[i]);
-		impl->context->VSSetConstantBuffers(slot, 1, &dxCbv);
-	}
-}
+	ID3D11ShaderResourceView* dxSrvs[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT];
+	for (uint32_t i = 0; i < count; i++)
+		dxSrvs[i] = Dx11_GetShaderResourceView(srvs[i]);
 
-void CommandList::BindGeometryCBVs(uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
-{
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11Buffer* dxCbv = Dx11_GetConstantBuffer(cbvs[i]);
-		impl->context->GSSetConstantBuffers(slot, 1, &dxCbv);
-	}
+	cl->context->VSSetShaderResources(startSlot, count, dxSrvs);
 }
 
-void CommandList::BindGeometryCBVs(uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
+void BindVertexCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
 {
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11Buffer* dxCbv = Dx11_GetDynamicBuffer(cbvs[i]);
-		impl->context->GSSetConstantBuffers(slot, 1, &dxCbv);
-	}
-}
+	assert(count <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
 
-void CommandList::BindPixelSRVs(uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs)
-{
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11ShaderResourceView* dxSrv = Dx11_GetShaderResourceView(srvs[i]);
-		impl->context->PSSetShaderResources(slot, 1, &dxSrv);
-	}
-}
+	ID3D11Buffer* dxCbvs[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	for (uint32_t i = 0; i < count; i++)
+		dxCbvs[i] = Dx11_GetConstantBuffer(cbvs[i]);
 
-void CommandList::BindPixelCBVs(uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
-{
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11Buffer* dxCbv = Dx11_GetConstantBuffer(cbvs[i]);
-		impl->context->PSSetConstantBuffers(slot, 1, &dxCbv);
-	}
+	cl->context->VSSetConstantBuffers(startSlot, count, dxCbvs);
 }
 
-void CommandList::BindPixelCBVs(uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
+void BindVertexCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
 {
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11Buffer* dxCbv = Dx11_GetDynamicBuffer(cbvs[i]);
-		impl->context->PSSetConstantBuffers(slot, 1, &dxCbv);
-	}
-}
+	assert(count <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
 
-void CommandList::BindComputeSRVs(uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs)
-{
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11ShaderResourceView* dxSrv = Dx11_GetShaderResourceView(srvs[i]);
-		impl->context->CSSetShaderResources(slot, 1, &dxSrv);
-	}
-}
+	ID3D11Buffer* dxCbvs[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	UINT firstConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	UINT numConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	GetDynamicConstantBuffers(count, cbvs, dxCbvs, firstConstants, numConstants);
 
-void CommandList::BindComputeUAVs(uint32_t startSlot, uint32_t count, const UnorderedAccessView_t* const srvs)
-{
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11UnorderedAccessView* dxUav = Dx11_GetUnorderedAccessView(srvs[i]);
-		impl->context->CSSetUnorderedAccessViews(slot, 1, &dxUav, nullptr);
-	}
+	cl->context1->VSSetConstantBuffers1(startSlot, count, dxCbvs, firstConstants, numConstants);
 }
 
-void CommandList::BindComputeCBVs(uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
+void BindGeometryCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
 {
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11Buffer* dxCbv = Dx11_GetConstantBuffer(cbvs[i]);
-		impl->context->CSSetConstantBuffers(slot, 1, &dxCbv);
-	}
+	assert(count <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
+
+	ID3D11Buffer* dxCbvs[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	for (uint32_t i = 0; i < count; i++)
+		dxCbvs[i] = Dx11_GetConstantBuffer(cbvs[i]);
+
+	cl->context->GSSetConstantBuffers(startSlot, count, dxCbvs);
 }
 
-void CommandList::BindComputeCBVs(uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
+void BindGeometryCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
 {
-	const UINT endSlot = startSlot + count;
-	UINT slot = startSlot;
-	for (UINT i = 0; slot < endSlot; i++, slot++)
-	{
-		ID3D11Buffer* dxCbv = Dx11_GetDynamicBuffer(cbvs[i]);
-		impl->context->CSSetConstantBuffers(slot, 1, &dxCbv);
-	}
+	assert(count <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
+
+	ID3D11Buffer* dxCbvs[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	UINT firstConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	UINT numConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	GetDynamicConstantBuffers(count, cbvs, dxCbvs, firstConstants, numConstants);
+
+	cl->context1->GSSetConstantBuffers1(startSlot, count, dxCbvs, firstConstants, numConstants);
 }
 
-CommandListPtr CommandList::Create()
+void BindPixelSRVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs)
 {
-	if (!g_FreeCommandLists.empty())
-	{
-		CommandListPtr cl = g_FreeCommandLists.back();
-		g_FreeCommandLists.pop_back();
+	assert(count <= D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT);
 
-		cl->Begin();
-
-		return cl;
-	}
-	else
-	{
-		CommandListImpl* impl = new CommandListImpl;
+	ID3D11ShaderResourceView* dxSrvs[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT];
+	for (uint32_t i = 0; i < count; i++)
+		dxSrvs[i] = Dx11_GetShaderResourceView(srvs[i]);
 
-		g_render.device->CreateDeferredContext(0, &impl->context);
+	cl->context->PSSetShaderResources(startSlot, count, dxSrvs);
+}
 
-		CommandListPtr cl = std::make_shared<CommandList>(impl);
+void BindPixelCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
+{
+	assert(count <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
 
-		cl->Begin();
+	ID3D11Buffer* dxCbvs[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	for (uint32_t i = 0; i < count; i++)
+		dxCbvs[i] = Dx11_GetConstantBuffer(cbvs[i]);
 
-		return cl;
-	}
+	cl->context->PSSetConstantBuffers(startSlot, count, dxCbvs);
 }
 
-void CommandList::Execute(CommandListPtr& cl)
+void BindPixelCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
 {
-	assert(cl);
+	assert(count <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
 
-	cl->Finish();
+	ID3D11Buffer* dxCbvs[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	UINT firstConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	UINT numConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	GetDynamicConstantBuffers(count, cbvs, dxCbvs, firstConstants, numConstants);
 
-	assert(cl->impl->commandList);
+	cl->context1->PSSetConstantBuffers1(startSlot, count, dxCbvs, firstConstants, numConstants);
+}
 
-	g_render.context->ExecuteCommandList(cl->impl->commandList.Get(), FALSE);
+void BindComputeSRVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs)
+{
+	assert(count <= D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT);
+
+	ID3D11ShaderResourceView* dxSrvs[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT];
+	for (uint32_t i = 0; i < count; i++)
+		dxSrvs[i] = Dx11_GetShaderResourceView(srvs[i]);
 
-	g_FreeCommandLists.push_back(cl);
+	cl->context->CSSetShaderResources(startSlot, count, dxSrvs);
 }
 
-void CommandList::ExecuteAndStall(CommandListPtr& cl)
+void BindComputeUAVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const UnorderedAccessView_t* const uavs)
 {
-	D3D11_QUERY_DESC qDesc = {};
-	qDesc.Query = D3D11_QUERY_EVENT;
-
-	ComPtr<ID3D11Query> dxQuery;
+	assert(count <= D3D11_PS_CS_UAV_REGISTER_COUNT);
 
-	g_render.device->CreateQuery(&qDesc, &dxQuery);
+	ID3D11UnorderedAccessView* dxUavs[D3D11_PS_CS_UAV_REGISTER_COUNT];
+	for (uint32_t i = 0; i < count; i++)
+		dxUavs[i] = Dx11_GetUnorderedAccessView(uavs[i]);
 
-	cl->Finish();
+	cl->context->CSSetUnorderedAccessViews(startSlot, count, dxUavs, nullptr);
+}
 
-	g_render.context->ExecuteCommandList(cl->impl->commandList.Get(), FALSE);
+void BindComputeCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
+{
+	assert(count <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
 
-	g_render.context->End(dxQuery.Get());
+	ID3D11Buffer* dxCbvs[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	for (uint32_t i = 0; i < count; i++)
+		dxCbvs[i] = Dx11_GetConstantBuffer(cbvs[i]);
 
-	UINT32 queryData;
-	while (g_render.context->GetData(dxQuery.Get(), &queryData, sizeof(queryData), 0) != S_OK)
-		Sleep(5);
+	cl->context->CSSetConstantBuffers(startSlot, count, dxCbvs);
 }
 
-void CommandList::ReleaseAll()
+void BindComputeCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
 {
-	g_FreeCommandLists.clear();
-}
+	assert(count <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
+
+	ID3D11Buffer* dxCbvs[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	UINT firstConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	UINT numConstants[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+	GetDynamicConstantBuffers(count, cbvs, dxCbvs, firstConstants, numConstants);
+
+	cl->context1->CSSetConstantBuffers1(startSlot, count, dxCbvs, firstConstants, numConstants);
+}
\ No newline at end of file
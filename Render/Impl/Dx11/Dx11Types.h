@@ -1,7 +1,7 @@
 #pragma once
 
 #include "../../RenderTypes.h"
-#include <d3d11.h>
+#include <d3d11_1.h>
 
 #ifdef _MSC_VER
 #pragma comment(lib, "d3d11.lib")
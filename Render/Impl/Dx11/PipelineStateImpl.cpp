@@ -8,18 +8,18 @@ std::vector<Dx11ComputePipelineState> g_computePipelines;
 
 static Dx11GraphicsPipelineState* AllocGraphicsPipeline(GraphicsPipelineState_t pso)
 {
-	if ((size_t)pso >= g_graphicsPipelines.size())
-		g_graphicsPipelines.resize((size_t)pso + 1);
+	if ((uint32_t)pso >= g_graphicsPipelines.size())
+		g_graphicsPipelines.resize((uint32_t)pso + 1);
 
-	return &g_graphicsPipelines[(size_t)pso];
+	return &g_graphicsPipelines[(uint32_t)pso];
 }
 
 static Dx11ComputePipelineState* AllocComputePipeline(ComputePipelineState_t pso)
 {
-	if ((size_t)pso >= g_computePipelines.size())
-		g_computePipelines.resize((size_t)pso + 1);
+	if ((uint32_t)pso >= g_computePipelines.size())
+		g_computePipelines.resize((uint32_t)pso + 1);
 
-	return &g_computePipelines[(size_t)pso];
+	return &g_computePipelines[(uint32_t)pso];
 }
 
 static D3D11_COMPARISON_FUNC GetComparisonFunc(ComparisionFunc f)
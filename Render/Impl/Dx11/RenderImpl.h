@@ -63,7 +63,8 @@ ID3D11Buffer* Dx11_GetVertexBuffer(VertexBuffer_t vb);
 ID3D11Buffer* Dx11_GetIndexBuffer(IndexBuffer_t ib);
 ID3D11Buffer* Dx11_GetStructuredBuffer(StructuredBuffer_t sb);
 ID3D11Buffer* Dx11_GetConstantBuffer(ConstantBuffer_t cb);
-ID3D11Buffer* Dx11_GetDynamicBuffer(DynamicBuffer_t db);
+// Dynamic buffers are ranges of a shared page, offset and size are in bytes.
+ID3D11Buffer* Dx11_GetDynamicBuffer(DynamicBuffer_t db, UINT* offset, UINT* size);
 
 ID3D11ShaderResourceView* Dx11_GetShaderResourceView(ShaderResourceView_t srv);
 ID3D11UnorderedAccessView* Dx11_GetUnorderedAccessView(UnorderedAccessView_t uav);
@@ -22,42 +22,42 @@ std::vector<ComPtr<ID3D11ComputeShader>>	g_computeShaders;
 
 static ComPtr<ID3DBlob>& AllocVertexBlob(VertexShader_t vs)
 {
-	if ((size_t)vs >= g_vertexShaderBlobs.size())
-		g_vertexShaderBlobs.resize((size_t)vs + 1);
+	if ((uint32_t)vs >= g_vertexShaderBlobs.size())
+		g_vertexShaderBlobs.resize((uint32_t)vs + 1);
 
-	return g_vertexShaderBlobs[(size_t)vs];
+	return g_vertexShaderBlobs[(uint32_t)vs];
 }
 
 static ComPtr<ID3D11VertexShader>& AllocVs(VertexShader_t vs)
 {
-	if ((size_t)vs >= g_vertexShaders.size())
-		g_vertexShaders.resize((size_t)vs + 1);
+	if ((uint32_t)vs >= g_vertexShaders.size())
+		g_vertexShaders.resize((uint32_t)vs + 1);
 
-	return g_vertexShaders[(size_t)vs];
+	return g_vertexShaders[(uint32_t)vs];
 }
 
 static ComPtr<ID3D11PixelShader>& AllocPs(PixelShader_t ps)
 {
-	if ((size_t)ps >= g_pixelShaders.size())
-		g_pixelShaders.resize((size_t)ps + 1);
+	if ((uint32_t)ps >= g_pixelShaders.size())
+		g_pixelShaders.resize((uint32_t)ps + 1);
 
-	return g_pixelShaders[(size_t)ps];
+	return g_pixelShaders[(uint32_t)ps];
 }
 
 static ComPtr<ID3D11GeometryShader>& AllocGs(GeometryShader_t gs)
 {
-	if ((size_t)gs >= g_geometryShaders.size())
-		g_geometryShaders.resize((size_t)gs + 1);
+	if ((uint32_t)gs >= g_geometryShaders.size())
+		g_geometryShaders.resize((uint32_t)gs + 1);
 
-	return g_geometryShaders[(size_t)gs];
+	return g_geometryShaders[(uint32_t)gs];
 }
 
 static ComPtr<ID3D11ComputeShader>& AllocCs(ComputeShader_t cs)
 {
-	if ((size_t)cs >= g_computeShaders.size())
-		g_computeShaders.resize((size_t)cs + 1);
+	if ((uint32_t)cs >= g_computeShaders.size())
+		g_computeShaders.resize((uint32_t)cs + 1);
 
-	return g_computeShaders[(size_t)cs];
+	return g_computeShaders[(uint32_t)cs];
 }
 
 bool CompileShader(const char* target, const char* path, const ShaderMacros& macros, ComPtr<ID3DBlob>& shaderBlob)
@@ -163,25 +163,25 @@ bool CompileComputeShader(ComputeShader_t handle, const char* path, const Shader
 
 ID3DBlob* Dx11_GetVertexShaderBlob(VertexShader_t handle)
 {
-	return (size_t)handle > 0 && (size_t)handle < g_vertexShaderBlobs.size() ? g_vertexShaderBlobs[(size_t)handle].Get() : nullptr;
+	return (uint32_t)handle > 0 && (uint32_t)handle < g_vertexShaderBlobs.size() ? g_vertexShaderBlobs[(uint32_t)handle].Get() : nullptr;
 }
 
 ID3D11VertexShader* Dx11_GetVertexShader(VertexShader_t handle)
 {
-	return (size_t)handle > 0 && (size_t)handle < g_vertexShaders.size() ? g_vertexShaders[(size_t)handle].Get() : nullptr;
+	return (uint32_t)handle > 0 && (uint32_t)handle < g_vertexShaders.size() ? g_vertexShaders[(uint32_t)handle].Get() : nullptr;
 }
 
 ID3D11PixelShader* Dx11_GetPixelShader(PixelShader_t handle)
 {
-	return (size_t)handle > 0 && (size_t)handle < g_pixelShaders.size() ? g_pixelShaders[(size_t)handle].Get() : nullptr;
+	return (uint32_t)handle > 0 && (uint32_t)handle < g_pixelShaders.size() ? g_pixelShaders[(uint32_t)handle].Get() : nullptr;
 }
 
 ID3D11GeometryShader* Dx11_GetGeometryShader(GeometryShader_t handle)
 {
-	return (size_t)handle > 0 && (size_t)handle < g_geometryShaders.size() ? g_geometryShaders[(size_t)handle].Get() : nullptr;
+	return (uint32_t)handle > 0 && (uint32_t)handle < g_geometryShaders.size() ? g_geometryShaders[(uint32_t)handle].Get() : nullptr;
 }
 
 ID3D11ComputeShader* Dx11_GetComputeShader(ComputeShader_t handle)
 {
-	return (size_t)handle > 0 && (size_t)handle < g_computeShaders.size() ? g_computeShaders[(size_t)handle].Get() : nullptr;
+	return (uint32_t)handle > 0 && (uint32_t)handle < g_computeShaders.size() ? g_computeShaders[(uint32_t)handle].Get() : nullptr;
 }
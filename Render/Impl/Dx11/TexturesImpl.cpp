@@ -1,15 +1,13 @@
 #include "../TexturesImpl.h"
 
+#include "../../PagedArray.h"
 #include "RenderImpl.h"
 
-std::vector<ComPtr<ID3D11Resource>> g_DxTextures;
+PagedArray<ComPtr<ID3D11Resource>> g_DxTextures;
 
 static ComPtr<ID3D11Resource>& AllocTexture2D(Texture_t tex)
 {
-	if ((size_t)tex >= g_DxTextures.size())
-		g_DxTextures.resize((size_t)tex + 1);
-
-	return g_DxTextures[(size_t)tex];
+	return g_DxTextures.Alloc((uint32_t)tex);
 }
 
 static UINT Dx11_CpuAccessFlag(TextureCPUAccess access)
@@ -119,7 +117,7 @@ bool CreateTextureImpl(Texture_t tex, const TextureCreateDescEx& desc)
 
 bool UpdateTextureImpl(Texture_t tex, const void* const data, uint32_t width, uint32_t height, RenderFormat format)
 {
-	if ((size_t)tex < g_DxTextures.size())
+	if (!Dx11_GetTexture(tex))
 		return false;
 
 	D3D11_TEXTURE2D_DESC td;
@@ -152,7 +150,8 @@ void DestroyTexture(Texture_t tex)
 
 ID3D11Resource* Dx11_GetTexture(Texture_t tex)
 {
-	return (size_t)tex > 0 && (size_t)tex < g_DxTextures.size() ? g_DxTextures[(uint32_t)tex].Get() : nullptr;
+	ComPtr<ID3D11Resource>* res = g_DxTextures.TryGet((uint32_t)tex);
+	return (uint32_t)tex > 0 && res ? res->Get() : nullptr;
 }
 
 TextureResourceAccessScope::TextureResourceAccessScope(Texture_t resource, TextureResourceAccessMethod method, uint32_t subResourceIndex)
@@ -0,0 +1,88 @@
+#include "../BindingImpl.h"
+
+#include "../../PagedArray.h"
+#include "RenderImpl.h"
+#include "../../Textures.h"
+
+PagedArray<bool> g_NullSRVs;
+PagedArray<bool> g_NullUAVs;
+PagedArray<bool> g_NullRTVs;
+PagedArray<bool> g_NullDSVs;
+
+static bool AllocView(PagedArray<bool>& views, size_t index)
+{
+	views.Alloc(index) = true;
+
+	std::lock_guard<std::mutex> lock(g_render.resourceMutex);
+	g_render.counters.viewCreates++;
+
+	return true;
+}
+
+static void DestroyView(PagedArray<bool>& views, size_t index)
+{
+	bool* view = views.TryGet(index);
+	if (view && *view)
+	{
+		*view = false;
+
+		std::lock_guard<std::mutex> lock(g_render.resourceMutex);
+		g_render.counters.viewDestroys++;
+	}
+}
+
+bool CreateTextureSRVImpl(ShaderResourceView_t srv, Texture_t, RenderFormat, TextureDimension, uint32_t, uint32_t, uint32_t, uint32_t)
+{
+	return AllocView(g_NullSRVs, (uint32_t)srv);
+}
+
+bool CreateTextureUAVImpl(UnorderedAccessView_t uav, Texture_t, RenderFormat, uint32_t, uint32_t, uint32_t)
+{
+	return AllocView(g_NullUAVs, (uint32_t)uav);
+}
+
+bool CreateTextureRTVImpl(RenderTargetView_t rtv, Texture_t, RenderFormat, uint32_t, uint32_t, uint32_t)
+{
+	return AllocView(g_NullRTVs, (uint32_t)rtv);
+}
+
+bool CreateTextureDSVImpl(DepthStencilView_t dsv, Texture_t, RenderFormat, uint32_t, uint32_t, uint32_t)
+{
+	return AllocView(g_NullDSVs, (uint32_t)dsv);
+}
+
+bool CreateStructuredBufferSRVImpl(ShaderResourceView_t srv, StructuredBuffer_t buf, uint32_t, uint32_t)
+{
+	if (!Null_GetStructuredBuffer(buf))
+		return false;
+
+	return AllocView(g_NullSRVs, (uint32_t)srv);
+}
+
+bool CreateStructuredBufferUAVImpl(UnorderedAccessView_t uav, StructuredBuffer_t buf, uint32_t, uint32_t)
+{
+	if (!Null_GetStructuredBuffer(buf))
+		return false;
+
+	return AllocView(g_NullUAVs, (uint32_t)uav);
+}
+
+void DestroySRV(ShaderResourceView_t srv)
+{
+	DestroyView(g_NullSRVs, (uint32_t)srv);
+}
+
+void DestroyUAV(UnorderedAccessView_t uav)
+{
+	DestroyView(g_NullUAVs, (uint32_t)uav);
+}
+
+void DestroyRTV(RenderTargetView_t rtv)
+{
+	DestroyView(g_NullRTVs, (uint32_t)rtv);
+}
+
+void DestroyDSV(DepthStencilView_t dsv)
+{
+	DestroyView(g_NullDSVs, (uint32_t)dsv);
+}
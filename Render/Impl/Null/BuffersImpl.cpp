@@ -0,0 +1,179 @@
+#include "../BuffersImpl.h"
+
+#include "../../CommandList.h"
+#include "../../PagedArray.h"
+#include "RenderImpl.h"
+
+#include <cstring>
+#include <vector>
+
+typedef std::vector<uint8_t> NullBuffer;
+
+PagedArray<NullBuffer> g_NullVertexBuffers;
+PagedArray<NullBuffer> g_NullIndexBuffers;
+PagedArray<NullBuffer> g_NullStructuredBuffers;
+PagedArray<NullBuffer> g_NullConstantBuffers;
+
+// State of each structured buffer, see Null_TransitionBuffer.
+PagedArray<ResourceState> g_NullStructuredBufferStates;
+
+// Fixed size so pages created while command lists are recorded on worker threads never move.
+NullBuffer g_NullDynamicBufferPages[kMaxDynamicBufferPages];
+
+static NullBuffer& AllocBuffer(PagedArray<NullBuffer>& buffers, size_t index)
+{
+	return buffers.Alloc(index);
+}
+
+static bool CreateBuffer(const void* const data, size_t size, NullBuffer& buffer)
+{
+	buffer.resize(size);
+
+	if (data)
+		memcpy(buffer.data(), data, size);
+
+	std::lock_guard<std::mutex> lock(g_render.resourceMutex);
+	g_render.counters.bufferCreates++;
+
+	return true;
+}
+
+static void CopyToBuffer(NullBuffer& buffer, const void* const data, size_t size)
+{
+	assert(size <= buffer.size());
+	memcpy(buffer.data(), data, size);
+}
+
+static void DestroyBuffer(PagedArray<NullBuffer>& buffers, size_t index)
+{
+	NullBuffer().swap(buffers[index]);
+
+	std::lock_guard<std::mutex> lock(g_render.resourceMutex);
+	g_render.counters.bufferDestroys++;
+}
+
+static const NullBuffer* GetBuffer(const PagedArray<NullBuffer>& buffers, size_t index)
+{
+	return index > 0 ? buffers.TryGet(index) : nullptr;
+}
+
+bool CreateVertexBufferImpl(VertexBuffer_t handle, const void* const data, size_t size)
+{
+	return CreateBuffer(data, size, AllocBuffer(g_NullVertexBuffers, (uint32_t)handle));
+}
+
+bool CreateIndexBufferImpl(IndexBuffer_t handle, const void* const data, size_t size)
+{
+	return CreateBuffer(data, size, AllocBuffer(g_NullIndexBuffers, (uint32_t)handle));
+}
+
+bool CreateStructuredBufferImpl(StructuredBuffer_t handle, const void* const data, size_t size, size_t, RenderResourceFlags)
+{
+	g_NullStructuredBufferStates.Alloc((uint32_t)handle) = ResourceState::Common;
+
+	return CreateBuffer(data, size, AllocBuffer(g_NullStructuredBuffers, (uint32_t)handle));
+}
+
+bool CreateConstantBufferImpl(ConstantBuffer_t handle, const void* const data, size_t size)
+{
+	return CreateBuffer(data, size, AllocBuffer(g_NullConstantBuffers, (uint32_t)handle));
+}
+
+void UpdateVertexBufferImpl(VertexBuffer_t vb, const void* const data, size_t size)
+{
+	CopyToBuffer(g_NullVertexBuffers[(uint32_t)vb], data, size);
+}
+
+void UpdateIndexBufferImpl(IndexBuffer_t ib, const void* const data, size_t size)
+{
+	CopyToBuffer(g_NullIndexBuffers[(uint32_t)ib], data, size);
+}
+
+void UpdateConstantBufferImpl(ConstantBuffer_t cb, const void* const data, size_t size)
+{
+	CopyToBuffer(g_NullConstantBuffers[(uint32_t)cb], data, size);
+}
+
+void DestroyVertexBuffer(VertexBuffer_t handle)
+{
+	DestroyBuffer(g_NullVertexBuffers, (uint32_t)handle);
+}
+
+void DestroyIndexBuffer(IndexBuffer_t handle)
+{
+	DestroyBuffer(g_NullIndexBuffers, (uint32_t)handle);
+}
+
+void DestroyStructuredBuffer(StructuredBuffer_t handle)
+{
+	DestroyBuffer(g_NullStructuredBuffers, (uint32_t)handle);
+}
+
+void DestroyConstantBuffer(ConstantBuffer_t handle)
+{
+	DestroyBuffer(g_NullConstantBuffers, (uint32_t)handle);
+}
+
+const NullBuffer* Null_GetVertexBuffer(VertexBuffer_t vb)
+{
+	return GetBuffer(g_NullVertexBuffers, (uint32_t)vb);
+}
+
+const NullBuffer* Null_GetIndexBuffer(IndexBuffer_t ib)
+{
+	return GetBuffer(g_NullIndexBuffers, (uint32_t)ib);
+}
+
+const NullBuffer* Null_GetStructuredBuffer(StructuredBuffer_t sb)
+{
+	return GetBuffer(g_NullStructuredBuffers, (uint32_t)sb);
+}
+
+const NullBuffer* Null_GetConstantBuffer(ConstantBuffer_t cb)
+{
+	return GetBuffer(g_NullConstantBuffers, (uint32_t)cb);
+}
+
+const uint8_t* Null_GetDynamicBufferData(DynamicBuffer_t db)
+{
+	if (db == DynamicBuffer_t::INVALID)
+		return nullptr;
+
+	const DynamicBufferAllocation alloc = DynamicBuffers_Decode(db);
+	return g_NullDynamicBufferPages[alloc.page].data() + alloc.offset;
+}
+
+bool CreateDynamicBufferPageImpl(uint32_t page, DynamicBufferPageType, size_t size)
+{
+	g_NullDynamicBufferPages[page].resize(size);
+
+	g_render.counters.dynamicBufferPageCreates++;
+
+	return true;
+}
+
+void UploadDynamicBufferPageImpl(uint32_t page, const uint8_t* const data, size_t begin, size_t end)
+{
+	memcpy(g_NullDynamicBufferPages[page].data() + begin, data + begin, end - begin);
+
+	g_render.counters.dynamicBufferUploads++;
+	g_render.counters.dynamicBufferUploadBytes += end - begin;
+}
+
+bool Null_TransitionBuffer(const ResourceBarrier& barrier)
+{
+	ResourceState* state = (uint32_t)barrier.buffer > 0 ? g_NullStructuredBufferStates.TryGet((uint32_t)barrier.buffer) : nullptr;
+	if (!state || (barrier.subresource != kAllSubresources && barrier.subresource != 0))
+		return false;
+
+	const bool valid = *state == barrier.before;
+	*state = barrier.after;
+
+	return valid;
+}
+
+ResourceState Null_GetBufferState(StructuredBuffer_t sb)
+{
+	const ResourceState* state = (uint32_t)sb > 0 ? g_NullStructuredBufferStates.TryGet((uint32_t)sb) : nullptr;
+	return state ? *state : ResourceState::Common;
+}
@@ -0,0 +1,285 @@
+#include "../CommandListImpl.h"
+
+#include "RenderImpl.h"
+
+#include <vector>
+
+struct CommandListImpl
+{
+	size_t numCommands = 0;
+	size_t numDraws = 0;
+	size_t numDispatches = 0;
+	size_t numClears = 0;
+	size_t numBarrierBatches = 0;
+
+	// Validated against the texture states when the list executes, lists can be recorded out of order.
+	std::vector<ResourceBarrier> barriers;
+
+	// Bind calls while g_render.captureBinds is set, appended to the captured binds when the list executes.
+	CommandStream binds;
+};
+
+template<typename T>
+static void CaptureBinds(CommandListImpl* cl, CommandOp op, uint32_t startSlot, uint32_t count, const T* const values)
+{
+	cl->numCommands++;
+
+	if (!g_render.captureBinds)
+		return;
+
+	cl->binds.Begin(op, sizeof(uint32_t) * 2 + sizeof(T) * count);
+	cl->binds.Write(startSlot);
+	cl->binds.Write(count);
+	cl->binds.Write(values, count);
+}
+
+template<typename T>
+static void CaptureVertexBuffers(CommandListImpl* cl, CommandOp op, uint32_t startSlot, uint32_t count, const T* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
+{
+	cl->numCommands++;
+
+	if (!g_render.captureBinds)
+		return;
+
+	cl->binds.Begin(op, sizeof(uint32_t) * 2 + (sizeof(T) + sizeof(uint32_t) * 2) * count);
+	cl->binds.Write(startSlot);
+	cl->binds.Write(count);
+	cl->binds.Write(vbs, count);
+	cl->binds.Write(strides, count);
+	cl->binds.Write(offsets, count);
+}
+
+CommandListImpl* CreateCommandListImpl()
+{
+	g_render.counters.commandListCreates++;
+
+	return new CommandListImpl;
+}
+
+void DestroyCommandListImpl(CommandListImpl* cl)
+{
+	delete cl;
+}
+
+void BeginCommandListImpl(CommandListImpl* cl)
+{
+	cl->numCommands = 0;
+	cl->numDraws = 0;
+	cl->numDispatches = 0;
+	cl->numClears = 0;
+	cl->numBarrierBatches = 0;
+
+	cl->barriers.clear();
+	cl->binds.Reset();
+}
+
+void FinishCommandListImpl(CommandListImpl* cl)
+{
+	g_render.counters.commands += cl->numCommands;
+	g_render.counters.draws += cl->numDraws;
+	g_render.counters.dispatches += cl->numDispatches;
+	g_render.counters.clears += cl->numClears;
+	g_render.counters.barriers += cl->barriers.size();
+	g_render.counters.barrierBatches += cl->numBarrierBatches;
+}
+
+void ExecuteCommandListImpl(CommandListImpl* cl)
+{
+	g_render.counters.commandListExecutes++;
+
+	for (const ResourceBarrier& barrier : cl->barriers)
+	{
+		const bool valid = barrier.texture != Texture_t{} ? Null_TransitionTexture(barrier) : Null_TransitionBuffer(barrier);
+		if (!valid)
+			g_render.counters.invalidBarriers++;
+	}
+
+	if (g_render.captureBinds)
+	{
+		CommandStreamReader reader(cl->binds);
+		CommandHeader header;
+
+		while (reader.Next(header))
+		{
+			g_render.capturedBinds.Begin(header.op, header.payloadSize);
+			g_render.capturedBinds.Write(reader.Payload(), header.payloadSize);
+			reader.Skip(header.payloadSize);
+		}
+	}
+}
+
+void ExecuteAndStallCommandListImpl(CommandListImpl* cl)
+{
+	ExecuteCommandListImpl(cl);
+}
+
+void ClearRenderTargetImpl(CommandListImpl* cl, RenderTargetView_t, const float[4])
+{
+	cl->numCommands++;
+	cl->numClears++;
+}
+
+void ClearDepthImpl(CommandListImpl* cl, DepthStencilView_t, float)
+{
+	cl->numCommands++;
+	cl->numClears++;
+}
+
+void ClearUnorderedAccessViewImpl(CommandListImpl* cl, UnorderedAccessView_t, const float[4])
+{
+	cl->numCommands++;
+	cl->numClears++;
+}
+
+void ClearUnorderedAccessViewImpl(CommandListImpl* cl, UnorderedAccessView_t, const uint32_t[4])
+{
+	cl->numCommands++;
+	cl->numClears++;
+}
+
+void SetRenderTargetsImpl(CommandListImpl* cl, const RenderTargetView_t* const, [[maybe_unused]] size_t num, DepthStencilView_t)
+{
+	assert(num <= 8);
+
+	cl->numCommands++;
+}
+
+void SetViewportsImpl(CommandListImpl* cl, const Viewport* const, [[maybe_unused]] size_t num)
+{
+	assert(num <= 8);
+
+	cl->numCommands++;
+}
+
+void SetDefaultScissorImpl(CommandListImpl* cl)
+{
+	cl->numCommands++;
+}
+
+void SetScissorsImpl(CommandListImpl* cl, const ScissorRect* const, [[maybe_unused]] size_t num)
+{
+	assert(num <= 8);
+
+	cl->numCommands++;
+}
+
+void SetGraphicsPipelineStateImpl(CommandListImpl* cl, GraphicsPipelineState_t)
+{
+	cl->numCommands++;
+}
+
+void SetComputePipelineStateImpl(CommandListImpl* cl, ComputePipelineState_t)
+{
+	cl->numCommands++;
+}
+
+void SetVertexBuffersImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const VertexBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
+{
+	CaptureVertexBuffers(cl, CommandOp::SetVertexBuffers, startSlot, count, vbs, strides, offsets);
+}
+
+void SetVertexBuffersImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const vbs, const uint32_t* const strides, const uint32_t* const offsets)
+{
+	CaptureVertexBuffers(cl, CommandOp::SetDynamicVertexBuffers, startSlot, count, vbs, strides, offsets);
+}
+
+void SetIndexBufferImpl(CommandListImpl* cl, IndexBuffer_t, RenderFormat, uint32_t)
+{
+	cl->numCommands++;
+}
+
+void SetIndexBufferImpl(CommandListImpl* cl, DynamicBuffer_t, RenderFormat, uint32_t)
+{
+	cl->numCommands++;
+}
+
+void CopyTextureImpl(CommandListImpl* cl, Texture_t, Texture_t)
+{
+	cl->numCommands++;
+}
+
+void ResourceBarriersImpl(CommandListImpl* cl, const ResourceBarrier* const barriers, size_t num)
+{
+	cl->numCommands++;
+	cl->numBarrierBatches++;
+	cl->barriers.insert(cl->barriers.end(), barriers, barriers + num);
+}
+
+void DrawIndexedInstancedImpl(CommandListImpl* cl, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t)
+{
+	cl->numCommands++;
+	cl->numDraws++;
+}
+
+void DrawInstancedImpl(CommandListImpl* cl, uint32_t, uint32_t, uint32_t, uint32_t)
+{
+	cl->numCommands++;
+	cl->numDraws++;
+}
+
+void DispatchImpl(CommandListImpl* cl, uint32_t, uint32_t, uint32_t)
+{
+	cl->numCommands++;
+	cl->numDispatches++;
+}
+
+// Dx11 Style Bind Commands
+void BindVertexSRVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs)
+{
+	CaptureBinds(cl, CommandOp::BindVertexSRVs, startSlot, count, srvs);
+}
+
+void BindVertexCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
+{
+	CaptureBinds(cl, CommandOp::BindVertexCBVs, startSlot, count, cbvs);
+}
+
+void BindVertexCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
+{
+	CaptureBinds(cl, CommandOp::BindVertexDynamicCBVs, startSlot, count, cbvs);
+}
+
+void BindGeometryCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
+{
+	CaptureBinds(cl, CommandOp::BindGeometryCBVs, startSlot, count, cbvs);
+}
+
+void BindGeometryCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
+{
+	CaptureBinds(cl, CommandOp::BindGeometryDynamicCBVs, startSlot, count, cbvs);
+}
+
+void BindPixelSRVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs)
+{
+	CaptureBinds(cl, CommandOp::BindPixelSRVs, startSlot, count, srvs);
+}
+
+void BindPixelCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
+{
+	CaptureBinds(cl, CommandOp::BindPixelCBVs, startSlot, count, cbvs);
+}
+
+void BindPixelCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
+{
+	CaptureBinds(cl, CommandOp::BindPixelDynamicCBVs, startSlot, count, cbvs);
+}
+
+void BindComputeSRVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ShaderResourceView_t* const srvs)
+{
+	CaptureBinds(cl, CommandOp::BindComputeSRVs, startSlot, count, srvs);
+}
+
+void BindComputeUAVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const UnorderedAccessView_t* const uavs)
+{
+	CaptureBinds(cl, CommandOp::BindComputeUAVs, startSlot, count, uavs);
+}
+
+void BindComputeCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const ConstantBuffer_t* const cbvs)
+{
+	CaptureBinds(cl, CommandOp::BindComputeCBVs, startSlot, count, cbvs);
+}
+
+void BindComputeCBVsImpl(CommandListImpl* cl, uint32_t startSlot, uint32_t count, const DynamicBuffer_t* const cbvs)
+{
+	CaptureBinds(cl, CommandOp::BindComputeDynamicCBVs, startSlot, count, cbvs);
+}
@@ -0,0 +1,28 @@
+#include "../PipelineStateImpl.h"
+
+#include "RenderImpl.h"
+
+bool CompileGraphicsPipelineState(GraphicsPipelineState_t, const GraphicsPipelineStateDesc&, const InputElementDesc*, size_t)
+{
+	g_render.counters.pipelineCompiles++;
+
+	return true;
+}
+
+bool CompileComputePipelineState(ComputePipelineState_t, const ComputePipelineStateDesc& desc)
+{
+	if (desc.cs == ComputeShader_t::INVALID)
+		return false;
+
+	g_render.counters.pipelineCompiles++;
+
+	return true;
+}
+
+void DestroyGraphicsPipelineState(GraphicsPipelineState_t)
+{
+}
+
+void DestroyComputePipelineState(ComputePipelineState_t)
+{
+}
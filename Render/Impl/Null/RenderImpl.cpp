@@ -0,0 +1,56 @@
+#include "RenderImpl.h"
+#include "../../Render.h"
+#include "../../Buffers.h"
+
+NullRenderGlobals g_render;
+
+bool Render_Init()
+{
+	g_render.initialised = true;
+
+	return true;
+}
+
+bool Render_Initialised()
+{
+	return g_render.initialised;
+}
+
+void Render_NewFrame()
+{
+	DynamicBuffers_NewFrame();
+}
+
+void Render_ShutDown()
+{
+	g_render.initialised = false;
+}
+
+void Render_PushDebugWarningDisable(RenderDebugWarnings)
+{
+}
+
+void Render_PopDebugWarningDisable()
+{
+}
+
+const NullRenderCounters& Null_GetCounters()
+{
+	return g_render.counters;
+}
+
+void Null_ResetCounters()
+{
+	g_render.counters = {};
+}
+
+void Null_SetBindCapture(bool enabled)
+{
+	g_render.captureBinds = enabled;
+	g_render.capturedBinds.Reset();
+}
+
+const CommandStream& Null_GetCapturedBinds()
+{
+	return g_render.capturedBinds;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../../CommandStream.h"
+#include "../../RenderTypes.h"
+
+#include <mutex>
+
+// The null backend implements every Impl entry point with plain memory and no device, so the
+// CPU side of the renderer can be run and profiled on headless machines.
+
+FWD_RENDER_TYPE(VertexBuffer_t);
+FWD_RENDER_TYPE(IndexBuffer_t);
+FWD_RENDER_TYPE(StructuredBuffer_t);
+FWD_RENDER_TYPE(ConstantBuffer_t);
+FWD_RENDER_TYPE(DynamicBuffer_t);
+
+FWD_RENDER_TYPE(Texture_t);
+
+struct ResourceBarrier;
+
+struct NullRenderCounters
+{
+	size_t bufferCreates = 0;
+	size_t bufferDestroys = 0;
+	size_t textureCreates = 0;
+	size_t textureDestroys = 0;
+	size_t viewCreates = 0;
+	size_t viewDestroys = 0;
+	size_t shaderCompiles = 0;
+	size_t pipelineCompiles = 0;
+	size_t dynamicBufferPageCreates = 0;
+	size_t dynamicBufferUploads = 0;
+	size_t dynamicBufferUploadBytes = 0;
+	size_t commandListCreates = 0;
+	size_t commandListExecutes = 0;
+	size_t commands = 0;
+	size_t draws = 0;
+	size_t dispatches = 0;
+	size_t clears = 0;
+	size_t barriers = 0;
+	size_t barrierBatches = 0;
+
+	// Barriers whose before state didn't match the texture when executed, or named a dead texture.
+	size_t invalidBarriers = 0;
+};
+
+struct NullRenderGlobals
+{
+	bool initialised = false;
+	NullRenderCounters counters;
+
+	// Resources can be created and destroyed from loader threads, guards the counters and texture memory.
+	std::mutex resourceMutex;
+
+	bool captureBinds = false;
+	CommandStream capturedBinds;
+};
+
+extern NullRenderGlobals g_render;
+
+const NullRenderCounters& Null_GetCounters();
+void Null_ResetCounters();
+
+// Records the bind calls of command lists executed while enabled, in the layout CommandList records
+// them in a CommandStream, so what a list recorded can be compared with what the backend received.
+// Enabling capture clears the captured binds.
+void Null_SetBindCapture(bool enabled);
+const CommandStream& Null_GetCapturedBinds();
+
+const std::vector<uint8_t>* Null_GetVertexBuffer(VertexBuffer_t vb);
+const std::vector<uint8_t>* Null_GetIndexBuffer(IndexBuffer_t ib);
+const std::vector<uint8_t>* Null_GetStructuredBuffer(StructuredBuffer_t sb);
+const std::vector<uint8_t>* Null_GetConstantBuffer(ConstantBuffer_t cb);
+
+// Returns the uploaded contents of a dynamic buffer, valid once the command list binding it has executed.
+const uint8_t* Null_GetDynamicBufferData(DynamicBuffer_t db);
+
+bool Null_IsTextureAlive(Texture_t tex);
+size_t Null_GetTextureMemory();
+
+// Applies a barrier to the tracked state of the texture subresources, returns false if the barrier
+// is invalid. Textures are created in ResourceState::Common.
+bool Null_TransitionTexture(const ResourceBarrier& barrier);
+ResourceState Null_GetTextureState(Texture_t tex, uint32_t subresource);
+
+// As Null_TransitionTexture, for the structured buffer of a barrier.
+bool Null_TransitionBuffer(const ResourceBarrier& barrier);
+ResourceState Null_GetBufferState(StructuredBuffer_t sb);
@@ -0,0 +1,15 @@
+#include "../../Samplers.h"
+
+#include "RenderImpl.h"
+
+std::vector<SamplerDesc> g_NullSamplers;
+
+void InitSamplers(const SamplerDesc* const descs, size_t count)
+{
+	g_NullSamplers.assign(descs, descs + count);
+}
+
+size_t Samplers_GetSamplerCount()
+{
+	return g_NullSamplers.size();
+}
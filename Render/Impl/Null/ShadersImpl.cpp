@@ -0,0 +1,32 @@
+#include "../ShadersImpl.h"
+
+#include "RenderImpl.h"
+
+// Shaders are never compiled on the null backend, the handles only need to be valid.
+
+static bool CompileShader(const char* path)
+{
+	g_render.counters.shaderCompiles++;
+
+	return path != nullptr;
+}
+
+bool CompileVertexShader(VertexShader_t, const char* path, const ShaderMacros&)
+{
+	return CompileShader(path);
+}
+
+bool CompilePixelShader(PixelShader_t, const char* path, const ShaderMacros&)
+{
+	return CompileShader(path);
+}
+
+bool CompileGeometryShader(GeometryShader_t, const char* path, const ShaderMacros&)
+{
+	return CompileShader(path);
+}
+
+bool CompileComputeShader(ComputeShader_t, const char* path, const ShaderMacros&)
+{
+	return CompileShader(path);
+}
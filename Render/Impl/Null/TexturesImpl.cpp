@@ -0,0 +1,169 @@
+#include "../TexturesImpl.h"
+
+#include "../../CommandList.h"
+#include "../../PagedArray.h"
+#include "RenderImpl.h"
+
+#include <cstring>
+
+struct NullTexture
+{
+	bool alive = false;
+	TextureCreateDescEx desc;
+	size_t size = 0;
+
+	// Backing memory is only allocated when a subresource is mapped.
+	std::vector<std::vector<uint8_t>> subResources;
+
+	std::vector<ResourceState> states;
+};
+
+PagedArray<NullTexture> g_NullTextures;
+size_t g_NullTextureMemory = 0;
+
+static NullTexture& AllocTexture(Texture_t tex)
+{
+	return g_NullTextures.Alloc((uint32_t)tex);
+}
+
+static void GetSubResourceInfo(const TextureCreateDescEx& desc, uint32_t subResourceIndex, size_t* numBytes, size_t* rowBytes)
+{
+	const uint32_t mip = subResourceIndex % (desc.mipCount > 0 ? desc.mipCount : 1);
+
+	const uint32_t width = desc.width >> mip > 0 ? desc.width >> mip : 1;
+	const uint32_t height = desc.height >> mip > 0 ? desc.height >> mip : 1;
+
+	Textures_GetSurfaceInfo(width, height, desc.resourceFormat, numBytes, rowBytes);
+
+	*numBytes *= desc.dimension == TextureDimension::Tex3D ? desc.depth : 1;
+}
+
+bool CreateTextureImpl(Texture_t tex, const TextureCreateDescEx& desc)
+{
+	if (desc.dimension == TextureDimension::Unknown || desc.resourceFormat == RenderFormat::UNKNOWN)
+		return false;
+
+	NullTexture& nullTex = AllocTexture(tex);
+
+	nullTex.alive = true;
+	nullTex.desc = desc;
+	nullTex.desc.data = nullptr;
+	nullTex.size = 0;
+	nullTex.subResources.clear();
+
+	const uint32_t subResourceCount = desc.mipCount * desc.arraySize;
+	nullTex.states.assign(subResourceCount, ResourceState::Common);
+
+	for (uint32_t i = 0; i < subResourceCount; i++)
+	{
+		size_t numBytes = 0;
+		size_t rowBytes = 0;
+		GetSubResourceInfo(desc, i, &numBytes, &rowBytes);
+		nullTex.size += numBytes;
+	}
+
+	std::lock_guard<std::mutex> lock(g_render.resourceMutex);
+	g_NullTextureMemory += nullTex.size;
+	g_render.counters.textureCreates++;
+
+	return true;
+}
+
+bool UpdateTextureImpl(Texture_t tex, const void* const, uint32_t, uint32_t, RenderFormat)
+{
+	return Null_IsTextureAlive(tex);
+}
+
+void DestroyTexture(Texture_t tex)
+{
+	if (!Null_IsTextureAlive(tex))
+		return;
+
+	NullTexture& nullTex = g_NullTextures[(uint32_t)tex];
+
+	{
+		std::lock_guard<std::mutex> lock(g_render.resourceMutex);
+		g_NullTextureMemory -= nullTex.size;
+		g_render.counters.textureDestroys++;
+	}
+
+	nullTex = {};
+}
+
+bool Null_IsTextureAlive(Texture_t tex)
+{
+	const NullTexture* nullTex = g_NullTextures.TryGet((uint32_t)tex);
+	return (uint32_t)tex > 0 && nullTex && nullTex->alive;
+}
+
+size_t Null_GetTextureMemory()
+{
+	return g_NullTextureMemory;
+}
+
+bool Null_TransitionTexture(const ResourceBarrier& barrier)
+{
+	if (!Null_IsTextureAlive(barrier.texture))
+		return false;
+
+	std::vector<ResourceState>& states = g_NullTextures[(uint32_t)barrier.texture].states;
+
+	if (barrier.subresource == kAllSubresources)
+	{
+		bool valid = true;
+		for (ResourceState& state : states)
+		{
+			valid &= state == barrier.before;
+			state = barrier.after;
+		}
+
+		return valid;
+	}
+
+	if (barrier.subresource >= states.size())
+		return false;
+
+	const bool valid = states[barrier.subresource] == barrier.before;
+	states[barrier.subresource] = barrier.after;
+
+	return valid;
+}
+
+ResourceState Null_GetTextureState(Texture_t tex, uint32_t subresource)
+{
+	if (!Null_IsTextureAlive(tex) || subresource >= g_NullTextures[(uint32_t)tex].states.size())
+		return ResourceState::Common;
+
+	return g_NullTextures[(uint32_t)tex].states[subresource];
+}
+
+TextureResourceAccessScope::TextureResourceAccessScope(Texture_t resource, TextureResourceAccessMethod, uint32_t subResourceIndex)
+	: mappedTex(resource)
+	, subResIdx(subResourceIndex)
+{
+	if (!Null_IsTextureAlive(mappedTex))
+		return;
+
+	NullTexture& nullTex = g_NullTextures[(uint32_t)mappedTex];
+
+	if (subResourceIndex >= nullTex.desc.mipCount * nullTex.desc.arraySize)
+		return;
+
+	size_t numBytes = 0;
+	size_t rowBytes = 0;
+	GetSubResourceInfo(nullTex.desc, subResourceIndex, &numBytes, &rowBytes);
+
+	if (nullTex.subResources.size() <= subResourceIndex)
+		nullTex.subResources.resize(subResourceIndex + 1);
+
+	std::vector<uint8_t>& mem = nullTex.subResources[subResourceIndex];
+	mem.resize(numBytes);
+
+	ptr = mem.data();
+	rowPitch = rowBytes;
+	depthPitch = numBytes;
+}
+
+TextureResourceAccessScope::~TextureResourceAccessScope()
+{
+}
@@ -0,0 +1,93 @@
+#include "../../View.h"
+
+#include "RenderImpl.h"
+
+#include "../../Binding.h"
+#include "../../CommandList.h"
+
+#include <map>
+
+std::map<intptr_t, RenderView*> g_views;
+
+// There is no swap chain on the null backend, the back buffer is an RTV with no resource behind it.
+struct RenderViewImpl
+{
+	RenderTargetView_t RTV = RenderTargetView_t::INVALID;
+	uint32_t frameId = 0;
+};
+
+RenderView::RenderView()
+	: impl(std::make_unique<RenderViewImpl>())
+{
+}
+
+RenderView::~RenderView()
+{
+	Render_Release(impl->RTV);
+	g_views.erase(hwnd);
+}
+
+void RenderView::Resize(uint32_t x, uint32_t y)
+{
+	x = x > 0 ? x : 1;
+	y = y > 0 ? y : 1;
+
+	if (width == x && height == y)
+		return;
+
+	width = x;
+	height = y;
+
+	ReleaseRTV(impl->RTV);
+
+	CommandList::ReleaseAll();
+
+	impl->RTV = AllocTextureRTV(BackBufferFormat, 1);
+}
+
+void RenderView::Present(bool)
+{
+	impl->frameId++;
+}
+
+RenderViewPtr CreateRenderViewPtr(intptr_t hwnd)
+{
+	return std::shared_ptr<RenderView>(CreateRenderView(hwnd));
+}
+
+RenderView* CreateRenderView(intptr_t hwnd)
+{
+	RenderView* rv = new RenderView;
+
+	rv->hwnd = hwnd;
+
+	g_views[hwnd] = rv;
+
+	return rv;
+}
+
+RenderView* GetRenderViewForHwnd(intptr_t hwnd)
+{
+	auto iter = g_views.find(hwnd);
+	return iter != g_views.end() ? iter->second : nullptr;
+}
+
+void RenderView::ClearCurrentBackBufferTarget(CommandList* cl)
+{
+	constexpr float DefaultClearCol[4] = { 0.0f, 0.0f, 0.2f, 0.0f };
+	ClearCurrentBackBufferTarget(cl, DefaultClearCol);
+}
+
+void RenderView::ClearCurrentBackBufferTarget(CommandList* cl, const float clearCol[4])
+{
+	RenderTargetView_t rtv = GetCurrentBackBufferRTV();
+	if (rtv != RenderTargetView_t::INVALID)
+	{
+		cl->ClearRenderTarget(rtv, clearCol);
+	}
+}
+
+RenderTargetView_t RenderView::GetCurrentBackBufferRTV()
+{
+	return impl->RTV;
+}
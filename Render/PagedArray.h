@@ -0,0 +1,93 @@
+#pragma once
+
+#include <assert.h>
+#include <atomic>
+#include <cstddef>
+
+// Array of fixed size pages which never moves its elements. Growing only allocates the missing
+// page, so references into the array stay valid and readers can index it while another thread
+// grows it. Elements of a new page are value initialised.
+// The page table is fixed, so the array holds at most PageSize * MaxPages elements, 262,144 with
+// the defaults. Indices past that are refused by TryAlloc.
+template<typename T, size_t PageSize = 256, size_t MaxPages = 1024>
+struct PagedArray
+{
+	static constexpr size_t kPageSize = PageSize;
+	static constexpr size_t kMaxPages = MaxPages;
+	static constexpr size_t kMaxSize = PageSize * MaxPages;
+
+	PagedArray() = default;
+	PagedArray(const PagedArray&) = delete;
+	PagedArray& operator=(const PagedArray&) = delete;
+
+	~PagedArray()
+	{
+		for (std::atomic<T*>& page : Pages)
+			delete[] page.load(std::memory_order_relaxed);
+	}
+
+	// Returns the element at index, allocating its page if needed. Safe to call from multiple threads.
+	// Returns nullptr if index is past kMaxSize.
+	T* TryAlloc(size_t index)
+	{
+		const size_t pageIndex = index / PageSize;
+		if (pageIndex >= MaxPages)
+			return nullptr;
+
+		T* page = Pages[pageIndex].load(std::memory_order_acquire);
+		if (!page)
+		{
+			T* newPage = new T[PageSize]();
+			if (Pages[pageIndex].compare_exchange_strong(page, newPage, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				page = newPage;
+				PageCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				delete[] newPage;
+			}
+		}
+
+		return &page[index % PageSize];
+	}
+
+	// As TryAlloc, for indices the caller has already checked against kMaxSize.
+	T& Alloc(size_t index)
+	{
+		T* element = TryAlloc(index);
+		assert(element && "PagedArray::Alloc index out of range");
+		return *element;
+	}
+
+	// Returns nullptr if the page holding index has not been allocated.
+	T* TryGet(size_t index) const noexcept
+	{
+		const size_t pageIndex = index / PageSize;
+		if (pageIndex >= MaxPages)
+			return nullptr;
+
+		T* page = Pages[pageIndex].load(std::memory_order_acquire);
+		return page ? &page[index % PageSize] : nullptr;
+	}
+
+	T& operator[](size_t index) noexcept
+	{
+		return Pages[index / PageSize].load(std::memory_order_acquire)[index % PageSize];
+	}
+
+	const T& operator[](size_t index) const noexcept
+	{
+		return Pages[index / PageSize].load(std::memory_order_acquire)[index % PageSize];
+	}
+
+	size_t GetPageCount() const noexcept { return PageCount.load(std::memory_order_relaxed); }
+	size_t GetCapacity() const noexcept { return GetPageCount() * PageSize; }
+
+	// Bytes held by allocated pages and the page table, not counting memory owned by the elements.
+	size_t GetMemoryUsage() const noexcept { return GetCapacity() * sizeof(T) + sizeof(Pages); }
+
+private:
+	std::atomic<T*> Pages[MaxPages] = {};
+	std::atomic<size_t> PageCount{0};
+};
@@ -2,6 +2,8 @@
 #include "Impl/PipelineStateImpl.h"
 #include "IDArray.h"
 
+#include <cstring>
+
 struct GraphicsPipelineStateData
 {
     GraphicsPipelineStateDesc desc;
@@ -73,3 +75,9 @@ size_t PipelineStates_GetComputePipelineStateCount()
 {
     return g_ComputePipelineStates.UsedSize();
 }
+
+void PipelineStates_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports)
+{
+    reports.push_back(g_GraphicsPipelineStates.GetMemoryReport("Graphics Pipelines"));
+    reports.push_back(g_ComputePipelineStates.GetMemoryReport("Compute Pipelines"));
+}
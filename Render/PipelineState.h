@@ -147,4 +147,6 @@ void Render_Release(GraphicsPipelineState_t pso);
 void Render_Release(ComputePipelineState_t pso);
 
 size_t PipelineStates_GetGraphicsPipelineStateCount();
-size_t PipelineStates_GetComputePipelineStateCount();
\ No newline at end of file
+size_t PipelineStates_GetComputePipelineStateCount();
+
+void PipelineStates_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports);
\ No newline at end of file
@@ -13,6 +13,11 @@
 #include "Textures.h"
 #include "View.h"
 
+// The backend is chosen at build time by compiling the sources from one of the Impl folders:
+//   Impl/Dx11 - D3D11 device, Windows only.
+//   Impl/Null - No device, resources are plain memory. Used to run and profile the CPU side of
+//               the renderer on headless machines.
+
 #define RENDER_DEBUG 1
 bool Render_Init();
 bool Render_Initialised();
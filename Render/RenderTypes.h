@@ -7,10 +7,12 @@
 #include <string>
 #include <vector>
 
+#ifdef _WIN32
 #include <wrl.h>
 
 template<typename T>
 using ComPtr = Microsoft::WRL::ComPtr<T>;
+#endif
 
 #define RENDER_TYPE(t) enum class t : uint64_t {INVALID}
 #define FWD_RENDER_TYPE(t) enum class t : uint64_t
@@ -201,8 +203,30 @@ enum class RenderResourceFlags : uint8_t
 };
 IMPLEMENT_FLAGS(RenderResourceFlags, uint8_t)
 
+// States a texture can be accessed in, see CommandList::ResourceBarriers.
+enum class ResourceState : uint8_t
+{
+    Common,
+    ShaderResource,
+    RenderTarget,
+    DepthWrite,
+    UnorderedAccess,
+    CopySource,
+    CopyDest,
+};
+
 enum class ResourceUsage : uint8_t
 {
     Default,
     Staging,
+};
+
+// Memory held by one of the renderer's resource tables. Bytes covers the table's own storage, not
+// heap memory owned by the entries.
+struct ResourceTableMemoryReport
+{
+    const char* name = nullptr;
+    size_t used = 0;
+    size_t capacity = 0;
+    size_t bytes = 0;
 };
\ No newline at end of file
@@ -123,45 +123,57 @@ void ReloadShaders()
 {
 	for (size_t i = 0; i < g_VertexShaders.Size(); i++)
 	{
-		if (ShaderData* data = g_VertexShaders.Get((VertexShader_t)i))
+		const VertexShader_t shader = g_VertexShaders.GetID(i);
+		if (ShaderData* data = g_VertexShaders.Get(shader))
 		{
 			if (!data->compiled)
 				continue;
 
-			CompileVertexShader((VertexShader_t)i, data->path.c_str(), data->macros);				
+			CompileVertexShader(shader, data->path.c_str(), data->macros);				
 		}
 	}
 
 	for (size_t i = 0; i < g_PixelShaders.Size(); i++)
 	{
-		if (ShaderData* data = g_PixelShaders.Get((PixelShader_t)i))
+		const PixelShader_t shader = g_PixelShaders.GetID(i);
+		if (ShaderData* data = g_PixelShaders.Get(shader))
 		{
 			if (!data->compiled)
 				continue;
 
-			CompilePixelShader((PixelShader_t)i, data->path.c_str(), data->macros);
+			CompilePixelShader(shader, data->path.c_str(), data->macros);
 		}
 	}
 
 	for (size_t i = 0; i < g_ComputeShaders.Size(); i++)
 	{
-		if (ShaderData* data = g_ComputeShaders.Get((ComputeShader_t)i))
+		const ComputeShader_t shader = g_ComputeShaders.GetID(i);
+		if (ShaderData* data = g_ComputeShaders.Get(shader))
 		{
 			if (!data->compiled)
 				continue;
 
-			CompileComputeShader((ComputeShader_t)i, data->path.c_str(), data->macros);
+			CompileComputeShader(shader, data->path.c_str(), data->macros);
 		}
 	}
 
 	for (size_t i = 0; i < g_GeometryShaders.Size(); i++)
 	{
-		if (ShaderData* data = g_GeometryShaders.Get((GeometryShader_t)i))
+		const GeometryShader_t shader = g_GeometryShaders.GetID(i);
+		if (ShaderData* data = g_GeometryShaders.Get(shader))
 		{
 			if (!data->compiled)
 				continue;
 
-			CompileGeometryShader((GeometryShader_t)i, data->path.c_str(), data->macros);
+			CompileGeometryShader(shader, data->path.c_str(), data->macros);
 		}
 	}
 }
+
+void Shaders_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports)
+{
+	reports.push_back(g_VertexShaders.GetMemoryReport("Vertex Shaders"));
+	reports.push_back(g_PixelShaders.GetMemoryReport("Pixel Shaders"));
+	reports.push_back(g_GeometryShaders.GetMemoryReport("Geometry Shaders"));
+	reports.push_back(g_ComputeShaders.GetMemoryReport("Compute Shaders"));
+}
@@ -36,4 +36,6 @@ size_t Shaders_GetPixelShaderCount();
 size_t Shaders_GetGeometryShaderCount();
 size_t Shaders_GetComputeShaderCount();
 
+void Shaders_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports);
+
 void ReloadShaders();
\ No newline at end of file
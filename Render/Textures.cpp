@@ -1,6 +1,6 @@
 #include "Textures.h"
 #include "Binding.h"
-#include "IDArray.h"
+#include "ConcurrentIDArray.h"
 #include "Impl/TexturesImpl.h"
 
 #include <algorithm>
@@ -16,7 +16,7 @@ struct TextureData
     DepthStencilView_t dsv = DepthStencilView_t::INVALID;
 };
 
-IDArray<Texture_t, TextureData> g_Textures;
+ConcurrentIDArray<Texture_t, TextureData> g_Textures;
 
 Texture_t CreateTexture(const void* const data, RenderFormat format, uint32_t width, uint32_t height)
 {
@@ -60,6 +60,7 @@ Texture_t CreateTextureEx(const TextureCreateDescEx& desc)
     if (!CreateTextureImpl(newTex, desc))
     {
         g_Textures.Release(newTex);
+        g_Textures.Free(newTex);
         return Texture_t::INVALID;
     }
 
@@ -72,6 +73,7 @@ Texture_t CreateTextureEx(const TextureCreateDescEx& desc)
         if (data->srv == ShaderResourceView_t::INVALID)
         {
             g_Textures.Release(newTex);
+            g_Textures.Free(newTex);
             return Texture_t::INVALID;
         }
     }
@@ -82,6 +84,7 @@ Texture_t CreateTextureEx(const TextureCreateDescEx& desc)
         if (data->uav == UnorderedAccessView_t::INVALID)
         {
             g_Textures.Release(newTex);
+            g_Textures.Free(newTex);
             return Texture_t::INVALID;
         }
     }
@@ -92,6 +95,7 @@ Texture_t CreateTextureEx(const TextureCreateDescEx& desc)
         if (data->rtv == RenderTargetView_t::INVALID)
         {
             g_Textures.Release(newTex);
+            g_Textures.Free(newTex);
             return Texture_t::INVALID;
         }
     }
@@ -102,6 +106,7 @@ Texture_t CreateTextureEx(const TextureCreateDescEx& desc)
         if (data->dsv == DepthStencilView_t::INVALID)
         {
             g_Textures.Release(newTex);
+            g_Textures.Free(newTex);
             return Texture_t::INVALID;
         }
     }
@@ -134,6 +139,9 @@ void Render_Release(Texture_t tex)
         ReleaseUAV(data->uav);
         ReleaseRTV(data->rtv);
         ReleaseDSV(data->dsv);
+
+        DestroyTexture(tex);
+        g_Textures.Free(tex);
     }
 }
 
@@ -376,8 +384,8 @@ void Textures_CalculatePitch(RenderFormat format, uint32_t width, uint32_t heigh
     case RenderFormat::BC4_UNORM:
     case RenderFormat::BC4_SNORM:
     {
-        const uint64_t nbw = max(1u, (uint64_t(width) + 3u) / 4u);
-        const uint64_t nbh = max(1u, (uint64_t(height) + 3u) / 4u);
+        const uint64_t nbw = std::max<uint64_t>(1u, (uint64_t(width) + 3u) / 4u);
+        const uint64_t nbh = std::max<uint64_t>(1u, (uint64_t(height) + 3u) / 4u);
         pitch = nbw * 8u;
         slice = pitch * nbh;
     }
@@ -398,8 +406,8 @@ void Textures_CalculatePitch(RenderFormat format, uint32_t width, uint32_t heigh
     case RenderFormat::BC7_UNORM:
     case RenderFormat::BC7_UNORM_SRGB:
     {
-        const uint64_t nbw = max(1u, (uint64_t(width) + 3u) / 4u);
-        const uint64_t nbh = max(1u, (uint64_t(height) + 3u) / 4u);
+        const uint64_t nbw = std::max<uint64_t>(1u, (uint64_t(width) + 3u) / 4u);
+        const uint64_t nbh = std::max<uint64_t>(1u, (uint64_t(height) + 3u) / 4u);
         pitch = nbw * 16u;
         slice = pitch * nbh;
     }
@@ -576,4 +584,9 @@ MipData::MipData(const void* _data, RenderFormat format, uint32_t width, uint32_
 {
     data = _data;
     Textures_CalculatePitch(format, width, height, &rowPitch, &slicePitch);
+}
+
+void Textures_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports)
+{
+    reports.push_back(g_Textures.GetMemoryReport("Textures"));
 }
\ No newline at end of file
@@ -91,6 +91,7 @@ void Textures_CalculatePitch(RenderFormat format, uint32_t width, uint32_t heigh
 void Textures_GetSurfaceInfo(uint32_t width, uint32_t height, RenderFormat format, size_t* outNumBytes, size_t* outRowBytes = nullptr, size_t* outNumRows = nullptr);
 
 size_t Texture_GetTextureCount();
+void Textures_GetMemoryReports(std::vector<ResourceTableMemoryReport>& reports);
 
 enum class TextureResourceAccessMethod : uint32_t
 {
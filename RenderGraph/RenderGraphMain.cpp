@@ -29,6 +29,17 @@ struct
 	float exposure = 1.0f;
 } g_tonemap;
 
+struct
+{
+	bool aliasTransients = true;
+	bool asyncCompute = true;
+	bool reorderPasses = false;
+	bool rearView = false;
+	bool dumpGraph = false;
+	u32 lastTargetBinds = 0;
+	u32 lastTargetUnbinds = 0;
+} g_renderGraph;
+
 struct
 {
 	u32 w = 0;
@@ -36,6 +47,18 @@ struct
 	FlyCamera cam;
 } screenData;
 
+// Parameters of a view the scene sub-graph is instantiated for. The view is resolved to the
+// backbuffer rect at offset and scale, in 0-1 backbuffer coordinates.
+struct SceneView
+{
+	matrix viewProjMat;
+	float3 camPos;
+	u32 width = 0;
+	u32 height = 0;
+	float2 offset = { 0.0f, 0.0f };
+	float2 scale = { 1.0f, 1.0f };
+};
+
 struct
 {
 	float2 sunPitchYaw = float2{ 70.0f, 0.0f };
@@ -242,7 +265,7 @@ Mesh CreateCubeMesh()
 	return mesh;
 }
 
-void DrawUI()
+void DrawUI(const RenderGraphStats& graphStats)
 {
 	ImGui_RenderDebug();
 
@@ -277,6 +300,39 @@ void DrawUI()
 
 	ImGui::Separator();
 
+	ImGui::Checkbox("Alias Transients", &g_renderGraph.aliasTransients);
+	ImGui::Text("Graph Compiled: %s", graphStats.compiledFromCache ? "Cached" : "This Frame");
+	ImGui::Text("Transient Textures: %u (%u physical)", graphStats.transientTextures, graphStats.physicalTextures);
+	ImGui::Text("Transient Buffers: %u (%u physical)", graphStats.transientBuffers, graphStats.physicalBuffers);
+	ImGui::Text("Transient Memory: %.2fMB (%.2fMB unaliased)", graphStats.aliasedBytes / (1024.0f * 1024.0f), graphStats.unaliasedBytes / (1024.0f * 1024.0f));
+
+	// Execute runs after the UI is built, bind counts are from the previous frame.
+	ImGui::Text("Target Binds: %u Unbinds: %u", g_renderGraph.lastTargetBinds, g_renderGraph.lastTargetUnbinds);
+	ImGui::Text("Clears: %u Elided: %u", graphStats.clears, graphStats.elidedClears);
+	ImGui::Text("Barriers: %u (%u batches)", graphStats.barriers, graphStats.barrierBatches);
+
+	ImGui::Checkbox("Reorder Passes", &g_renderGraph.reorderPasses);
+	ImGui::Text("Target Switches: %u (%u unordered)", graphStats.targetSwitches, graphStats.addedOrderTargetSwitches);
+	ImGui::Text("Resource Transitions: %u (%u unordered)", graphStats.resourceTransitions, graphStats.addedOrderResourceTransitions);
+
+	ImGui::Checkbox("Rear View", &g_renderGraph.rearView);
+	ImGui::Text("Views: %u", graphStats.views);
+
+	ImGui::Checkbox("Async Compute", &g_renderGraph.asyncCompute);
+	ImGui::Text("Async Compute Passes: %u Sync Points: %u", graphStats.asyncComputePasses, graphStats.syncPoints);
+
+	const RenderGraphPoolStats& poolStats = RenderGraph_GetTexturePoolStats();
+	ImGui::Text("Texture Pool: %u (%u idle) %.2fMB", poolStats.resources, poolStats.idleResources, poolStats.bytes / (1024.0f * 1024.0f));
+	ImGui::Text("Texture Pool Creates: %zu Releases: %zu", poolStats.creates, poolStats.releases);
+
+	const RenderGraphPoolStats& bufferPoolStats = RenderGraph_GetBufferPoolStats();
+	ImGui::Text("Buffer Pool: %u (%u idle) %.2fMB", bufferPoolStats.resources, bufferPoolStats.idleResources, bufferPoolStats.bytes / (1024.0f * 1024.0f));
+
+	if (ImGui::Button("Dump Graph"))
+		g_renderGraph.dumpGraph = true;
+
+	ImGui::Separator();
+
 	ImGui::SliderFloat("Sun Pitch", &lightData.sunPitchYaw.x, -90.0f, 90.0f);
 	ImGui::SliderFloat("Sun Yaw", &lightData.sunPitchYaw.y, -180.0f, 180.0f);
 	ImGui::DragFloat3("Radiance", lightData.radiance.v);
@@ -342,72 +398,57 @@ void DrawMesh(CommandList* cl, Mesh& mesh)
 	cl->DrawIndexedInstanced(mesh.indexBuf.count, 1, 0, 0, 0);
 }
 
-void AddScenePass(RenderGraph& rg, RenderGraphResource_t sceneColor, RenderGraphResource_t sceneDepth)
+void AddScenePass(RenderGraph& rg, RenderGraphResource_t sceneColor, RenderGraphResource_t sceneDepth, const SceneView& view)
 {
+	struct
+	{
+		matrix viewProjMat;
+		float3 camPos;
+		float preExposure;
+		float3 lightDir;
+		float pad1;
+		float3 lightRadiance;
+		float pad2;
+		float3 lightAmbient;
+		float pad3;
+	} viewBufData;
+
+	viewBufData.viewProjMat = view.viewProjMat;
+	viewBufData.camPos = view.camPos;
+
+	viewBufData.preExposure = g_tonemap.enabled ? 1.0f / g_tonemap.exposure : 1.0f;
+
+	const float pitchRad = ConvertToRadians(lightData.sunPitchYaw.x);
+	const float yawRad = ConvertToRadians(lightData.sunPitchYaw.y);
+
+	viewBufData.lightDir = NormalizeF3(float3{ sinf(yawRad), sinf(-pitchRad), cosf(yawRad) });
+	viewBufData.lightRadiance = lightData.radiance;
+	viewBufData.lightAmbient = lightData.ambient;
+
+	const RenderGraphConstants_t viewConstants = rg.AddConstants(viewBufData);
+
 	rg.AddPass("Scene", RenderPassType::GRAPHICS)
 		.AddRenderTarget(sceneColor, RenderPassOutputAccess::CLEAR)
 		.AddDepthTarget(sceneDepth, RenderPassOutputAccess::CLEAR)
-		.SetExecuteCallback([sceneColor, sceneDepth](RenderGraph& rdg, CommandList* cl)
+		.SetExecuteCallback([viewConstants, width = view.width, height = view.height](RenderGraph& rdg, CommandList* cl)
 		{
-			const RenderTargetView_t sceneRtv = rdg.GetRTV(sceneColor);
-			const DepthStencilView_t sceneDsv = rdg.GetDSV(sceneDepth);
-
-			const float clearCol[] = { 0.01f, 0.01f, 0.01f, 1.0f };
-			cl->ClearRenderTarget(sceneRtv, clearCol);
-			cl->ClearDepth(sceneDsv, 1.0f);
-
-			// Could make this a graph function to avoid binding render targets
-			// multiple times
-			cl->SetRenderTargets(&sceneRtv, 1, sceneDsv);
-
 			{
-				Viewport vp{ screenData.w, screenData.h };
+				Viewport vp{ width, height };
 				cl->SetViewports(&vp, 1);
 				cl->SetDefaultScissor();
 			}
 
-			struct
-			{
-				matrix viewProjMat;
-				float3 camPos;
-				float preExposure;
-				float3 lightDir;
-				float pad1;
-				float3 lightRadiance;
-				float pad2;
-				float3 lightAmbient;
-				float pad3;
-			} viewBufData;
-
-			viewBufData.viewProjMat = screenData.cam.GetView() * screenData.cam.GetProjection();
-			viewBufData.camPos = screenData.cam.GetPosition();
-
-			viewBufData.preExposure = g_tonemap.enabled ? 1.0f / g_tonemap.exposure : 1.0f;
-
-			const float pitchRad = ConvertToRadians(lightData.sunPitchYaw.x);
-			const float yawRad = ConvertToRadians(lightData.sunPitchYaw.y);
-
-			viewBufData.lightDir = NormalizeF3(float3{ sinf(yawRad), sinf(-pitchRad), cosf(yawRad) });
-			viewBufData.lightRadiance = lightData.radiance;
-			viewBufData.lightAmbient = lightData.ambient;
-
-			DynamicBuffer_t viewBuf = CreateDynamicConstantBuffer(&viewBufData, sizeof(viewBufData));
+			const DynamicBuffer_t viewBuf = rdg.GetConstants(viewConstants);
 
 			cl->BindVertexCBVs(0, 1, &viewBuf);
 			cl->BindPixelCBVs(0, 1, &viewBuf);
 
 			DrawMesh(cl, g_mesh);
-
-			// Having to unbind targets just so compute stages can use them is awkward
-			// again if we bound render or compute targets through the graph
-			// we could handle this automatically.
-			RenderTargetView_t empty = RenderTargetView_t::INVALID;
-			cl->SetRenderTargets(&empty, 1, DepthStencilView_t::INVALID);
 		}
 	);
 }
 
-void AddBloomPass(RenderGraph& rg, RenderGraphResource_t source, RenderGraphResource_t target)
+void AddBloomPass(RenderGraph& rg, RenderGraphResource_t source, RenderGraphResource_t target, const SceneView& view)
 {
 	static ComputePipelineState_t bloomDownSampleCs = ComputePipelineState_t::INVALID;
 
@@ -445,17 +486,11 @@ void AddBloomPass(RenderGraph& rg, RenderGraphResource_t source, RenderGraphReso
 		ASSERTMSG(bloomApplyCs != ComputePipelineState_t::INVALID, "Failed to create up sample shader");
 	}
 
-	float2 mipSize = float2((float)screenData.w, (float)screenData.h);
+	float2 mipSize = float2((float)view.width, (float)view.height);
 	uint2 mipIntSize = mipSize;
 
 	static const char* BloomDownSampleNames[6] = { "Bloom_Downsample0", "Bloom_Downsample1", "Bloom_Downsample2", "Bloom_Downsample3", "Bloom_Downsample4", "Bloom_Downsample5" };
 	static const char* BloomUpSampleNames[6] = { "Bloom_Upsample0", "Bloom_Upsample1", "Bloom_Upsample2", "Bloom_Upsample3", "Bloom_Upsample4", "Bloom_Upsample5" };
-	static const char* BloomTextureNames[6] = { "Bloom_HalfRes", "Bloom_QuarterRes", "Bloom_EigthRes", "Bloom_SixteenthRes", "Bloom_ThirtySecondRes", "Bloom_SixtyFourthRes" };
-
-	RenderGraphTextureDesc desc = {};
-	desc.format = RenderFormat::R16G16B16A16_FLOAT;
-
-	RenderGraphResource_t bloomTextures[6] = {};
 
 	uint2 mipSizes[6];
 	u32 mipCount = 0;
@@ -473,54 +508,56 @@ void AddBloomPass(RenderGraph& rg, RenderGraphResource_t source, RenderGraphReso
 		mipSizes[i] = mipIntSize;
 
 		mipCount++;
-
-		desc.width = mipIntSize.x;
-		desc.height = mipIntSize.y;
-		bloomTextures[i] = rg.RegisterTexture(BloomTextureNames[i], desc);
 	}
 
 	if (mipCount == 0)
 		return;
 
+	// The chain is one half res texture, each downsample writes the next mip from the one above it.
+	RenderGraphTextureDesc desc = {};
+	desc.width = mipSizes[0].x;
+	desc.height = mipSizes[0].y;
+	desc.mipCount = mipCount;
+	desc.format = RenderFormat::R16G16B16A16_FLOAT;
+
+	const RenderGraphResource_t bloom = rg.RegisterTexture("Bloom", desc);
+
 	for (u32 i = 0; i < mipCount; i++)
 	{
-		RenderGraphResource_t outRes = bloomTextures[i];
-		RenderGraphResource_t inRes = i == 0 ? source : bloomTextures[i - 1];
+		const RenderGraphSubresourceRange outMip = RenderGraphSubresourceRange::Mip(i);
+		const RenderGraphResource_t inRes = i == 0 ? source : bloom;
+		const RenderGraphSubresourceRange inMip = i == 0 ? RenderGraphSubresourceRange{} : RenderGraphSubresourceRange::Mip(i - 1);
+
+		struct
+		{
+			uint2 dimensions;
+			float radius = g_bloom.radius;
+			float pad = 0.0f;
+		} shaderData;
+
+		shaderData.dimensions = mipSizes[i];
+
+		const RenderGraphConstants_t constants = rg.AddConstants(shaderData);
+
 		rg.AddPass(BloomDownSampleNames[i], RenderPassType::COMPUTE)
-			.AddComputeTarget(outRes, RenderPassOutputAccess::DONT_CARE)
-			.ReadResource(inRes)
-			.SetExecuteCallback([outRes, inRes](RenderGraph& rg, CommandList* cl)
+			.AddComputeTarget(bloom, RenderPassOutputAccess::DONT_CARE, outMip)
+			.ReadResource(inRes, inMip)
+			.SetExecuteCallback([bloom, outMip, inRes, inMip, constants](RenderGraph& rg, CommandList* cl)
 			{
-				const UnorderedAccessView_t uav = rg.GetUAV(outRes);
-				const ShaderResourceView_t srv = rg.GetSRV(inRes);
+				const ShaderResourceView_t srv = rg.GetSRV(inRes, inMip);
 
 				cl->SetPipelineState(bloomDownSampleCs);
 
-				uint3 dimensions = rg.GetResourceDimensions(outRes);
+				uint3 dimensions = rg.GetResourceDimensions(bloom, outMip);
 
-				cl->BindComputeUAVs(0, 1, &uav);
 				cl->BindComputeSRVs(0, 1, &srv);
 
-				struct
-				{
-					uint2 dimensions;
-					float radius = g_bloom.radius;
-					float pad = 0.0f;
-				} shaderData;
-
-				shaderData.dimensions = uint2{ dimensions.x, dimensions.y };
-
-				// Uploading constant data here will probably cause headaches with Dx12
-				// Need to find a way of enqueing these during the build stage
-				DynamicBuffer_t shaderCbuf = CreateDynamicConstantBuffer(&shaderData, sizeof(shaderData));
+				DynamicBuffer_t shaderCbuf = rg.GetConstants(constants);
 
 				cl->BindComputeCBVs(0, 1, &shaderCbuf);
 
 				cl->Dispatch(DivideRoundUp(dimensions.x, 8u), DivideRoundUp(dimensions.y, 8u), 1u);
 
-				UnorderedAccessView_t empty = UnorderedAccessView_t::INVALID;
-				cl->BindComputeUAVs(0, 1, &empty);
-
 				ShaderResourceView_t emptySrv = ShaderResourceView_t::INVALID;
 				cl->BindComputeSRVs(0, 1, &emptySrv);
 			}
@@ -529,45 +566,39 @@ void AddBloomPass(RenderGraph& rg, RenderGraphResource_t source, RenderGraphReso
 
 	for (u32 i = mipCount - 1; i > 0; --i)
 	{
-		RenderGraphResource_t outRes = bloomTextures[i - 1];
-		RenderGraphResource_t inRes = bloomTextures[i];
+		const RenderGraphSubresourceRange outMip = RenderGraphSubresourceRange::Mip(i - 1);
+		const RenderGraphSubresourceRange inMip = RenderGraphSubresourceRange::Mip(i);
+
+		struct
+		{
+			uint2 dimensions;
+			float2 texelSize;
+		} shaderData;
+
+		shaderData.dimensions = mipSizes[i - 1];
+		shaderData.texelSize = { 1.0f / mipSizes[i].x, 1.0f / mipSizes[i].y };
+
+		const RenderGraphConstants_t constants = rg.AddConstants(shaderData);
 
 		rg.AddPass(BloomUpSampleNames[i], RenderPassType::COMPUTE)
-			.AddComputeTarget(outRes, RenderPassOutputAccess::DONT_CARE)
-			.ReadResource(inRes)
-			.SetExecuteCallback([outRes, inRes](RenderGraph& rg, CommandList* cl)
+			.AddComputeTarget(bloom, RenderPassOutputAccess::DONT_CARE, outMip)
+			.ReadResource(bloom, inMip)
+			.SetExecuteCallback([bloom, outMip, inMip, constants](RenderGraph& rg, CommandList* cl)
 			{
-				const UnorderedAccessView_t uav = rg.GetUAV(outRes);
-				const ShaderResourceView_t srv = rg.GetSRV(inRes);
+				const ShaderResourceView_t srv = rg.GetSRV(bloom, inMip);
 
 				cl->SetPipelineState(bloomUpSampleCs);
 
-				uint3 dimensions = rg.GetResourceDimensions(outRes);
-				uint3 srcDimensions = rg.GetResourceDimensions(inRes);
+				uint3 dimensions = rg.GetResourceDimensions(bloom, outMip);
 
-				cl->BindComputeUAVs(0, 1, &uav);
 				cl->BindComputeSRVs(0, 1, &srv);
 
-				struct
-				{
-					uint2 dimensions;
-					float2 texelSize;
-				} shaderData;
-
-				shaderData.dimensions = { dimensions.x, dimensions.y };
-				shaderData.texelSize = { 1.0f / srcDimensions.x, 1.0f / srcDimensions.y };
-
-				// Uploading constant data here will probably cause headaches with Dx12
-				// Need to find a way of enqueing these during the build stage
-				DynamicBuffer_t shaderCbuf = CreateDynamicConstantBuffer(&shaderData, sizeof(shaderData));
+				DynamicBuffer_t shaderCbuf = rg.GetConstants(constants);
 
 				cl->BindComputeCBVs(0, 1, &shaderCbuf);
 
 				cl->Dispatch(DivideRoundUp(dimensions.x, 8u), DivideRoundUp(dimensions.y, 8u), 1u);
 
-				UnorderedAccessView_t empty = UnorderedAccessView_t::INVALID;
-				cl->BindComputeUAVs(0, 1, &empty);
-
 				ShaderResourceView_t emptySrv = ShaderResourceView_t::INVALID;
 				cl->BindComputeSRVs(0, 1, &emptySrv);
 			}
@@ -576,42 +607,38 @@ void AddBloomPass(RenderGraph& rg, RenderGraphResource_t source, RenderGraphReso
 
 	{
 		RenderGraphResource_t outRes = target;
-		RenderGraphResource_t inRes = bloomTextures[0];
+		const RenderGraphSubresourceRange inMip = RenderGraphSubresourceRange::Mip(0);
+
+		struct
+		{
+			uint2 dimensions;
+			float strength = g_bloom.strength;
+			float pad = 0.0f;
+		} shaderData;
+
+		shaderData.dimensions = uint2{ view.width, view.height };
+
+		const RenderGraphConstants_t constants = rg.AddConstants(shaderData);
+
 		rg.AddPass("Bloom_Apply", RenderPassType::COMPUTE)
 			.AddComputeTarget(outRes, RenderPassOutputAccess::LOAD)
-			.ReadResource(inRes)
-			.SetExecuteCallback([outRes, inRes](RenderGraph& rg, CommandList* cl)
+			.ReadResource(bloom, inMip)
+			.SetExecuteCallback([outRes, bloom, inMip, constants](RenderGraph& rg, CommandList* cl)
 			{
-				const UnorderedAccessView_t uav = rg.GetUAV(outRes);
-				const ShaderResourceView_t srv = rg.GetSRV(inRes);
+				const ShaderResourceView_t srv = rg.GetSRV(bloom, inMip);
 
 				cl->SetPipelineState(bloomApplyCs);
 
 				uint3 dimensions = rg.GetResourceDimensions(outRes);
 
-				cl->BindComputeUAVs(0, 1, &uav);
 				cl->BindComputeSRVs(0, 1, &srv);
 
-				struct
-				{
-					uint2 dimensions;
-					float strength = g_bloom.strength;
-					float pad = 0.0f;
-				} shaderData;
-
-				shaderData.dimensions = uint2{ dimensions.x, dimensions.y };
-
-				// Uploading constant data here will probably cause headaches with Dx12
-				// Need to find a way of enqueing these during the build stage
-				DynamicBuffer_t shaderCbuf = CreateDynamicConstantBuffer(&shaderData, sizeof(shaderData));
+				DynamicBuffer_t shaderCbuf = rg.GetConstants(constants);
 
 				cl->BindComputeCBVs(0, 1, &shaderCbuf);
 
 				cl->Dispatch(DivideRoundUp(dimensions.x, 8u), DivideRoundUp(dimensions.y, 8u), 1u);
 
-				UnorderedAccessView_t emptyUav = UnorderedAccessView_t::INVALID;
-				cl->BindComputeUAVs(0, 1, &emptyUav);
-
 				ShaderResourceView_t emptySrv = ShaderResourceView_t::INVALID;
 				cl->BindComputeSRVs(0, 1, &emptySrv);
 			}
@@ -619,7 +646,7 @@ void AddBloomPass(RenderGraph& rg, RenderGraphResource_t source, RenderGraphReso
 	}
 }
 
-void AddTonemapPass(RenderGraph& rg, RenderGraphResource_t input)
+void AddTonemapPass(RenderGraph& rg, RenderGraphResource_t input, const SceneView& view)
 {
 	static ComputePipelineState_t tonemapCs = ComputePipelineState_t::INVALID;
 
@@ -631,43 +658,37 @@ void AddTonemapPass(RenderGraph& rg, RenderGraphResource_t input)
 		tonemapCs = CreateComputePipelineState(desc);
 	}
 
+	struct
+	{
+		uint2 dimensions;
+		float pad[2];
+	} shaderData;
+
+	shaderData.dimensions = uint2{ view.width, view.height };
+
+	const RenderGraphConstants_t constants = rg.AddConstants(shaderData);
+
 	rg.AddPass("Tonemap_Rheinhardt", RenderPassType::COMPUTE)
 		.AddComputeTarget(input, RenderPassOutputAccess::LOAD)
-		.SetExecuteCallback([input](RenderGraph& rdg, CommandList* cl)
+		.SetExecuteCallback([input, constants](RenderGraph& rdg, CommandList* cl)
 		{
-			const UnorderedAccessView_t uav = rdg.GetUAV(input);
 			cl->SetPipelineState(tonemapCs);
 
 			uint3 dimensions = rdg.GetResourceDimensions(input);
-			
-			cl->BindComputeUAVs(0, 1, &uav);
-
-			struct
-			{
-				uint2 dimensions;
-				float pad[2];
-			} shaderData;
 
-			shaderData.dimensions = uint2{ dimensions.x, dimensions.y };
-
-			// Uploading constant data here will probably cause headaches with Dx12
-			// Need to find a way of enqueing these during the build stage
-			DynamicBuffer_t shaderCbuf = CreateDynamicConstantBuffer(&shaderData, sizeof(shaderData)); 
+			DynamicBuffer_t shaderCbuf = rdg.GetConstants(constants);
 
 			cl->BindComputeCBVs(0, 1, &shaderCbuf);
 
 			cl->Dispatch(DivideRoundUp(dimensions.x, 8u), DivideRoundUp(dimensions.y, 8u), 1u);
 
-			UnorderedAccessView_t empty = UnorderedAccessView_t::INVALID;
-			cl->BindComputeUAVs(0, 1, &empty);
-
 			ShaderResourceView_t emptySrv = ShaderResourceView_t::INVALID;
 			cl->BindComputeSRVs(0, 1, &emptySrv);
 		}
 	);
 }
 
-void AddResolvePass(RenderGraph& rg, RenderGraphResource_t dst, RenderGraphResource_t src)
+void AddResolvePass(RenderGraph& rg, RenderGraphResource_t dst, RenderGraphResource_t src, const SceneView& view)
 {
 	static GraphicsPipelineState_t resolvePSO = GraphicsPipelineState_t::INVALID;
 
@@ -686,16 +707,28 @@ void AddResolvePass(RenderGraph& rg, RenderGraphResource_t dst, RenderGraphResou
 		resolvePSO = CreateGraphicsPipelineState(desc);
 	}
 
+	struct
+	{
+		float2 offset;
+		float2 scale;
+		float2 uvOffset;
+		float2 uvScale;
+	} shaderData;
+
+	shaderData.offset = view.offset;
+	shaderData.uvOffset = { 0.0f, 0.0f };
+	shaderData.scale = view.scale;
+	shaderData.uvScale = { 1.0f, -1.0f };
+
+	const RenderGraphConstants_t constants = rg.AddConstants(shaderData);
+
 	rg.AddPass("Resolve", RenderPassType::GRAPHICS)
 		.AddRenderTarget(dst, RenderPassOutputAccess::LOAD)
 		.ReadResource(src)
-		.SetExecuteCallback([dst, src](RenderGraph& rdg, CommandList* cl)
+		.SetExecuteCallback([dst, src, constants](RenderGraph& rdg, CommandList* cl)
 		{
-			const RenderTargetView_t rtv = rdg.GetRTV(dst);
 			const ShaderResourceView_t srv = rdg.GetSRV(src);
 
-			cl->SetRenderTargets(&rtv, 1, DepthStencilView_t::INVALID);
-
 			cl->SetPipelineState(resolvePSO);
 
 			uint3 dstDim = rdg.GetResourceDimensions(dst);
@@ -705,20 +738,7 @@ void AddResolvePass(RenderGraph& rg, RenderGraphResource_t dst, RenderGraphResou
 				cl->SetDefaultScissor();
 			}
 
-			struct
-			{
-				float2 offset;
-				float2 scale;
-				float2 uvOffset;
-				float2 uvScale;
-			} shaderData;
-
-			shaderData.offset = { 0.0f, 0.0f };
-			shaderData.uvOffset = { 0.0f, 0.0f };
-			shaderData.scale = { 1.0f, 1.0f };
-			shaderData.uvScale = { 1.0f, -1.0f };
-
-			DynamicBuffer_t shaderBuf = CreateDynamicConstantBuffer(&shaderData, sizeof(shaderData));
+			DynamicBuffer_t shaderBuf = rdg.GetConstants(constants);
 
 			cl->BindVertexCBVs(0, 1, &shaderBuf);
 
@@ -736,15 +756,38 @@ void AddUIPass(RenderGraph& rg, RenderGraphResource_t target)
 		.MakeRoot()
 		.SetExecuteCallback([target](RenderGraph& rdg, CommandList* cl)
 		{
-			const RenderTargetView_t rtv = rdg.GetRTV(target);
-
-			cl->SetRenderTargets(&rtv, 1, DepthStencilView_t::INVALID);
-
 			ImGui_ImplRender_RenderDrawData(ImGui::GetDrawData(), cl);
 		}
 	);
 }
 
+// Writes the graph next to the executable, RenderGraph.dot renders with "dot -Tsvg RenderGraph.dot".
+void WriteGraphDump(const RenderGraph& rg)
+{
+	const std::pair<const char*, RenderGraphDumpFormat> dumps[] = {
+		{ "RenderGraph.dot", RenderGraphDumpFormat::GRAPHVIZ },
+		{ "RenderGraph.json", RenderGraphDumpFormat::JSON },
+	};
+
+	for (const auto& [filename, format] : dumps)
+	{
+		const std::string dump = rg.Dump(format);
+
+		FILE* fp = nullptr;
+		fopen_s(&fp, filename, "wb");
+		if (fp == nullptr)
+		{
+			LOGERROR("Failed to write render graph dump (%s)", filename);
+			continue;
+		}
+
+		fwrite(dump.data(), 1, dump.size(), fp);
+		fclose(fp);
+
+		LOGINFO("Wrote render graph dump (%s)", filename);
+	}
+}
+
 LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 int main()
@@ -801,52 +844,100 @@ int main()
 			continue;
 		}
 
+		// Pass constants are captured while the graph is set up, so the camera has to be current.
+		updateClock.Tick();
+		const float delta = (float)updateClock.GetDeltaSeconds();
+
+		screenData.cam.UpdateView(delta);
+
 		RenderGraph rdg;
 
 		RenderGraphResource_t backbuffer = rdg.AddExternalRTV("Backbuffer", view->GetCurrentBackBufferRTV(), view->width, view->height);
 
-		RenderGraphTextureDesc screenTexDesc;
-		screenTexDesc.width = screenData.w;
-		screenTexDesc.height = screenData.h;
+		std::vector<std::string> viewNames = { "Main" };
+		std::vector<SceneView> sceneViews(1);
 
-		screenTexDesc.format = RenderFormat::D32_FLOAT;
-		RenderGraphResource_t sceneDepth = rdg.RegisterTexture("SceneDepth", screenTexDesc);
+		sceneViews[0].viewProjMat = screenData.cam.GetView() * screenData.cam.GetProjection();
+		sceneViews[0].camPos = screenData.cam.GetPosition();
+		sceneViews[0].width = screenData.w;
+		sceneViews[0].height = screenData.h;
 
-		screenTexDesc.format = RenderFormat::R16G16B16A16_FLOAT;
-		RenderGraphResource_t sceneColor = rdg.RegisterTexture("SceneColor", screenTexDesc);
+		// Rear view mirror in the top right corner, the camera turned around at a quarter resolution.
+		if (g_renderGraph.rearView)
+		{
+			SceneView& rearView = sceneViews.emplace_back();
+			rearView.viewProjMat = screenData.cam.GetView() * MakeMatrixRotationAxis(float3{ 0.0f, 1.0f, 0.0f }, K_PI) * screenData.cam.GetProjection();
+			rearView.camPos = screenData.cam.GetPosition();
+			rearView.width = Max(screenData.w / 4, 1u);
+			rearView.height = Max(screenData.h / 4, 1u);
+			rearView.offset = { 0.7f, 0.7f };
+			rearView.scale = { 0.25f, 0.25f };
+
+			viewNames.push_back("Rear");
+		}
 
-		AddScenePass(rdg, sceneColor, sceneDepth);
+		rdg.AddViews(viewNames, [&sceneViews, backbuffer](RenderGraph& rg, const RenderGraphView& graphView)
+		{
+			const SceneView& sceneView = sceneViews[graphView.index];
 
-		if(g_bloom.enabled)
-			AddBloomPass(rdg, sceneColor, sceneColor);
+			RenderGraphTextureDesc screenTexDesc;
+			screenTexDesc.width = sceneView.width;
+			screenTexDesc.height = sceneView.height;
 
-		if(g_tonemap.enabled)
-			AddTonemapPass(rdg, sceneColor);
+			screenTexDesc.format = RenderFormat::D32_FLOAT;
+			RenderGraphResource_t sceneDepth = rg.RegisterTexture("SceneDepth", screenTexDesc);
 
-		AddResolvePass(rdg, backbuffer, sceneColor);
+			screenTexDesc.format = RenderFormat::R16G16B16A16_FLOAT;
+			screenTexDesc.clearColor[0] = 0.01f;
+			screenTexDesc.clearColor[1] = 0.01f;
+			screenTexDesc.clearColor[2] = 0.01f;
+			screenTexDesc.clearColor[3] = 1.0f;
+			RenderGraphResource_t sceneColor = rg.RegisterTexture("SceneColor", screenTexDesc);
 
-		AddUIPass(rdg, backbuffer);
+			AddScenePass(rg, sceneColor, sceneDepth, sceneView);
 
-		rdg.Build();
+			if(g_bloom.enabled)
+				AddBloomPass(rg, sceneColor, sceneColor, sceneView);
 
-		updateClock.Tick();
-		const float delta = (float)updateClock.GetDeltaSeconds();
+			if(g_tonemap.enabled)
+				AddTonemapPass(rg, sceneColor, sceneView);
 
-		screenData.cam.UpdateView(delta);
+			AddResolvePass(rg, backbuffer, sceneColor, sceneView);
+		});
+
+		AddUIPass(rdg, backbuffer);
+
+		RenderGraph_SetTransientAliasing(g_renderGraph.aliasTransients);
+		RenderGraph_SetAsyncCompute(g_renderGraph.asyncCompute);
+		RenderGraph_SetPassReordering(g_renderGraph.reorderPasses);
+
+		rdg.Build();
 
 		ImGui_ImplRender_NewFrame();
 
 		ImGui_ImplWin32_NewFrame();
 		ImGui::NewFrame();
 
-		DrawUI();
+		DrawUI(rdg.GetStats());
 
 		ImGui::Render();		
 
 		Render_NewFrame();
 
+		// The frame a dump is requested is timed so the dump includes pass callback times.
+		RenderGraph_SetPassTiming(g_renderGraph.dumpGraph);
+
 		rdg.Execute();
 
+		if (g_renderGraph.dumpGraph)
+		{
+			WriteGraphDump(rdg);
+			g_renderGraph.dumpGraph = false;
+		}
+
+		g_renderGraph.lastTargetBinds = rdg.GetStats().targetBinds;
+		g_renderGraph.lastTargetUnbinds = rdg.GetStats().targetUnbinds;
+
 		view->Present(true);
 	}
 
@@ -854,6 +945,8 @@ int main()
 	ImGui_ImplWin32_Shutdown();
 	ImGui::DestroyContext();
 
+	RenderGraph_ReleasePools();
+
 	Render_ShutDown();
 
 	::DestroyWindow(hwnd);
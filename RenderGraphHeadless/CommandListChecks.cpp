@@ -0,0 +1,251 @@
+#include "CommandListChecks.h"
+
+#include "Render/Render.h"
+#include "Render/Impl/Null/RenderImpl.h"
+
+#include <cstdio>
+
+namespace
+{
+	int g_failures = 0;
+
+	void Check(bool condition, const char* name, const char* fmt, size_t actual)
+	{
+		if (condition)
+			return;
+
+		fprintf(stderr, "FAILED %s: ", name);
+		fprintf(stderr, fmt, actual);
+		fprintf(stderr, "\n");
+		g_failures++;
+	}
+
+	// The null backend never looks up the views and buffers bound, so the checks bind made up handles.
+	const ShaderResourceView_t kSrvA = (ShaderResourceView_t)101;
+	const ShaderResourceView_t kSrvB = (ShaderResourceView_t)102;
+	const ShaderResourceView_t kSrvC = (ShaderResourceView_t)103;
+	const ShaderResourceView_t kSrvD = (ShaderResourceView_t)104;
+	const UnorderedAccessView_t kUav = (UnorderedAccessView_t)201;
+	const RenderTargetView_t kRtv = (RenderTargetView_t)301;
+	const ConstantBuffer_t kCbvA = (ConstantBuffer_t)401;
+	const ConstantBuffer_t kCbvB = (ConstantBuffer_t)402;
+	const DynamicBuffer_t kDynamicCbv = (DynamicBuffer_t)501;
+	const VertexBuffer_t kVertexBuffer = (VertexBuffer_t)601;
+
+	// A command of a stream, with the slots and handles of bind commands.
+	struct StreamCommand
+	{
+		CommandOp op = CommandOp::Count;
+		uint32_t startSlot = 0;
+		std::vector<uint64_t> values;
+
+		bool operator==(const StreamCommand& other) const
+		{
+			return op == other.op && startSlot == other.startSlot && values == other.values;
+		}
+	};
+
+	bool IsBindOp(CommandOp op)
+	{
+		return op >= CommandOp::BindVertexSRVs || op == CommandOp::SetVertexBuffers || op == CommandOp::SetDynamicVertexBuffers;
+	}
+
+	// Bind payloads start with the first slot and the count, followed by one 64 bit handle per slot.
+	std::vector<StreamCommand> ReadCommands(const CommandStream& stream, bool bindsOnly)
+	{
+		std::vector<StreamCommand> commands;
+
+		CommandStreamReader reader(stream);
+		CommandHeader header;
+
+		while (reader.Next(header))
+		{
+			if (bindsOnly && !IsBindOp(header.op))
+			{
+				reader.Skip(header.payloadSize);
+				continue;
+			}
+
+			StreamCommand& command = commands.emplace_back();
+			command.op = header.op;
+
+			if (!IsBindOp(header.op))
+			{
+				reader.Skip(header.payloadSize);
+				continue;
+			}
+
+			command.startSlot = reader.Read<uint32_t>();
+			const uint32_t count = reader.Read<uint32_t>();
+			command.values.resize(count);
+			reader.Read(command.values.data(), count);
+			reader.Skip(header.payloadSize - sizeof(uint32_t) * 2 - sizeof(uint64_t) * count);
+		}
+
+		return commands;
+	}
+
+	StreamCommand Bind(CommandOp op, uint32_t startSlot, std::vector<uint64_t> values)
+	{
+		return { op, startSlot, std::move(values) };
+	}
+
+	StreamCommand Op(CommandOp op)
+	{
+		return { op, 0, {} };
+	}
+
+	// Index of the first command that differs, or SIZE_MAX if the streams match.
+	size_t FirstMismatch(const std::vector<StreamCommand>& actual, const std::vector<StreamCommand>& expected)
+	{
+		for (size_t i = 0; i < actual.size() || i < expected.size(); i++)
+		{
+			if (i >= actual.size() || i >= expected.size() || !(actual[i] == expected[i]))
+				return i;
+		}
+
+		return SIZE_MAX;
+	}
+
+	// Binding a render target or a UAV makes the backend unbind SRVs of the same resource, so an SRV
+	// bound again afterwards must be sent even though the cache already holds it.
+	void RecordHazards(CommandList* cl)
+	{
+		cl->BindPixelSRVs(0, 1, &kSrvA);
+		cl->DrawInstanced(3, 1, 0, 0);
+		cl->BindPixelSRVs(0, 1, &kSrvA);
+		cl->DrawInstanced(3, 1, 0, 0);
+
+		cl->SetRenderTargets(&kRtv, 1, DepthStencilView_t::INVALID);
+		cl->BindPixelSRVs(0, 1, &kSrvA);
+		cl->DrawInstanced(3, 1, 0, 0);
+
+		cl->BindComputeSRVs(0, 1, &kSrvA);
+		cl->Dispatch(1, 1, 1);
+		cl->BindComputeUAVs(0, 1, &kUav);
+		cl->Dispatch(1, 1, 1);
+		cl->BindComputeSRVs(0, 1, &kSrvA);
+		cl->Dispatch(1, 1, 1);
+	}
+
+	void CheckHazards()
+	{
+		CommandListPtr cl = CommandList::Create(CommandListMode::Recorded);
+		RecordHazards(cl.get());
+
+		const std::vector<StreamCommand> commands = ReadCommands(cl->GetStream(), false);
+		CommandList::Execute(cl);
+
+		// The second pixel bind is dropped, nothing was bound in between.
+		const std::vector<StreamCommand> expected =
+		{
+			Bind(CommandOp::BindPixelSRVs, 0, { (uint64_t)kSrvA }),
+			Op(CommandOp::DrawInstanced),
+			Op(CommandOp::DrawInstanced),
+			Op(CommandOp::SetRenderTargets),
+			Bind(CommandOp::BindPixelSRVs, 0, { (uint64_t)kSrvA }),
+			Op(CommandOp::DrawInstanced),
+			Bind(CommandOp::BindComputeSRVs, 0, { (uint64_t)kSrvA }),
+			Op(CommandOp::Dispatch),
+			Bind(CommandOp::BindComputeUAVs, 0, { (uint64_t)kUav }),
+			Op(CommandOp::Dispatch),
+			Bind(CommandOp::BindComputeSRVs, 0, { (uint64_t)kSrvA }),
+			Op(CommandOp::Dispatch),
+		};
+
+		const size_t mismatch = FirstMismatch(commands, expected);
+		Check(mismatch == SIZE_MAX, "srv hazards", "recorded command %zu differs from the expected stream", mismatch);
+	}
+
+	// CBV slots 0 and 2 and SRV slots 4 and 6-7 are set by separate calls, the slots between them are
+	// never written. After the draw slot 5 is set along with slots that are already bound, and a
+	// dynamic buffer goes in the gap between the constant buffers.
+	void RecordRuns(CommandList* cl)
+	{
+		const ShaderResourceView_t pair[] = { kSrvB, kSrvC };
+		const ShaderResourceView_t four[] = { kSrvA, kSrvD, kSrvB, kSrvC };
+		const uint32_t stride = 16;
+		const uint32_t offset = 0;
+
+		cl->BindPixelCBVs(0, 1, &kCbvA);
+		cl->BindPixelCBVs(2, 1, &kCbvB);
+		cl->BindPixelSRVs(4, 1, &kSrvA);
+		cl->BindPixelSRVs(6, 2, pair);
+		cl->SetVertexBuffers(1, 1, &kVertexBuffer, &stride, &offset);
+		cl->DrawInstanced(3, 1, 0, 0);
+
+		cl->BindPixelSRVs(4, 4, four);
+		cl->BindPixelCBVs(1, 1, &kDynamicCbv);
+		cl->DrawInstanced(3, 1, 0, 0);
+	}
+
+	void CheckRuns()
+	{
+		CommandListPtr cl = CommandList::Create(CommandListMode::Recorded);
+		RecordRuns(cl.get());
+
+		const std::vector<StreamCommand> commands = ReadCommands(cl->GetStream(), false);
+		CommandList::Execute(cl);
+
+		const std::vector<StreamCommand> expected =
+		{
+			Bind(CommandOp::BindPixelSRVs, 4, { (uint64_t)kSrvA }),
+			Bind(CommandOp::BindPixelSRVs, 6, { (uint64_t)kSrvB, (uint64_t)kSrvC }),
+			Bind(CommandOp::BindPixelCBVs, 0, { (uint64_t)kCbvA }),
+			Bind(CommandOp::BindPixelCBVs, 2, { (uint64_t)kCbvB }),
+			Bind(CommandOp::SetVertexBuffers, 1, { (uint64_t)kVertexBuffer }),
+			Op(CommandOp::DrawInstanced),
+			Bind(CommandOp::BindPixelSRVs, 5, { (uint64_t)kSrvD }),
+			Bind(CommandOp::BindPixelDynamicCBVs, 1, { (uint64_t)kDynamicCbv }),
+			Op(CommandOp::DrawInstanced),
+		};
+
+		const size_t mismatch = FirstMismatch(commands, expected);
+		Check(mismatch == SIZE_MAX, "bind runs", "recorded command %zu differs from the expected stream", mismatch);
+	}
+
+	// The binds a recorded list holds must be the binds the backend receives when the stream is
+	// replayed on execute, and the binds an immediate list sends for the same calls.
+	void CheckReplay()
+	{
+		for (void (*record)(CommandList*) : { RecordHazards, RecordRuns })
+		{
+			Null_SetBindCapture(true);
+
+			CommandListPtr recorded = CommandList::Create(CommandListMode::Recorded);
+			record(recorded.get());
+
+			const std::vector<StreamCommand> recordedBinds = ReadCommands(recorded->GetStream(), true);
+			CommandList::Execute(recorded);
+
+			const std::vector<StreamCommand> replayedBinds = ReadCommands(Null_GetCapturedBinds(), true);
+
+			Null_SetBindCapture(true);
+
+			CommandListPtr immediate = CommandList::Create();
+			record(immediate.get());
+			CommandList::Execute(immediate);
+
+			const std::vector<StreamCommand> immediateBinds = ReadCommands(Null_GetCapturedBinds(), true);
+
+			Null_SetBindCapture(false);
+
+			const size_t replayMismatch = FirstMismatch(replayedBinds, recordedBinds);
+			Check(!recordedBinds.empty() && replayMismatch == SIZE_MAX, "replay", "replayed bind %zu differs from the recorded stream", replayMismatch);
+
+			const size_t immediateMismatch = FirstMismatch(immediateBinds, recordedBinds);
+			Check(immediateMismatch == SIZE_MAX, "replay", "immediate bind %zu differs from the recorded stream", immediateMismatch);
+		}
+	}
+}
+
+int CommandList_RunChecks()
+{
+	g_failures = 0;
+
+	CheckHazards();
+	CheckRuns();
+	CheckReplay();
+
+	return g_failures;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Bind caching in CommandList checked against the commands a recorded list holds and the binds the
+// null backend receives: SRVs rebound after targets or UAVs unbind them, dirty slots flushed in
+// contiguous runs without the slots between them, and replayed streams matching immediate lists.
+// Logs each failure and returns how many checks failed.
+int CommandList_RunChecks();
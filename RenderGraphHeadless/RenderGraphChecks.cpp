@@ -0,0 +1,435 @@
+#include "RenderGraphChecks.h"
+
+#include "Render/Render.h"
+#include "Render/Impl/Null/RenderImpl.h"
+#include "Utils/RenderGraph/RenderGraph.h"
+
+#include <cstdio>
+
+namespace
+{
+	int g_failures = 0;
+
+	void Check(bool condition, const char* name, const char* fmt, size_t actual)
+	{
+		if (condition)
+			return;
+
+		fprintf(stderr, "FAILED %s: ", name);
+		fprintf(stderr, fmt, actual);
+		fprintf(stderr, "\n");
+		g_failures++;
+	}
+
+	void CheckTime(float actual, float expected, const char* name, const char* what)
+	{
+		if (actual == expected)
+			return;
+
+		fprintf(stderr, "FAILED %s: %s is %.2f, expected %.2f\n", name, what, actual, expected);
+		g_failures++;
+	}
+
+	void Nop(RenderGraph&, CommandList*) {}
+
+	// A chain of compute passes each reading the previous texture, so A and C can share a physical
+	// texture, as can B and D.
+	struct AliasingResult
+	{
+		size_t textureCreates = 0;
+		u32 physicalTextures = 0;
+		bool aSharesC = false;
+		bool bSharesD = false;
+	};
+
+	AliasingResult RunAliasingGraph(RenderTargetView_t backBuffer)
+	{
+		RenderGraph rg;
+		const RenderGraphResource_t bb = rg.AddExternalRTV("Backbuffer", backBuffer, 1280, 720);
+
+		RenderGraphTextureDesc desc;
+		desc.width = 256;
+		desc.height = 256;
+		desc.format = RenderFormat::R16G16B16A16_FLOAT;
+
+		const RenderGraphResource_t a = rg.RegisterTexture("A", desc);
+		const RenderGraphResource_t b = rg.RegisterTexture("B", desc);
+		const RenderGraphResource_t c = rg.RegisterTexture("C", desc);
+		const RenderGraphResource_t d = rg.RegisterTexture("D", desc);
+
+		rg.AddPass("WriteA", RenderPassType::COMPUTE).AddComputeTarget(a, RenderPassOutputAccess::DONT_CARE).SetExecuteCallback(Nop);
+		rg.AddPass("WriteB", RenderPassType::COMPUTE).AddComputeTarget(b, RenderPassOutputAccess::DONT_CARE).ReadResource(a).SetExecuteCallback(Nop);
+		rg.AddPass("WriteC", RenderPassType::COMPUTE).AddComputeTarget(c, RenderPassOutputAccess::DONT_CARE).ReadResource(b).SetExecuteCallback(Nop);
+		rg.AddPass("WriteD", RenderPassType::COMPUTE).AddComputeTarget(d, RenderPassOutputAccess::DONT_CARE).ReadResource(c).SetExecuteCallback(Nop);
+		rg.AddPass("Resolve", RenderPassType::GRAPHICS).AddRenderTarget(bb, RenderPassOutputAccess::LOAD).ReadResource(d).MakeRoot().SetExecuteCallback(Nop);
+
+		const size_t creates = Null_GetCounters().textureCreates;
+
+		rg.Build();
+		rg.Execute();
+
+		AliasingResult result;
+		result.textureCreates = Null_GetCounters().textureCreates - creates;
+		result.physicalTextures = rg.GetStats().physicalTextures;
+		result.aSharesC = rg.GetTexture(a) == rg.GetTexture(c);
+		result.bSharesD = rg.GetTexture(b) == rg.GetTexture(d);
+		return result;
+	}
+
+	void CheckAliasing(RenderTargetView_t backBuffer)
+	{
+		RenderGraph_ReleasePools();
+		RenderGraph_SetTransientAliasing(false);
+		const AliasingResult unaliased = RunAliasingGraph(backBuffer);
+
+		RenderGraph_ReleasePools();
+		RenderGraph_SetTransientAliasing(true);
+		const AliasingResult aliased = RunAliasingGraph(backBuffer);
+
+		Check(unaliased.textureCreates == 4, "aliasing", "unaliased graph created %zu textures, expected 4", unaliased.textureCreates);
+		Check(aliased.textureCreates == 2, "aliasing", "aliased graph created %zu textures, expected 2", aliased.textureCreates);
+		Check(aliased.physicalTextures == 2, "aliasing", "aliased graph has %zu physical textures, expected 2", aliased.physicalTextures);
+		Check(aliased.aSharesC && aliased.bSharesD, "aliasing", "A and C or B and D are in different textures (%zu)", 0);
+
+		// Later frames take every texture from the pool.
+		size_t steadyCreates = 0;
+		for (u32 frame = 0; frame < 4; frame++)
+			steadyCreates += RunAliasingGraph(backBuffer).textureCreates;
+
+		Check(steadyCreates == 0, "aliasing", "steady frames created %zu textures, expected 0", steadyCreates);
+
+		RenderGraph_ReleasePools();
+	}
+
+	// A shared shadow pass, a dead pass that is culled, and a scene, post and resolve chain per view.
+	// The per view transients alias each other so the physical count doesn't grow with the views.
+	void CheckViews(RenderTargetView_t backBuffer)
+	{
+		for (u32 viewCount : { 1u, 2u, 4u })
+		{
+			RenderGraph rg;
+			const RenderGraphResource_t bb = rg.AddExternalRTV("Backbuffer", backBuffer, 1280, 720);
+
+			RenderGraphTextureDesc shadowDesc;
+			shadowDesc.width = 1024;
+			shadowDesc.height = 1024;
+			shadowDesc.format = RenderFormat::D32_FLOAT;
+
+			const RenderGraphResource_t shadow = rg.RegisterTexture("Shadow", shadowDesc);
+			const RenderGraphResource_t dead = rg.RegisterTexture("Dead", shadowDesc);
+
+			rg.AddPass("Shadow", RenderPassType::GRAPHICS).AddDepthTarget(shadow, RenderPassOutputAccess::CLEAR).SetExecuteCallback(Nop);
+			rg.AddPass("Dead", RenderPassType::GRAPHICS).AddDepthTarget(dead, RenderPassOutputAccess::CLEAR).SetExecuteCallback(Nop);
+
+			std::vector<std::string> names;
+			for (u32 i = 0; i < viewCount; i++)
+				names.push_back("View" + std::to_string(i));
+
+			bool lookupsFound = true;
+			rg.AddViews(names, [&](RenderGraph& g, const RenderGraphView&)
+			{
+				RenderGraphTextureDesc desc;
+				desc.width = 640;
+				desc.height = 360;
+				desc.format = RenderFormat::R16G16B16A16_FLOAT;
+
+				const RenderGraphResource_t color = g.RegisterTexture("Color", desc);
+				const RenderGraphResource_t post = g.RegisterTexture("Post", desc);
+				lookupsFound &= g.GetResource("Color") == color && g.GetResource("Shadow") == shadow;
+
+				g.AddPass("Scene", RenderPassType::GRAPHICS).AddRenderTarget(color, RenderPassOutputAccess::CLEAR).ReadResource(shadow).SetExecuteCallback(Nop);
+				g.AddPass("Post", RenderPassType::COMPUTE).AddComputeTarget(post, RenderPassOutputAccess::DONT_CARE).ReadResource(color).SetExecuteCallback(Nop);
+				g.AddPass("Resolve", RenderPassType::GRAPHICS).AddRenderTarget(bb, RenderPassOutputAccess::LOAD).ReadResource(post).SetExecuteCallback(Nop);
+			});
+
+			rg.AddPass("UI", RenderPassType::GRAPHICS).AddRenderTarget(bb, RenderPassOutputAccess::LOAD).MakeRoot().SetExecuteCallback(Nop);
+
+			rg.Build();
+			rg.Execute();
+
+			const RenderGraphStats& stats = rg.GetStats();
+			Check(stats.views == viewCount, "views", "graph reports %zu views", stats.views);
+			Check(lookupsFound, "views", "scoped resource lookup failed (%zu)", 0);
+			Check(rg.GetResource("View0/Color") != RenderGraphResource_t::NONE, "views", "View0/Color is not registered (%zu)", 0);
+			Check(stats.physicalTextures == 3, "views", "graph has %zu physical textures, expected 3", stats.physicalTextures);
+		}
+
+		RenderGraph_ReleasePools();
+	}
+
+	// A mip chain read from a different first mip each frame. Ranges with the default counts differ
+	// only in firstMip, so the compiled graph must not be reused between them.
+	struct SubresourceCacheResult
+	{
+		bool compiledFromCache = false;
+		bool subresourceSRV = false;
+	};
+
+	SubresourceCacheResult RunSubresourceGraph(RenderTargetView_t backBuffer, u32 firstMip)
+	{
+		RenderGraph rg;
+		const RenderGraphResource_t bb = rg.AddExternalRTV("Backbuffer", backBuffer, 1280, 720);
+
+		RenderGraphTextureDesc desc;
+		desc.width = 256;
+		desc.height = 256;
+		desc.mipCount = 4;
+		desc.format = RenderFormat::R16G16B16A16_FLOAT;
+		const RenderGraphResource_t mips = rg.RegisterTexture("Mips", desc);
+
+		RenderGraphSubresourceRange range;
+		range.firstMip = firstMip;
+
+		SubresourceCacheResult result;
+		rg.AddPass("WriteMips", RenderPassType::COMPUTE).AddComputeTarget(mips, RenderPassOutputAccess::DONT_CARE).SetExecuteCallback(Nop);
+		rg.AddPass("Resolve", RenderPassType::GRAPHICS).AddRenderTarget(bb, RenderPassOutputAccess::LOAD).ReadResource(mips, range).MakeRoot()
+			.SetExecuteCallback([&](RenderGraph& g, CommandList*)
+			{
+				const ShaderResourceView_t srv = g.GetSRV(mips, range);
+				result.subresourceSRV = srv != ShaderResourceView_t::INVALID && srv != g.GetSRV(mips);
+			});
+
+		rg.Build();
+		rg.Execute();
+
+		result.compiledFromCache = rg.GetStats().compiledFromCache;
+		return result;
+	}
+
+	void CheckSubresourceCache(RenderTargetView_t backBuffer)
+	{
+		RunSubresourceGraph(backBuffer, 1);
+		const SubresourceCacheResult same = RunSubresourceGraph(backBuffer, 1);
+		const SubresourceCacheResult changed = RunSubresourceGraph(backBuffer, 3);
+
+		Check(same.compiledFromCache, "subresource cache", "identical graph was not compiled from the cache (%zu)", 0);
+		Check(!changed.compiledFromCache, "subresource cache", "graph reading another first mip was compiled from the cache (%zu)", 0);
+		Check(same.subresourceSRV && changed.subresourceSRV, "subresource cache", "pass read the whole texture instead of its mip range (%zu)", 0);
+
+		RenderGraph_ReleasePools();
+	}
+
+	// Eight passes drawing into the same target. Serially the target is bound once, with worker
+	// threads each run of passes shares a command list and binds it once.
+	void CheckTargetBinds(RenderTargetView_t backBuffer)
+	{
+		for (u32 threads : { 1u, 4u })
+		{
+			RenderGraph_SetRecordingThreadCount(threads);
+
+			RenderGraph rg;
+			const RenderGraphResource_t bb = rg.AddExternalRTV("Backbuffer", backBuffer, 1280, 720);
+
+			for (u32 i = 0; i < 8; i++)
+				rg.AddPass("Draw" + std::to_string(i), RenderPassType::GRAPHICS).AddRenderTarget(bb, RenderPassOutputAccess::LOAD).MakeRoot().SetExecuteCallback(Nop);
+
+			rg.Build();
+
+			const size_t executes = Null_GetCounters().commandListExecutes;
+			rg.Execute();
+
+			Check(Null_GetCounters().commandListExecutes - executes == threads, "target binds", "graph submitted %zu command lists", Null_GetCounters().commandListExecutes - executes);
+			Check(rg.GetStats().targetBinds == threads, "target binds", "graph bound targets %zu times", rg.GetStats().targetBinds);
+		}
+
+		RenderGraph_SetRecordingThreadCount(0);
+		RenderGraph_ReleasePools();
+	}
+
+	// Depth, then AO on the async queue reading it while lighting runs, and a simulation subgraph
+	// with no dependency on graphics work. The schedule is run on simulated queues with fixed pass
+	// costs, with and without async compute.
+	struct AsyncScheduleResult
+	{
+		RenderGraphSchedule schedule;
+		RenderGraphStats stats;
+		RenderGraphScheduleTiming timing;
+	};
+
+	AsyncScheduleResult RunAsyncScheduleGraph(RenderTargetView_t backBuffer)
+	{
+		RenderGraph rg;
+		const RenderGraphResource_t bb = rg.AddExternalRTV("Backbuffer", backBuffer, 1280, 720);
+
+		RenderGraphTextureDesc desc;
+		desc.width = 640;
+		desc.height = 360;
+		desc.format = RenderFormat::D32_FLOAT;
+		const RenderGraphResource_t depth = rg.RegisterTexture("Depth", desc);
+
+		desc.format = RenderFormat::R16G16B16A16_FLOAT;
+		const RenderGraphResource_t color = rg.RegisterTexture("Color", desc);
+		const RenderGraphResource_t ao = rg.RegisterTexture("AO", desc);
+		const RenderGraphResource_t simA = rg.RegisterTexture("SimA", desc);
+		const RenderGraphResource_t simB = rg.RegisterTexture("SimB", desc);
+
+		rg.AddPass("Depth", RenderPassType::GRAPHICS).AddDepthTarget(depth, RenderPassOutputAccess::CLEAR).SetExecuteCallback(Nop);
+		rg.AddPass("AO", RenderPassType::COMPUTE).AddComputeTarget(ao, RenderPassOutputAccess::DONT_CARE).ReadResource(depth).MakeAsyncCompute().SetExecuteCallback(Nop);
+		rg.AddPass("SimA", RenderPassType::COMPUTE).AddComputeTarget(simA, RenderPassOutputAccess::DONT_CARE).SetExecuteCallback(Nop);
+		rg.AddPass("Lighting", RenderPassType::GRAPHICS).AddRenderTarget(color, RenderPassOutputAccess::CLEAR).AddDepthTarget(depth, RenderPassOutputAccess::LOAD).SetExecuteCallback(Nop);
+		rg.AddPass("SimB", RenderPassType::COMPUTE).AddComputeTarget(simB, RenderPassOutputAccess::DONT_CARE).ReadResource(simA).MakeRoot().SetExecuteCallback(Nop);
+		rg.AddPass("Combine", RenderPassType::COMPUTE).AddComputeTarget(color, RenderPassOutputAccess::LOAD).ReadResource(ao).SetExecuteCallback(Nop);
+		rg.AddPass("Resolve", RenderPassType::GRAPHICS).AddRenderTarget(bb, RenderPassOutputAccess::LOAD).ReadResource(color).MakeRoot().SetExecuteCallback(Nop);
+
+		rg.Build();
+		rg.Execute();
+
+		const float passCosts[] = { 1.0f, 3.0f, 2.0f, 4.0f, 2.0f, 1.0f, 1.0f };
+
+		AsyncScheduleResult result;
+		result.schedule = rg.GetSchedule();
+		result.stats = rg.GetStats();
+		result.timing = RenderGraph_SimulateSchedule(result.schedule, passCosts);
+		return result;
+	}
+
+	void CheckAsyncSchedule(RenderTargetView_t backBuffer)
+	{
+		constexpr RenderGraphQueue G = RenderGraphQueue::GRAPHICS;
+		constexpr RenderGraphQueue A = RenderGraphQueue::ASYNC_COMPUTE;
+
+		RenderGraph_SetAsyncCompute(true);
+		const AsyncScheduleResult async = RunAsyncScheduleGraph(backBuffer);
+
+		// AO is marked async and SimA and SimB form their own subgraph. Combine follows lighting on the
+		// graphics queue.
+		const std::vector<RenderGraphQueue> asyncQueues = { G, A, A, G, A, G, G };
+		Check(async.schedule.passQueues == asyncQueues, "async schedule", "queue assignment differs for %zu passes", async.schedule.passQueues.size());
+		Check(async.stats.asyncComputePasses == 3, "async schedule", "%zu passes on the async queue, expected 3", async.stats.asyncComputePasses);
+		Check(async.stats.subgraphs == 2, "async schedule", "graph has %zu subgraphs, expected 2", async.stats.subgraphs);
+
+		// AO waits for depth and lighting waits for AO before overwriting depth. Combine reading AO is
+		// covered by the lighting wait.
+		const bool syncs = async.schedule.syncPoints.size() == 2
+			&& async.schedule.syncPoints[0].signalPass == 0 && async.schedule.syncPoints[0].waitPass == 1
+			&& async.schedule.syncPoints[1].signalPass == 1 && async.schedule.syncPoints[1].waitPass == 3;
+		Check(syncs, "async schedule", "graph has %zu sync points, expected depth to AO and AO to lighting", async.schedule.syncPoints.size());
+		Check(async.stats.syncPoints == 2, "async schedule", "stats report %zu sync points, expected 2", async.stats.syncPoints);
+
+		// Graphics runs depth 0-1, lighting 4-8 after AO, combine and resolve 8-10. The async queue runs
+		// AO 1-4 then the simulation 4-8, overlapping lighting. Depth, AO, lighting, combine and resolve
+		// are the critical path.
+		CheckTime(async.timing.serialTime, 14.0f, "async schedule", "serial time");
+		CheckTime(async.timing.scheduledTime, 10.0f, "async schedule", "scheduled time");
+		CheckTime(async.timing.overlapTime, 4.0f, "async schedule", "overlap time");
+		CheckTime(async.timing.criticalPathTime, 10.0f, "async schedule", "critical path time");
+
+		RenderGraph_SetAsyncCompute(false);
+		const AsyncScheduleResult serial = RunAsyncScheduleGraph(backBuffer);
+		RenderGraph_SetAsyncCompute(true);
+
+		const std::vector<RenderGraphQueue> serialQueues(7, G);
+		Check(serial.schedule.passQueues == serialQueues, "async schedule", "queue assignment differs for %zu passes without async compute", serial.schedule.passQueues.size());
+		Check(serial.schedule.syncPoints.empty(), "async schedule", "graph has %zu sync points without async compute", serial.schedule.syncPoints.size());
+		CheckTime(serial.timing.scheduledTime, 14.0f, "async schedule", "scheduled time without async compute");
+		CheckTime(serial.timing.overlapTime, 0.0f, "async schedule", "overlap time without async compute");
+
+		RenderGraph_ReleasePools();
+	}
+
+	// A scene, bloom down and up chain, tonemap and resolve. Every barrier the graph issues must match
+	// the state the null backend tracked for the texture, serial and recorded on worker threads.
+	void CheckBarriers(RenderTargetView_t backBuffer)
+	{
+		for (u32 threads : { 1u, 4u })
+		{
+			RenderGraph_SetRecordingThreadCount(threads);
+
+			for (u32 frame = 0; frame < 3; frame++)
+			{
+				RenderGraph rg;
+				const RenderGraphResource_t bb = rg.AddExternalRTV("Backbuffer", backBuffer, 1280, 720);
+
+				RenderGraphTextureDesc desc;
+				desc.width = 1280;
+				desc.height = 720;
+				desc.format = RenderFormat::D32_FLOAT;
+				const RenderGraphResource_t depth = rg.RegisterTexture("Depth", desc);
+
+				desc.format = RenderFormat::R16G16B16A16_FLOAT;
+				const RenderGraphResource_t color = rg.RegisterTexture("Color", desc);
+
+				RenderGraphResource_t bloom[4];
+				for (u32 i = 0; i < 4; i++)
+				{
+					desc.width /= 2;
+					desc.height /= 2;
+					bloom[i] = rg.RegisterTexture("Bloom" + std::to_string(i), desc);
+				}
+
+				rg.AddPass("Scene", RenderPassType::GRAPHICS).AddRenderTarget(color, RenderPassOutputAccess::CLEAR).AddDepthTarget(depth, RenderPassOutputAccess::CLEAR).SetExecuteCallback(Nop);
+				for (u32 i = 0; i < 4; i++)
+					rg.AddPass("Down" + std::to_string(i), RenderPassType::COMPUTE).AddComputeTarget(bloom[i], RenderPassOutputAccess::DONT_CARE).ReadResource(i ? bloom[i - 1] : color).SetExecuteCallback(Nop);
+				for (u32 i = 3; i > 0; i--)
+					rg.AddPass("Up" + std::to_string(i), RenderPassType::COMPUTE).AddComputeTarget(bloom[i - 1], RenderPassOutputAccess::DONT_CARE).ReadResource(bloom[i]).SetExecuteCallback(Nop);
+				rg.AddPass("Apply", RenderPassType::COMPUTE).AddComputeTarget(color, RenderPassOutputAccess::LOAD).ReadResource(bloom[0]).SetExecuteCallback(Nop);
+				rg.AddPass("Resolve", RenderPassType::GRAPHICS).AddRenderTarget(bb, RenderPassOutputAccess::LOAD).ReadResource(color).MakeRoot().SetExecuteCallback(Nop);
+
+				rg.Build();
+
+				const NullRenderCounters before = Null_GetCounters();
+				rg.Execute();
+				const NullRenderCounters& after = Null_GetCounters();
+
+				Check(rg.GetStats().barriers > 0, "barriers", "graph issued %zu barriers", rg.GetStats().barriers);
+				Check(after.barriers - before.barriers == rg.GetStats().barriers, "barriers", "backend executed %zu barriers, graph issued a different count", after.barriers - before.barriers);
+				Check(after.invalidBarriers == before.invalidBarriers, "barriers", "backend rejected %zu barriers", after.invalidBarriers - before.invalidBarriers);
+			}
+		}
+
+		RenderGraph_SetRecordingThreadCount(0);
+		RenderGraph_ReleasePools();
+
+		// The backend catches a barrier whose before state doesn't match, per subresource.
+		TextureCreateDescEx desc = {};
+		desc.width = 4;
+		desc.height = 4;
+		desc.mipCount = 2;
+		desc.arraySize = 1;
+		desc.resourceFormat = RenderFormat::R8G8B8A8_UNORM;
+		desc.dimension = TextureDimension::Tex2D;
+		desc.flags = RenderResourceFlags::SRV;
+		const Texture_t tex = CreateTextureEx(desc);
+
+		ResourceBarrier barriers[3];
+		barriers[0].texture = tex;
+		barriers[0].subresource = 1;
+		barriers[0].before = ResourceState::Common;
+		barriers[0].after = ResourceState::CopyDest;
+		barriers[1] = barriers[0];
+		barriers[1].after = ResourceState::ShaderResource;
+		barriers[2].texture = tex;
+		barriers[2].before = ResourceState::Common;
+		barriers[2].after = ResourceState::ShaderResource;
+
+		const size_t invalid = Null_GetCounters().invalidBarriers;
+
+		CommandListPtr cl = CommandList::Create();
+		cl->ResourceBarriers(barriers, 3);
+		CommandList::Execute(cl);
+
+		// Mip 1 is CopyDest when the second barrier and the all subresources barrier run.
+		Check(Null_GetCounters().invalidBarriers - invalid == 2, "barriers", "backend rejected %zu of 2 bad barriers", Null_GetCounters().invalidBarriers - invalid);
+
+		Render_Release(tex);
+	}
+}
+
+int RenderGraph_RunChecks()
+{
+	g_failures = 0;
+
+	RenderViewPtr view = CreateRenderViewPtr(0);
+	view->Resize(1280, 720);
+
+	const RenderTargetView_t backBuffer = view->GetCurrentBackBufferRTV();
+
+	CheckAliasing(backBuffer);
+	CheckViews(backBuffer);
+	CheckSubresourceCache(backBuffer);
+	CheckTargetBinds(backBuffer);
+	CheckAsyncSchedule(backBuffer);
+	CheckBarriers(backBuffer);
+
+	return g_failures;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// Graphs run on the null backend whose results are checked against its counters: transient aliasing
+// by texture creates, per view instancing by physical texture counts, compile caching of subresource
+// ranges by the cache stats, target bind elision by the bind stats, async compute scheduling on
+// simulated queues and barrier tracking by the barriers the backend rejects. Logs each failure and
+// returns how many checks failed.
+int RenderGraph_RunChecks();
@@ -0,0 +1,60 @@
+// Runs the RenderGraph on the null backend without a window or device, for profiling on headless machines.
+//
+// RenderGraphHeadless benchmark    Build time of graphs from 10 to 10,000 passes.
+// RenderGraphHeadless checks       Verifies aliasing, views and barriers against the null backend counters,
+//                                  and CommandList bind caching against the binds the backend receives.
+
+#include "CommandListChecks.h"
+#include "RenderGraphChecks.h"
+
+#include "Render/Render.h"
+#include "Utils/RenderGraph/RenderGraphBenchmark.h"
+
+#include <cstdio>
+#include <cstring>
+
+static int RunBenchmark()
+{
+	std::vector<RenderGraphBenchmarkResult> results;
+	RenderGraph_RunScalingBenchmark(results);
+
+	printf("%8s %12s %10s %10s\n", "passes", "build ms", "transient", "physical");
+	for (const RenderGraphBenchmarkResult& result : results)
+		printf("%8u %12.3f %10u %10u\n", result.passes, result.buildMs, result.transientTextures, result.physicalTextures);
+
+	return 0;
+}
+
+static int RunChecks()
+{
+	const int failures = CommandList_RunChecks() + RenderGraph_RunChecks();
+	if (failures)
+	{
+		fprintf(stderr, "%d checks failed\n", failures);
+		return 1;
+	}
+
+	printf("CommandList and RenderGraph checks passed\n");
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	const char* command = argc > 1 ? argv[1] : "benchmark";
+
+	if (!Render_Init())
+		return 1;
+
+	int result = 2;
+	if (strcmp(command, "benchmark") == 0)
+		result = RunBenchmark();
+	else if (strcmp(command, "checks") == 0)
+		result = RunChecks();
+	else
+		fprintf(stderr, "Unknown command '%s', expected benchmark or checks\n", command);
+
+	RenderGraph_ReleasePools();
+	Render_ShutDown();
+
+	return result;
+}
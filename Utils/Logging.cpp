@@ -3,7 +3,19 @@
 #include <cassert>
 #include <stdio.h>
 #include <stdarg.h>
+
+#ifdef _WIN32
 #include <Windows.h>
+#define PlatformOutputString(str) OutputDebugStringA(str)
+#define PlatformDebugBreak() __debugbreak()
+#else
+#include <signal.h>
+#include <string.h>
+#define vsprintf_s(buf, fmt, ap) vsnprintf(buf, sizeof(buf), fmt, ap)
+#define strcat_s(buf, str) strncat(buf, str, sizeof(buf) - strlen(buf) - 1)
+#define PlatformOutputString(str) fputs(str, stderr)
+#define PlatformDebugBreak() raise(SIGTRAP)
+#endif
 
 typedef void (*LogFunc) (const char* str);
 
@@ -28,27 +40,27 @@ typedef void (*LogFunc) (const char* str);
 
 void LogFatal(const char* str)
 {
-	OutputDebugStringA(str);
+	PlatformOutputString(str);
 }
 
 void LogError(const char* str)
 {
-	OutputDebugStringA(str);
+	PlatformOutputString(str);
 }
 
 void LogWarning(const char* str)
 {
-	OutputDebugStringA(str);
+	PlatformOutputString(str);
 }
 
 void LogInfo(const char* str)
 {
-	OutputDebugStringA(str);
+	PlatformOutputString(str);
 }
 
 void LogDebug(const char* str)
 {
-	OutputDebugStringA(str);
+	PlatformOutputString(str);
 }
 
 void _LogFatalfLF(const char* fmt, ...)
@@ -81,7 +93,7 @@ bool _EnsureMsg(bool condition, const char * fmt, ...)
 	if (condition == false)
 	{		
 		PlatformFormatLogMessageLf(LogError);
-		__debugbreak();
+		PlatformDebugBreak();
 	}
 	return condition;
 }
@@ -91,7 +103,7 @@ void _AssertMsg(bool condition, const char* fmt, ...)
 	if (condition == false)
 	{
 		PlatformFormatLogMessageLf(LogFatal);
-		__debugbreak();
+		PlatformDebugBreak();
 		assert(0);
 	}
 }
@@ -4,473 +4,2488 @@
 #include "Utils/Logging.h"
 
 #include <algorithm>
-#include <array>
-#include <bitset>
-#include <unordered_set>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
 
 #define RG_VALIDATION 1
 
-constexpr size_t RG_MAX_RESOURCES = 1024u;
-using RGResourceBits = std::bitset<RG_MAX_RESOURCES>;
+// Description of a physical texture, textures are only shared between graphs on an exact match.
+struct RGTextureKey
+{
+	RenderFormat format = RenderFormat::UNKNOWN;
+	u32 width = 0;
+	u32 height = 0;
+	u32 mipCount = 1;
+	u32 arraySize = 1;
+	RenderResourceFlags flags = RenderResourceFlags::None;
+
+	bool operator==(const RGTextureKey& other) const
+	{
+		return format == other.format && width == other.width && height == other.height && mipCount == other.mipCount && arraySize == other.arraySize && flags == other.flags;
+	}
+};
+
+struct RGTextureKeyHash
+{
+	size_t operator()(const RGTextureKey& key) const noexcept
+	{
+		const uint64_t dims = ((uint64_t)key.width << 32) | key.height;
+		const uint64_t layout = ((uint64_t)key.format << 32) | ((uint64_t)key.flags << 24) | ((uint64_t)key.mipCount << 16) | key.arraySize;
+
+		size_t hash = std::hash<uint64_t>{}(dims);
+		hash ^= std::hash<uint64_t>{}(layout) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		return hash;
+	}
+};
+
+static size_t GetTextureBytes(const RGTextureKey& key)
+{
+	size_t bytes = 0;
+
+	for (u32 mip = 0; mip < key.mipCount; mip++)
+	{
+		size_t mipBytes = 0;
+		Textures_GetSurfaceInfo(Max(key.width >> mip, 1u), Max(key.height >> mip, 1u), key.format, &mipBytes);
+		bytes += mipBytes;
+	}
+
+	return bytes * key.arraySize;
+}
+
+// Description of a physical buffer, buffers are only shared between graphs on an exact match.
+struct RGBufferKey
+{
+	u32 elementSize = 0;
+	u32 elementCount = 0;
+	RenderResourceFlags flags = RenderResourceFlags::None;
+
+	bool operator==(const RGBufferKey& other) const
+	{
+		return elementSize == other.elementSize && elementCount == other.elementCount && flags == other.flags;
+	}
+};
+
+struct RGBufferKeyHash
+{
+	size_t operator()(const RGBufferKey& key) const noexcept
+	{
+		return std::hash<uint64_t>{}(((uint64_t)key.elementSize << 40) | ((uint64_t)key.flags << 32) | key.elementCount);
+	}
+};
+
+static size_t GetBufferBytes(const RGBufferKey& key)
+{
+	return (size_t)key.elementSize * key.elementCount;
+}
+
+// Pooled structured buffers keep their views, buffers have no default views to fetch like textures.
+struct RGPooledBuffer
+{
+	StructuredBuffer_t buf = StructuredBuffer_t::INVALID;
+	ShaderResourceView_t srv = ShaderResourceView_t::INVALID;
+	UnorderedAccessView_t uav = UnorderedAccessView_t::INVALID;
+};
+
+static size_t GetPooledBytes(const RGTextureKey& key) { return GetTextureBytes(key); }
+static size_t GetPooledBytes(const RGBufferKey& key) { return GetBufferBytes(key); }
+
+static bool IsPooledValid(Texture_t tex) { return tex != Texture_t::INVALID; }
+static bool IsPooledValid(const RGPooledBuffer& buffer) { return buffer.buf != StructuredBuffer_t::INVALID; }
+
+static void CreatePooled(const RGTextureKey& key, Texture_t& tex)
+{
+	TextureCreateDescEx desc = {};
+	desc.width = key.width;
+	desc.height = key.height;
+	desc.mipCount = key.mipCount;
+	desc.arraySize = key.arraySize;
+	desc.flags = key.flags;
+	desc.dimension = TextureDimension::Tex2D;
+	desc.resourceFormat = key.format;
+	desc.srvFormat = key.format;
+	desc.uavFormat = key.format;
+	desc.rtvFormat = key.format;
+	desc.dsvFormat = key.format;
+
+	tex = CreateTextureEx(desc);
+}
+
+static void CreatePooled(const RGBufferKey& key, RGPooledBuffer& buffer)
+{
+	buffer.buf = CreateStructuredBuffer(nullptr, GetBufferBytes(key), key.elementSize, key.flags);
+	if (buffer.buf == StructuredBuffer_t::INVALID)
+		return;
+
+	if ((key.flags & RenderResourceFlags::SRV) != RenderResourceFlags::None)
+		buffer.srv = CreateStructuredBufferSRV(buffer.buf, 0, key.elementCount);
+
+	if ((key.flags & RenderResourceFlags::UAV) != RenderResourceFlags::None)
+		buffer.uav = CreateStructuredBufferUAV(buffer.buf, 0, key.elementCount);
+}
+
+// Range clamped to a texture with mipCount mips and sliceCount slices, with the counts resolved.
+static RenderGraphSubresourceRange ResolveSubresources(const RenderGraphSubresourceRange& range, u32 mipCount, u32 sliceCount)
+{
+	RenderGraphSubresourceRange resolved;
+	resolved.firstMip = Min(range.firstMip, mipCount - 1);
+	resolved.mipCount = Min(range.mipCount, mipCount - resolved.firstMip);
+	resolved.firstSlice = Min(range.firstSlice, sliceCount - 1);
+	resolved.sliceCount = Min(range.sliceCount, sliceCount - resolved.firstSlice);
+	return resolved;
+}
+
+// Only valid for resolved ranges, each field must fit in 16 bits.
+static uint64_t GetSubresourceKey(const RenderGraphSubresourceRange& resolved)
+{
+	return ((uint64_t)resolved.firstMip << 48) | ((uint64_t)resolved.mipCount << 32) | ((uint64_t)resolved.firstSlice << 16) | resolved.sliceCount;
+}
+
+static bool SubresourcesOverlap(const RenderGraphSubresourceRange& a, const RenderGraphSubresourceRange& b)
+{
+	auto Overlap = [](u32 firstA, u32 countA, u32 firstB, u32 countB)
+	{
+		const uint64_t endA = countA == ~0u ? UINT64_MAX : (uint64_t)firstA + countA;
+		const uint64_t endB = countB == ~0u ? UINT64_MAX : (uint64_t)firstB + countB;
+		return firstA < endB && firstB < endA;
+	};
+
+	return Overlap(a.firstMip, a.mipCount, b.firstMip, b.mipCount) && Overlap(a.firstSlice, a.sliceCount, b.firstSlice, b.sliceCount);
+}
+
+// Views of subresource ranges of a pooled texture, created by Build for the ranges passes access
+// and released with the texture. The key packs the resolved range, see GetSubresourceKey.
+struct RGSubresourceView
+{
+	uint64_t key = 0;
+	ShaderResourceView_t srv = ShaderResourceView_t::INVALID;
+	RenderTargetView_t rtv = RenderTargetView_t::INVALID;
+	DepthStencilView_t dsv = DepthStencilView_t::INVALID;
+	UnorderedAccessView_t uav = UnorderedAccessView_t::INVALID;
+};
+
+std::unordered_map<Texture_t, std::vector<RGSubresourceView>> g_subresourceViews;
+
+static void ReleasePooled(Texture_t tex)
+{
+	auto it = g_subresourceViews.find(tex);
+	if (it != g_subresourceViews.end())
+	{
+		for (const RGSubresourceView& view : it->second)
+		{
+			if (view.srv != ShaderResourceView_t::INVALID)
+				Render_Release(view.srv);
+			if (view.rtv != RenderTargetView_t::INVALID)
+				Render_Release(view.rtv);
+			if (view.dsv != DepthStencilView_t::INVALID)
+				Render_Release(view.dsv);
+			if (view.uav != UnorderedAccessView_t::INVALID)
+				Render_Release(view.uav);
+		}
+
+		g_subresourceViews.erase(it);
+	}
+
+	Render_Release(tex);
+}
+
+static void ReleasePooled(const RGPooledBuffer& buffer)
+{
+	if (buffer.srv != ShaderResourceView_t::INVALID)
+		Render_Release(buffer.srv);
+
+	if (buffer.uav != UnorderedAccessView_t::INVALID)
+		Render_Release(buffer.uav);
+
+	Render_Release(buffer.buf);
+}
+
+// Physical resources outlive the graph that created them, graphs are rebuilt every frame and pick
+// up the resources the previous frame returned. Idle resources are released once they have not been
+// used for maxFrameAge graph builds, or oldest first while the pool is over its memory budget.
+template<typename Key, typename KeyHash, typename Resource>
+struct RGResourcePool
+{
+	struct PooledResource
+	{
+		Resource resource = {};
+		uint64_t lastUsedFrame = 0;
+	};
+
+	std::unordered_map<Key, std::vector<PooledResource>, KeyHash> idleResources;
+
+	uint64_t frame = 0;
+	size_t budget = 256ull * 1024 * 1024;
+
+	RenderGraphPoolStats stats;
+
+	Resource Acquire(const Key& key)
+	{
+		auto it = idleResources.find(key);
+		if (it != idleResources.end() && !it->second.empty())
+		{
+			const Resource resource = it->second.back().resource;
+			it->second.pop_back();
+
+			stats.idleResources--;
+			stats.idleBytes -= GetPooledBytes(key);
+
+			return resource;
+		}
+
+		Resource created = {};
+		CreatePooled(key, created);
+
+#if RG_VALIDATION
+		ASSERTMSG(IsPooledValid(created), "RGResourcePool::Acquire failed to create resource");
+#endif
+
+		if (IsPooledValid(created))
+		{
+			stats.resources++;
+			stats.bytes += GetPooledBytes(key);
+			stats.creates++;
+		}
+
+		return created;
+	}
+
+	void Return(const Key& key, const Resource& resource)
+	{
+		if (!IsPooledValid(resource))
+			return;
+
+		idleResources[key].push_back({ resource, frame });
+
+		stats.idleResources++;
+		stats.idleBytes += GetPooledBytes(key);
+	}
+
+	void Destroy(const Key& key, const Resource& resource)
+	{
+		ReleasePooled(resource);
+
+		const size_t bytes = GetPooledBytes(key);
+
+		stats.resources--;
+		stats.bytes -= bytes;
+		stats.idleResources--;
+		stats.idleBytes -= bytes;
+		stats.releases++;
+	}
+
+	void Evict(u32 maxAge, size_t maxBytes)
+	{
+		for (auto& [key, resources] : idleResources)
+		{
+			auto expired = std::remove_if(resources.begin(), resources.end(), [&](const PooledResource& pooled)
+			{
+				if (frame - pooled.lastUsedFrame <= maxAge)
+					return false;
+
+				Destroy(key, pooled.resource);
+				return true;
+			});
+
+			resources.erase(expired, resources.end());
+		}
+
+		while (stats.bytes > maxBytes && stats.idleResources > 0)
+		{
+			auto oldestKey = idleResources.end();
+			size_t oldestIdx = 0;
+
+			for (auto it = idleResources.begin(); it != idleResources.end(); it++)
+			{
+				for (size_t i = 0; i < it->second.size(); i++)
+				{
+					if (oldestKey == idleResources.end() || it->second[i].lastUsedFrame < oldestKey->second[oldestIdx].lastUsedFrame)
+					{
+						oldestKey = it;
+						oldestIdx = i;
+					}
+				}
+			}
+
+			Destroy(oldestKey->first, oldestKey->second[oldestIdx].resource);
+			oldestKey->second.erase(oldestKey->second.begin() + oldestIdx);
+		}
+	}
+};
+
+RGResourcePool<RGTextureKey, RGTextureKeyHash, Texture_t> g_texturePool;
+RGResourcePool<RGBufferKey, RGBufferKeyHash, RGPooledBuffer> g_bufferPool;
+u32 g_poolMaxFrameAge = 8;
+
+static RGTextureKey MakeTextureKey(const RenderGraphTextureDesc& desc, RenderResourceFlags flags)
+{
+	RGTextureKey key;
+	key.format = desc.format;
+	key.width = desc.width;
+	key.height = desc.height;
+	key.mipCount = desc.mipCount;
+	key.arraySize = desc.arraySize;
+	key.flags = flags;
+	return key;
+}
+
+static RGBufferKey MakeBufferKey(const RenderGraphBufferDesc& desc, RenderResourceFlags flags)
+{
+	RGBufferKey key;
+	key.elementSize = desc.elementSize;
+	key.elementCount = desc.elementCount;
+	key.flags = flags;
+	return key;
+}
+
+void RenderGraph_SetTexturePoolBudget(size_t bytes)
+{
+	g_texturePool.budget = bytes;
+}
+
+void RenderGraph_SetBufferPoolBudget(size_t bytes)
+{
+	g_bufferPool.budget = bytes;
+}
+
+void RenderGraph_SetPoolMaxFrameAge(u32 frames)
+{
+	g_poolMaxFrameAge = frames;
+}
+
+void RenderGraph_ReleasePools()
+{
+	g_texturePool.Evict(0, 0);
+	g_bufferPool.Evict(0, 0);
+}
+
+const RenderGraphPoolStats& RenderGraph_GetTexturePoolStats()
+{
+	return g_texturePool.stats;
+}
+
+const RenderGraphPoolStats& RenderGraph_GetBufferPoolStats()
+{
+	return g_bufferPool.stats;
+}
+
+// Persistent worker threads used by RenderGraph::Execute to record passes in parallel. The calling
+// thread takes part in every job so a pool of N threads gives N + 1 way parallelism.
+struct RGWorkerPool
+{
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+
+	const std::function<void(size_t)>* job = nullptr;
+	size_t jobCount = 0;
+	std::atomic<size_t> nextIndex = 0;
+	size_t busyWorkers = 0;
+	uint64_t generation = 0;
+	bool quit = false;
+
+	~RGWorkerPool()
+	{
+		Resize(0);
+	}
+
+	void RunJob()
+	{
+		for (size_t i = nextIndex++; i < jobCount; i = nextIndex++)
+			(*job)(i);
+	}
+
+	void WorkerMain()
+	{
+		uint64_t seenGeneration = 0;
+
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&] { return quit || generation != seenGeneration; });
+
+				if (quit)
+					return;
+
+				seenGeneration = generation;
+			}
+
+			RunJob();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (--busyWorkers == 0)
+					done.notify_one();
+			}
+		}
+	}
+
+	void Resize(size_t count)
+	{
+		if (count == threads.size())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		wake.notify_all();
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		threads.clear();
+		quit = false;
+		generation = 0;
+
+		for (size_t i = 0; i < count; i++)
+			threads.emplace_back([this] { WorkerMain(); });
+	}
+
+	void ParallelFor(size_t count, const std::function<void(size_t)>& func)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = &func;
+			jobCount = count;
+			nextIndex = 0;
+			busyWorkers = threads.size();
+			generation++;
+		}
+		wake.notify_all();
+
+		RunJob();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [&] { return busyWorkers == 0; });
+
+		job = nullptr;
+	}
+};
+
+RGWorkerPool g_workerPool;
+u32 g_recordingThreadCount = 0;
+bool g_transientAliasing = true;
+bool g_compiledGraphCaching = true;
+bool g_asyncCompute = true;
+bool g_passReordering = false;
+bool g_passTiming = false;
+
+void RenderGraph_SetRecordingThreadCount(u32 count)
+{
+	g_recordingThreadCount = count;
+}
+
+void RenderGraph_SetTransientAliasing(bool enabled)
+{
+	g_transientAliasing = enabled;
+}
+
+void RenderGraph_SetCompileCaching(bool enabled)
+{
+	g_compiledGraphCaching = enabled;
+}
+
+bool RenderGraph_GetCompileCaching()
+{
+	return g_compiledGraphCaching;
+}
+
+void RenderGraph_SetAsyncCompute(bool enabled)
+{
+	g_asyncCompute = enabled;
+}
+
+void RenderGraph_SetPassReordering(bool enabled)
+{
+	g_passReordering = enabled;
+}
+
+void RenderGraph_SetPassTiming(bool enabled)
+{
+	g_passTiming = enabled;
+}
+
+static u32 GetRecordingThreadCount()
+{
+	if (g_recordingThreadCount > 0)
+		return g_recordingThreadCount;
+
+	const u32 hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 0 ? hardwareThreads : 1u;
+}
+
+RenderPass& RenderPass::SetExecuteCallback(RenderGraphCallback_Func&& func)
+{
+	_function = func;
+
+	return *this;
+}
+
+RenderPass& RenderPass::MakeAsyncCompute()
+{
+	ASSERTMSG(_type == RenderPassType::COMPUTE, "RenderPass::MakeAsyncCompute failed, only compute passes can run on the async compute queue");
+
+	_asyncCompute = _type == RenderPassType::COMPUTE;
+
+	return *this;
+}
+
+void RenderPass::AssertResourceUnique(RenderGraphResource_t res, const RenderGraphSubresourceRange& subresources)
+{
+	ASSERTMSG(std::find_if(_resources.begin(), _resources.end(), [res, &subresources](const RenderPassResource& a) {return a._resourceHandle == res && SubresourcesOverlap(a._subresources, subresources); }) == _resources.end(),
+		"RenderPass::AssertResourceUnique failed, adding the same subresources twice");
+}
+
+RenderPass& RenderPass::AddResource(RenderGraphResource_t resource, RenderPassOutputAccess access, RenderResourceFlags flags, const RenderGraphSubresourceRange& subresources)
+{
+	AssertResourceUnique(resource, subresources);
+
+	RenderPassResourceAccess ra = RenderPassResourceAccess::WRITE;
+
+	if (access == RenderPassOutputAccess::LOAD)
+		ra |= RenderPassResourceAccess::READ;
+
+	_resources.emplace_back(resource, ra, flags, access, subresources);
+
+	return *this;
+}
+
+RenderPass& RenderPass::AddRenderTarget(RenderGraphResource_t resource, RenderPassOutputAccess access, const RenderGraphSubresourceRange& subresources)
+{
+	return AddResource(resource, access, RenderResourceFlags::RTV, subresources);
+}
+
+RenderPass& RenderPass::AddDepthTarget(RenderGraphResource_t resource, RenderPassOutputAccess access, const RenderGraphSubresourceRange& subresources)
+{
+	return AddResource(resource, access, RenderResourceFlags::DSV, subresources);
+}
+
+RenderPass& RenderPass::AddComputeTarget(RenderGraphResource_t resource, RenderPassOutputAccess access, const RenderGraphSubresourceRange& subresources)
+{
+	return AddResource(resource, access, RenderResourceFlags::UAV, subresources);
+}
+
+RenderPass& RenderPass::ReadResource(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources)
+{
+	AssertResourceUnique(resource, subresources);
+
+	_resources.emplace_back(resource, RenderPassResourceAccess::READ, RenderResourceFlags::SRV, RenderPassOutputAccess::LOAD, subresources);
+
+	return *this;
+}
+
+RenderGraphResource_t RenderGraph::RegisterTexture(const std::string& name, const RenderGraphTextureDesc& desc)
+{
+	const std::string scopedName = GetScopedName(name);
+
+	if (_registeredResourceMap.count(scopedName))
+	{
+		LOGERROR("RenderGraph::RegisterTexture: %s is already registered", scopedName.c_str());
+		return RenderGraphResource_t::NONE;
+	}
+
+	const RenderGraphResource_t handle = (RenderGraphResource_t)_registeredResources.size();
+	_registeredResourceMap[scopedName] = handle;
+
+	_registeredResources.push_back({});
+
+	RenderGraphRegisteredResource& res = _registeredResources.back();
+
+	res.flags = RenderResourceFlags::None;
+	res.type = RenderGraphResourceType::TEXTURE;
+
+	res.texture = desc;
+
+	return handle;
+}
+
+RenderGraphResource_t RenderGraph::RegisterBuffer(const std::string& name, const RenderGraphBufferDesc& desc)
+{
+	const std::string scopedName = GetScopedName(name);
+
+	if (_registeredResourceMap.count(scopedName))
+	{
+		LOGERROR("RenderGraph::RegisterBuffer: %s is already registered", scopedName.c_str());
+		return RenderGraphResource_t::NONE;
+	}
+
+	const RenderGraphResource_t handle = (RenderGraphResource_t)_registeredResources.size();
+	_registeredResourceMap[scopedName] = handle;
+
+	_registeredResources.push_back({});
+
+	RenderGraphRegisteredResource& res = _registeredResources.back();
+
+	res.flags = RenderResourceFlags::None;
+	res.type = RenderGraphResourceType::BUFFER;
+
+	res.buffer = desc;
+
+	return handle;
+}
+
+RenderGraphResource_t RenderGraph::AddExternalRTV(const std::string& name, RenderTargetView_t rtv, u32 width, u32 height)
+{
+	const std::string scopedName = GetScopedName(name);
+
+	if (_registeredResourceMap.count(scopedName))
+	{
+		LOGERROR("RenderGraph::AddExternalRTV: %s is already registered", scopedName.c_str());
+		return RenderGraphResource_t::NONE;
+	}
+
+	const RenderGraphResource_t handle = (RenderGraphResource_t)_registeredResources.size();
+	_registeredResourceMap[scopedName] = handle;
+
+	_registeredResources.push_back({});
+
+	_registeredResources.back().external = true;
+
+	// Insert the rtv into the finalised resource array
+	if ((size_t)handle >= _resources.size())
+	{
+		_resources.resize((size_t)handle + 1, {});
+		_resources.back().rtv = rtv;
+		_resources.back().texture.dimensions.x = width;
+		_resources.back().texture.dimensions.y = height;
+	}
+
+	return handle;
+}
+
+RenderPass& RenderGraph::AddPass(const std::string& name, RenderPassType type)
+{
+	_passes.emplace_back( RenderPass::Make(GetScopedName(name), type) );
+	_passes.back()._view = _currentView;
+	return _passes.back();
+}
+
+void RenderGraph::AddViews(const std::vector<std::string>& viewNames, const RenderGraphViewSetup_Func& setup)
+{
+	ASSERTMSG(_currentView == ~0u, "RenderGraph::AddViews: Views can't be added from a view setup");
+
+	for (const std::string& viewName : viewNames)
+	{
+		if (std::find(_viewNames.begin(), _viewNames.end(), viewName) != _viewNames.end())
+		{
+			LOGERROR("RenderGraph::AddViews: view %s is already added", viewName.c_str());
+			continue;
+		}
+
+		RenderGraphView view;
+		view.name = viewName;
+		view.index = (u32)_viewNames.size();
+
+		_viewNames.push_back(viewName);
+
+		_currentView = view.index;
+		setup(*this, view);
+		_currentView = ~0u;
+	}
+}
+
+std::string RenderGraph::GetScopedName(const std::string& name) const
+{
+	return _currentView == ~0u ? name : _viewNames[_currentView] + "/" + name;
+}
+
+RenderGraphConstants_t RenderGraph::AddConstants(const void* data, size_t size)
+{
+	RenderGraphConstantBlock& block = _constantBlocks.emplace_back();
+	block.offset = _constantData.size();
+	block.size = size;
+
+	const size_t alignedSize = (size + kDynamicConstantBufferAlignment - 1) & ~(kDynamicConstantBufferAlignment - 1);
+	_constantData.resize(block.offset + alignedSize);
+	memcpy(_constantData.data() + block.offset, data, size);
+
+	return (RenderGraphConstants_t)_constantBlocks.size();
+}
+
+DynamicBuffer_t RenderGraph::GetConstants(RenderGraphConstants_t constants)
+{
+	if (constants == RenderGraphConstants_t::NONE || (size_t)constants > _constantBlocks.size())
+	{
+#if RG_VALIDATION
+		ASSERTMSG(0, "RenderGraph::GetConstants invalid constants");
+#endif
+		return DynamicBuffer_t::INVALID;
+	}
+
+	return _constantBlocks[(size_t)constants - 1].buffer;
+}
+
+RenderGraphResource_t RenderGraph::GetResource(const std::string& name)
+{
+	if (_currentView != ~0u)
+	{
+		auto it = _registeredResourceMap.find(GetScopedName(name));
+		if (it != _registeredResourceMap.end())
+			return it->second;
+	}
+
+	auto it = _registeredResourceMap.find(name);
+	return it != _registeredResourceMap.end() ? it->second : RenderGraphResource_t::NONE;
+}
+
+// Compiled result of the last graph built that missed the cache. Graphs are rebuilt every frame
+// and usually identical, a graph with the same structure copies this rather than compiling.
+struct RGCompiledGraph
+{
+	bool valid = false;
+	uint64_t hash = 0;
+	std::vector<uint64_t> structure;
+
+	std::vector<size_t> consolidatedPasses;
+	std::vector<u32> passSubgraphs;
+	u32 subgraphCount = 0;
+	RenderGraphSchedule schedule;
+	std::vector<RenderGraph::RenderGraphPhysicalTexture> physicalTextures;
+	std::vector<std::pair<RenderGraphResource_t, size_t>> transientTextures;
+	std::vector<RenderGraph::RenderGraphPhysicalBuffer> physicalBuffers;
+	std::vector<std::pair<RenderGraphResource_t, size_t>> transientBuffers;
+	std::vector<RenderGraph::RenderGraphClear> clears;
+	std::vector<RenderGraph::RenderGraphBarrier> barriers;
+	std::vector<RenderGraphResourceType> resourceTypes;
+	RenderGraphStats stats;
+};
+
+RGCompiledGraph g_compiledGraph;
+
+// Bitset over resource handles, sized for the graph it is used with.
+struct RGBitSet
+{
+	std::vector<uint64_t> words;
+
+	explicit RGBitSet(size_t count)
+		: words((count + 63) / 64, 0)
+	{}
+
+	bool Test(size_t bit) const { return (words[bit / 64] >> (bit % 64)) & 1u; }
+	void Set(size_t bit) { words[bit / 64] |= 1ull << (bit % 64); }
+	void Reset(size_t bit) { words[bit / 64] &= ~(1ull << (bit % 64)); }
+};
+
+// Subresources of every registered resource numbered consecutively so dependencies can be tracked
+// per subresource. Textures have one per mip and array slice, numbered mip + slice * mipCount from
+// the first like barrier subresources, buffers and external targets have one.
+struct RGSubresourceLayout
+{
+	std::vector<u32> first;
+	std::vector<u32> mipCounts;
+	std::vector<u32> sliceCounts;
+	u32 count = 0;
+
+	void Add(u32 mipCount, u32 sliceCount)
+	{
+		first.push_back(count);
+		mipCounts.push_back(mipCount);
+		sliceCounts.push_back(sliceCount);
+		count += mipCount * sliceCount;
+	}
+
+	RenderGraphSubresourceRange Resolve(const RenderPassResource& res) const
+	{
+		const size_t handle = (size_t)res._resourceHandle;
+		return ResolveSubresources(res._subresources, mipCounts[handle], sliceCounts[handle]);
+	}
+
+	template<typename Func>
+	void ForEach(const RenderPassResource& res, Func&& func) const
+	{
+		const size_t handle = (size_t)res._resourceHandle;
+		const RenderGraphSubresourceRange range = Resolve(res);
+
+		for (u32 slice = range.firstSlice; slice < range.firstSlice + range.sliceCount; slice++)
+		{
+			for (u32 mip = range.firstMip; mip < range.firstMip + range.mipCount; mip++)
+				func(first[handle] + mip + slice * mipCounts[handle]);
+		}
+	}
+};
+
+struct RGDisjointSets
+{
+	std::vector<u32> parents;
+
+	explicit RGDisjointSets(size_t count)
+		: parents(count)
+	{
+		for (size_t i = 0; i < count; i++)
+			parents[i] = (u32)i;
+	}
+
+	u32 Find(u32 i)
+	{
+		while (parents[i] != i)
+		{
+			parents[i] = parents[parents[i]];
+			i = parents[i];
+		}
+		return i;
+	}
+
+	void Union(u32 a, u32 b)
+	{
+		a = Find(a);
+		b = Find(b);
+
+		if (a != b)
+			parents[Max(a, b)] = Min(a, b);
+	}
+};
+
+// Passes each pass depends on through the subresources they share, as {producer, consumer} pairs
+// ordered by consumer. Reads depend on the last write, writes on the last write and every read since.
+static void GetPassDependencies(const std::vector<RenderPass*>& passes, const RGSubresourceLayout& layout, std::vector<std::pair<u32, u32>>& dependencies)
+{
+	std::vector<u32> lastWriter(layout.count, UINT32_MAX);
+	std::vector<std::vector<u32>> readersSinceWrite(layout.count);
+
+	std::vector<u32> producers;
+
+	for (u32 passIdx = 0; passIdx < (u32)passes.size(); passIdx++)
+	{
+		const RenderPass* rp = passes[passIdx];
+
+		producers.clear();
+		for (const RenderPassResource& res : rp->_resources)
+		{
+			const bool writes = (res._access & RenderPassResourceAccess::WRITE) != RenderPassResourceAccess::NONE;
+
+			layout.ForEach(res, [&](u32 subresource)
+			{
+				if (lastWriter[subresource] != UINT32_MAX)
+					producers.push_back(lastWriter[subresource]);
+
+				if (writes)
+					producers.insert(producers.end(), readersSinceWrite[subresource].begin(), readersSinceWrite[subresource].end());
+			});
+		}
+
+		for (const RenderPassResource& res : rp->_resources)
+		{
+			const bool writes = (res._access & RenderPassResourceAccess::WRITE) != RenderPassResourceAccess::NONE;
+
+			layout.ForEach(res, [&](u32 subresource)
+			{
+				if (writes)
+				{
+					lastWriter[subresource] = passIdx;
+					readersSinceWrite[subresource].clear();
+				}
+				else
+				{
+					readersSinceWrite[subresource].push_back(passIdx);
+				}
+			});
+		}
+
+		std::sort(producers.begin(), producers.end());
+		producers.erase(std::unique(producers.begin(), producers.end()), producers.end());
+
+		for (u32 producer : producers)
+			dependencies.emplace_back(producer, passIdx);
+	}
+}
+
+// Targets a pass binds, render and depth targets for graphics passes and UAVs for compute passes.
+// Targets are keyed by resource, the subresources bound and the view.
+static void GetPassTargets(const RenderPass& pass, std::vector<uint64_t>& targets)
+{
+	const RenderResourceFlags targetFlags = pass._type == RenderPassType::COMPUTE ? RenderResourceFlags::UAV : RenderResourceFlags::RTV | RenderResourceFlags::DSV;
+
+	for (const RenderPassResource& res : pass._resources)
+	{
+		if ((res._accessFlags & targetFlags) != RenderResourceFlags::None)
+		{
+			targets.push_back(((uint64_t)res._resourceHandle << 32) | ((uint64_t)(res._subresources.firstMip & 0xFF) << 24)
+				| ((uint64_t)(res._subresources.firstSlice & 0xFFFF) << 8) | (u32)res._accessFlags);
+		}
+	}
+}
+
+// Counts passes that bind different targets to the last pass binding any, and subresources accessed
+// through a different view to their previous access.
+static void CountPassSwitches(const std::vector<RenderPass*>& passes, const RGSubresourceLayout& layout, u32& targetSwitches, u32& resourceTransitions)
+{
+	std::vector<uint64_t> bound;
+	std::vector<uint64_t> targets;
+	bool anyBound = false;
+
+	std::vector<RenderResourceFlags> lastView(layout.count, RenderResourceFlags::None);
+
+	targetSwitches = 0;
+	resourceTransitions = 0;
+
+	for (const RenderPass* rp : passes)
+	{
+		targets.clear();
+		GetPassTargets(*rp, targets);
+
+		if (!targets.empty())
+		{
+			if (anyBound && targets != bound)
+				targetSwitches++;
+
+			bound.swap(targets);
+			anyBound = true;
+		}
+
+		for (const RenderPassResource& res : rp->_resources)
+		{
+			bool transitions = false;
+			layout.ForEach(res, [&](u32 subresource)
+			{
+				RenderResourceFlags& view = lastView[subresource];
+				transitions |= view != RenderResourceFlags::None && view != res._accessFlags;
+				view = res._accessFlags;
+			});
+
+			if (transitions)
+				resourceTransitions++;
+		}
+	}
+}
+
+void RenderGraph::Compile()
+{
+	const size_t numPasses = _passes.size();
+	const size_t numResources = _registeredResources.size();
+
+	// Number every subresource of the registered resources, dependencies are tracked per subresource
+	// so passes writing separate mips or slices of a texture don't depend on each other.
+	RGSubresourceLayout layout;
+	layout.first.reserve(numResources);
+	layout.mipCounts.reserve(numResources);
+	layout.sliceCounts.reserve(numResources);
+	for (const RenderGraphRegisteredResource& resource : _registeredResources)
+	{
+		if (resource.type == RenderGraphResourceType::TEXTURE && !resource.external)
+			layout.Add(Max(resource.texture.mipCount, 1u), Max(resource.texture.arraySize, 1u));
+		else
+			layout.Add(1, 1);
+	}
+
+	// Loop back from root nodes and track where any contributing writes are sourced from, skipping
+	// passes that dont contribute. Subresources index the bitset directly and each pass only visits
+	// the subresources it accesses, so this is linear in the number of accessed subresources.
+	std::vector<bool> contributes(numPasses, false);
+	{
+		RGBitSet reads(layout.count);
+
+		for (size_t passIdx = numPasses; passIdx-- > 0; )
+		{
+			const RenderPass& pass = _passes[passIdx];
+
+			bool writesAreRead = false;
+			for (const RenderPassResource& res : pass._resources)
+			{
+				if ((res._access & RenderPassResourceAccess::WRITE) != RenderPassResourceAccess::NONE)
+					layout.ForEach(res, [&](u32 subresource) { writesAreRead |= reads.Test(subresource); });
+			}
+
+			if (!pass._root && !writesAreRead)
+				continue;
+
+			// Any traced writes are removed, any new reads from this pass are added
+			for (const RenderPassResource& res : pass._resources)
+			{
+				if ((res._access & RenderPassResourceAccess::WRITE) != RenderPassResourceAccess::NONE)
+					layout.ForEach(res, [&](u32 subresource) { reads.Reset(subresource); });
+			}
+
+			for (const RenderPassResource& res : pass._resources)
+			{
+				if ((res._access & RenderPassResourceAccess::READ) != RenderPassResourceAccess::NONE)
+					layout.ForEach(res, [&](u32 subresource) { reads.Set(subresource); });
+			}
+
+			contributes[passIdx] = true;
+		}
+	}
+
+	// Remove non-contributing passes
+	{
+		_consolidatedPasses.reserve(numPasses);
+
+		for (size_t i = 0; i < numPasses; i++)
+		{
+			if (contributes[i])
+				_consolidatedPasses.push_back(&_passes[i]);
+		}
+	}
+
+	u32 addedOrderTargetSwitches = 0;
+	u32 addedOrderResourceTransitions = 0;
+	CountPassSwitches(_consolidatedPasses, layout, addedOrderTargetSwitches, addedOrderResourceTransitions);
+
+	// Reorder passes in any order their dependencies allow. Of the passes ready to run, one binding the
+	// same targets as the last pass is picked so they share the binds, otherwise the pass whose
+	// dependencies finished earliest, leaving more work between producers and their consumers.
+	// Ties keep the order passes were added in.
+	if (g_passReordering && !_consolidatedPasses.empty())
+	{
+		const u32 passCount = (u32)_consolidatedPasses.size();
+
+		std::vector<std::pair<u32, u32>> dependencies;
+		GetPassDependencies(_consolidatedPasses, layout, dependencies);
+
+		std::vector<u32> waitingOn(passCount, 0);
+		std::vector<std::vector<u32>> consumers(passCount);
+		for (const auto& [producer, consumer] : dependencies)
+		{
+			waitingOn[consumer]++;
+			consumers[producer].push_back(consumer);
+		}
+
+		std::map<std::vector<uint64_t>, u32> targetSetIds;
+		std::vector<u32> passTargetSets(passCount);
+		std::vector<uint64_t> targets;
+
+		for (u32 passIdx = 0; passIdx < passCount; passIdx++)
+		{
+			targets.clear();
+			GetPassTargets(*_consolidatedPasses[passIdx], targets);
+			passTargetSets[passIdx] = targetSetIds.emplace(targets, (u32)targetSetIds.size()).first->second;
+		}
+
+		const u32 noTargets = targetSetIds.emplace(std::vector<uint64_t>(), (u32)targetSetIds.size()).first->second;
+
+		// Ready passes keyed by the position their last dependency was scheduled at then pass index.
+		// A pass sits in both queues, whichever doesn't schedule it skips it when it reaches the top.
+		using RGReadyQueue = std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>>;
+		RGReadyQueue ready;
+		std::vector<RGReadyQueue> readyByTargets(targetSetIds.size());
+
+		std::vector<u32> lastDependency(passCount, 0);
+		std::vector<bool> scheduled(passCount, false);
+
+		auto MakeReady = [&](u32 passIdx)
+		{
+			const uint64_t key = ((uint64_t)lastDependency[passIdx] << 32) | passIdx;
+			ready.push(key);
+			readyByTargets[passTargetSets[passIdx]].push(key);
+		};
+
+		for (u32 passIdx = 0; passIdx < passCount; passIdx++)
+		{
+			if (waitingOn[passIdx] == 0)
+				MakeReady(passIdx);
+		}
+
+		std::vector<RenderPass*> ordered;
+		ordered.reserve(passCount);
+
+		u32 currentTargets = noTargets;
+
+		while (ordered.size() < passCount)
+		{
+			RGReadyQueue& sameTargets = readyByTargets[currentTargets];
+			while (!sameTargets.empty() && scheduled[(u32)sameTargets.top()])
+				sameTargets.pop();
+
+			while (!ready.empty() && scheduled[(u32)ready.top()])
+				ready.pop();
+
+			ASSERTMSG(!ready.empty(), "RenderGraph::Compile failed, pass dependencies contain a cycle");
+
+			const u32 passIdx = (u32)(currentTargets != noTargets && !sameTargets.empty() ? sameTargets.top() : ready.top());
+
+			scheduled[passIdx] = true;
+			ordered.push_back(_consolidatedPasses[passIdx]);
+
+			if (passTargetSets[passIdx] != noTargets)
+				currentTargets = passTargetSets[passIdx];
+
+			for (u32 consumer : consumers[passIdx])
+			{
+				lastDependency[consumer] = Max(lastDependency[consumer], (u32)ordered.size());
+
+				if (--waitingOn[consumer] == 0)
+					MakeReady(consumer);
+			}
+		}
+
+		_consolidatedPasses.swap(ordered);
+	}
+
+	// Split the remaining passes into independent subgraphs, passes accessing a common resource
+	// end up in the same subgraph. Subgraphs are numbered in order of their first pass.
+	{
+		RGDisjointSets sets(_consolidatedPasses.size());
+		std::vector<u32> firstAccess(numResources, UINT32_MAX);
+
+		for (u32 passIdx = 0; passIdx < (u32)_consolidatedPasses.size(); passIdx++)
+		{
+			for (const RenderPassResource& res : _consolidatedPasses[passIdx]->_resources)
+			{
+				u32& first = firstAccess[(size_t)res._resourceHandle];
+				if (first == UINT32_MAX)
+					first = passIdx;
+				else
+					sets.Union(first, passIdx);
+			}
+		}
+
+		std::vector<u32> subgraphIds(_consolidatedPasses.size(), UINT32_MAX);
+		_passSubgraphs.resize(_consolidatedPasses.size());
+		_subgraphCount = 0;
+
+		for (u32 passIdx = 0; passIdx < (u32)_consolidatedPasses.size(); passIdx++)
+		{
+			u32& subgraph = subgraphIds[sets.Find(passIdx)];
+			if (subgraph == UINT32_MAX)
+				subgraph = _subgraphCount++;
+
+			_passSubgraphs[passIdx] = subgraph;
+		}
+	}
+
+	// Schedule passes on queues. Whole subgraphs of compute work run on the async compute queue when
+	// there is graphics work to overlap them with, as do compute passes marked to. Any dependency
+	// between passes on different queues needs a wait, a pass only waits when an earlier pass on its
+	// queue hasn't waited for a pass on the other queue at least as late.
+	{
+		const u32 passCount = (u32)_consolidatedPasses.size();
+
+		_schedule.passQueues.assign(passCount, RenderGraphQueue::GRAPHICS);
+
+		if (g_asyncCompute)
+		{
+			std::vector<bool> subgraphHasGraphics(_subgraphCount, false);
+			bool hasGraphics = false;
+
+			for (u32 passIdx = 0; passIdx < passCount; passIdx++)
+			{
+				if (_consolidatedPasses[passIdx]->_type == RenderPassType::GRAPHICS)
+				{
+					subgraphHasGraphics[_passSubgraphs[passIdx]] = true;
+					hasGraphics = true;
+				}
+			}
+
+			for (u32 passIdx = 0; passIdx < passCount; passIdx++)
+			{
+				const RenderPass* rp = _consolidatedPasses[passIdx];
+				if (rp->_type == RenderPassType::COMPUTE && (rp->_asyncCompute || (hasGraphics && !subgraphHasGraphics[_passSubgraphs[passIdx]])))
+					_schedule.passQueues[passIdx] = RenderGraphQueue::ASYNC_COMPUTE;
+			}
+		}
+
+		GetPassDependencies(_consolidatedPasses, layout, _schedule.dependencies);
+
+		u32 lastWaited[(size_t)RenderGraphQueue::COUNT];
+		std::fill(std::begin(lastWaited), std::end(lastWaited), UINT32_MAX);
 
-struct RGCachedTexture
+		size_t dependencyIdx = 0;
+
+		for (u32 passIdx = 0; passIdx < passCount; passIdx++)
+		{
+			const RenderGraphQueue queue = _schedule.passQueues[passIdx];
+			u32 latestOtherQueue = UINT32_MAX;
+
+			for (; dependencyIdx < _schedule.dependencies.size() && _schedule.dependencies[dependencyIdx].second == passIdx; dependencyIdx++)
+			{
+				const u32 dependency = _schedule.dependencies[dependencyIdx].first;
+				if (_schedule.passQueues[dependency] != queue)
+					latestOtherQueue = dependency;
+			}
+
+			u32& waited = lastWaited[(size_t)queue];
+			if (latestOtherQueue != UINT32_MAX && (waited == UINT32_MAX || latestOtherQueue > waited))
+			{
+				RenderGraphSyncPoint& sync = _schedule.syncPoints.emplace_back();
+				sync.signalPass = latestOtherQueue;
+				sync.waitPass = passIdx;
+
+				waited = latestOtherQueue;
+			}
+		}
+	}
+
+	// Build textures
+	{
+		//  Assign access flags
+		{
+			for (const RenderPass* rp : _consolidatedPasses)
+			{
+				for (const RenderPassResource& res : rp->_resources)
+				{
+					_registeredResources[(size_t)res._resourceHandle].flags |= res._accessFlags;
+				}
+			}
+		}
+
+		// Lifetime of each resource as the range of consolidated passes that use it. A resource is
+		// overwritten on first use when each subresource is only written by the first pass using it.
+		struct RGResourceLifetime
+		{
+			size_t firstUse = SIZE_MAX;
+			size_t lastUse = 0;
+			bool overwrittenOnFirstUse = false;
+		};
+
+		std::vector<RGResourceLifetime> lifetimes(_registeredResources.size());
+		std::vector<RenderGraphResource_t> usedResources;
+
+		RGBitSet touched(layout.count);
+
+		for (size_t passIdx = 0; passIdx < _consolidatedPasses.size(); passIdx++)
+		{
+			for (const RenderPassResource& res : _consolidatedPasses[passIdx]->_resources)
+			{
+				RGResourceLifetime& lifetime = lifetimes[(size_t)res._resourceHandle];
+
+				if (lifetime.firstUse == SIZE_MAX)
+				{
+					lifetime.firstUse = passIdx;
+					lifetime.overwrittenOnFirstUse = true;
+					usedResources.push_back(res._resourceHandle);
+				}
+
+				bool readsFirst = false;
+				layout.ForEach(res, [&](u32 subresource)
+				{
+					if (!touched.Test(subresource))
+					{
+						touched.Set(subresource);
+						readsFirst |= res._access != RenderPassResourceAccess::WRITE;
+					}
+				});
+
+				if (readsFirst)
+				{
+					lifetime.overwrittenOnFirstUse = false;
+
+#if RG_VALIDATION
+					if (!_registeredResources[(size_t)res._resourceHandle].external)
+						LOGWARNING("RenderGraph::Build: %s reads a transient resource before any pass writes it", _consolidatedPasses[passIdx]->_name.c_str());
+#endif
+				}
+
+				lifetime.lastUse = passIdx;
+			}
+		}
+
+		// Physical textures and buffers are allocated greedily in order of first use. A transient takes
+		// over a physical resource of the same description once every resource placed in it has been
+		// used for the last time. Only resources that overwrite their contents on first use can alias,
+		// anything loaded or read first needs the memory to itself.
+		std::vector<size_t> physicalLastUse;
+
+		// Physical resources by description, the one whose resources finish soonest on top.
+		using RGResourceQueue = std::priority_queue<std::pair<size_t, size_t>, std::vector<std::pair<size_t, size_t>>, std::greater<std::pair<size_t, size_t>>>;
+		std::unordered_map<RGTextureKey, RGResourceQueue, RGTextureKeyHash> reusableTextures;
+		std::unordered_map<RGBufferKey, RGResourceQueue, RGBufferKeyHash> reusableBuffers;
+
+		std::sort(usedResources.begin(), usedResources.end(), [&lifetimes](RenderGraphResource_t a, RenderGraphResource_t b)
+		{
+			return lifetimes[(size_t)a].firstUse < lifetimes[(size_t)b].firstUse;
+		});
+
+		_stats = {};
+
+		for (RenderGraphResource_t handle : usedResources)
+		{
+			if ((size_t)handle >= _resources.size())
+			{
+				_resources.resize((size_t)handle + 1, {});
+			}
+
+			const RenderGraphRegisteredResource& registeredRes = _registeredResources[(size_t)handle];
+			RenderGraphResource& res = _resources[(size_t)handle];
+
+			if (res.external)
+				continue;
+
+			res.type = registeredRes.type;
+
+			const RGResourceLifetime& lifetime = lifetimes[(size_t)handle];
+
+			if (registeredRes.type == RenderGraphResourceType::BUFFER)
+			{
+				const RenderGraphBufferDesc& desc = registeredRes.buffer;
+
+				size_t physicalIdx = _physicalBuffers.size();
+
+				RGResourceQueue* reusable = nullptr;
+				if (g_transientAliasing && lifetime.overwrittenOnFirstUse)
+				{
+					reusable = &reusableBuffers[MakeBufferKey(desc, RenderResourceFlags::None)];
+					if (!reusable->empty() && reusable->top().first < lifetime.firstUse)
+					{
+						physicalIdx = reusable->top().second;
+						reusable->pop();
+					}
+				}
+
+				if (physicalIdx == _physicalBuffers.size())
+					_physicalBuffers.emplace_back().desc = desc;
+
+				if (reusable)
+					reusable->emplace(lifetime.lastUse, physicalIdx);
+
+				_physicalBuffers[physicalIdx].flags |= registeredRes.flags;
+
+				_transientBuffers.emplace_back(handle, physicalIdx);
+
+				_stats.transientBuffers++;
+				_stats.unaliasedBytes += GetBufferBytes(MakeBufferKey(desc, registeredRes.flags));
+				continue;
+			}
+
+			if (registeredRes.type != RenderGraphResourceType::TEXTURE)
+				continue;
+
+			const RenderGraphTextureDesc& desc = registeredRes.texture;
+
+			size_t physicalIdx = _physicalTextures.size();
+
+			RGResourceQueue* reusable = nullptr;
+			if (g_transientAliasing && lifetime.overwrittenOnFirstUse)
+			{
+				reusable = &reusableTextures[MakeTextureKey(desc, RenderResourceFlags::None)];
+				if (!reusable->empty() && reusable->top().first < lifetime.firstUse)
+				{
+					physicalIdx = reusable->top().second;
+					reusable->pop();
+				}
+			}
+
+			if (physicalIdx == _physicalTextures.size())
+			{
+				RenderGraphPhysicalTexture& physical = _physicalTextures.emplace_back();
+				physical.desc = desc;
+
+				physicalLastUse.push_back(0);
+			}
+
+			if (reusable)
+				reusable->emplace(lifetime.lastUse, physicalIdx);
+
+			_physicalTextures[physicalIdx].flags |= registeredRes.flags;
+			physicalLastUse[physicalIdx] = lifetime.lastUse;
+
+			_transientTextures.emplace_back(handle, physicalIdx);
+
+			_stats.transientTextures++;
+			_stats.unaliasedBytes += GetTextureBytes(MakeTextureKey(desc, registeredRes.flags));
+		}
+
+		for (const RenderGraphPhysicalTexture& physical : _physicalTextures)
+		{
+			_stats.physicalTextures++;
+			_stats.aliasedBytes += GetTextureBytes(MakeTextureKey(physical.desc, physical.flags));
+		}
+
+		for (const RenderGraphPhysicalBuffer& physical : _physicalBuffers)
+		{
+			_stats.physicalBuffers++;
+			_stats.aliasedBytes += GetBufferBytes(MakeBufferKey(physical.desc, physical.flags));
+		}
+	}
+
+	// Gather clears. A render target clear is dropped when the next pass to use each cleared
+	// subresource overwrites it without reading, or nothing uses it again, as everything the clearing
+	// pass wrote to it is discarded. Depth and compute targets always clear, the pass can depend on
+	// their contents to produce its other outputs. Passes are walked backwards so the next access
+	// to each subresource is known when a clear is reached.
+	{
+		std::vector<RenderPassResourceAccess> nextAccess(layout.count, RenderPassResourceAccess::NONE);
+
+		for (size_t passIdx = _consolidatedPasses.size(); passIdx-- > 0; )
+		{
+			for (const RenderPassResource& res : _consolidatedPasses[passIdx]->_resources)
+			{
+				if (res._outputAccess != RenderPassOutputAccess::CLEAR)
+					continue;
+
+				bool readNext = false;
+				layout.ForEach(res, [&](u32 subresource) { readNext |= (nextAccess[subresource] & RenderPassResourceAccess::READ) != RenderPassResourceAccess::NONE; });
+
+				if ((res._accessFlags & RenderResourceFlags::RTV) != RenderResourceFlags::None && !_registeredResources[(size_t)res._resourceHandle].external && !readNext)
+				{
+					_stats.elidedClears++;
+					continue;
+				}
+
+				RenderGraphClear& clear = _clears.emplace_back();
+				clear.pass = passIdx;
+				clear.resource = res._resourceHandle;
+				clear.view = res._accessFlags;
+				clear.subresources = res._subresources;
+
+				_stats.clears++;
+			}
+
+			for (const RenderPassResource& res : _consolidatedPasses[passIdx]->_resources)
+				layout.ForEach(res, [&](u32 subresource) { nextAccess[subresource] = res._access; });
+		}
+
+		std::stable_sort(_clears.begin(), _clears.end(), [](const RenderGraphClear& a, const RenderGraphClear& b) { return a.pass < b.pass; });
+	}
+
+	// Track the state of every subresource of each texture and buffer through the passes and transition
+	// it when a pass needs it in another state. Aliased transients share the state of their physical
+	// resource. Transients start in Common, the state pooled textures are returned in, and external
+	// targets as render targets. Consecutive UAV accesses where either writes are ordered with a UAV
+	// barrier. Textures transitioned as a whole use one barrier for all their subresources.
+	{
+		struct RGSubresourceState
+		{
+			ResourceState current = ResourceState::Common;
+			bool written = false;
+		};
+
+		struct RGTextureState
+		{
+			ResourceState initial = ResourceState::Common;
+			RenderGraphResource_t lastResource = RenderGraphResource_t::NONE;
+			std::vector<RGSubresourceState> subresources;
+		};
+
+		std::vector<size_t> stateSlots(numResources, SIZE_MAX);
+		std::vector<RGTextureState> states(_physicalTextures.size() + _physicalBuffers.size());
+
+		for (size_t physicalIdx = 0; physicalIdx < _physicalTextures.size(); physicalIdx++)
+		{
+			const RenderGraphTextureDesc& desc = _physicalTextures[physicalIdx].desc;
+			states[physicalIdx].subresources.resize(Max(desc.mipCount, 1u) * Max(desc.arraySize, 1u));
+		}
+
+		for (size_t physicalIdx = 0; physicalIdx < _physicalBuffers.size(); physicalIdx++)
+			states[_physicalTextures.size() + physicalIdx].subresources.resize(1);
+
+		for (const auto& [handle, physicalIdx] : _transientTextures)
+			stateSlots[(size_t)handle] = physicalIdx;
+
+		for (const auto& [handle, physicalIdx] : _transientBuffers)
+			stateSlots[(size_t)handle] = _physicalTextures.size() + physicalIdx;
+
+		for (size_t handle = 0; handle < numResources; handle++)
+		{
+			if (_registeredResources[handle].external)
+			{
+				stateSlots[handle] = states.size();
+
+				RGTextureState& state = states.emplace_back();
+				state.initial = ResourceState::RenderTarget;
+				state.subresources.push_back({ ResourceState::RenderTarget, false });
+			}
+		}
+
+		const size_t passCount = _consolidatedPasses.size();
+		size_t lastBatchPass = SIZE_MAX;
+
+		auto AddBarrier = [&](size_t passIdx, RenderGraphResource_t resource, u32 subresource, ResourceState before, ResourceState after)
+		{
+			RenderGraphBarrier& barrier = _barriers.emplace_back();
+			barrier.pass = passIdx;
+			barrier.resource = resource;
+			barrier.subresource = subresource;
+			barrier.before = before;
+			barrier.after = after;
+
+			_stats.barriers++;
+			if (lastBatchPass != passIdx)
+			{
+				_stats.barrierBatches++;
+				lastBatchPass = passIdx;
+			}
+		};
+
+		// Subresources of the current access needing a transition, with the state they leave.
+		std::vector<std::pair<u32, ResourceState>> transitions;
+
+		for (size_t passIdx = 0; passIdx < passCount; passIdx++)
+		{
+			for (const RenderPassResource& res : _consolidatedPasses[passIdx]->_resources)
+			{
+				const size_t slot = stateSlots[(size_t)res._resourceHandle];
+				if (slot == SIZE_MAX)
+					continue;
+
+				ResourceState needed = ResourceState::ShaderResource;
+				if ((res._accessFlags & RenderResourceFlags::RTV) != RenderResourceFlags::None)
+					needed = ResourceState::RenderTarget;
+				else if ((res._accessFlags & RenderResourceFlags::DSV) != RenderResourceFlags::None)
+					needed = ResourceState::DepthWrite;
+				else if ((res._accessFlags & RenderResourceFlags::UAV) != RenderResourceFlags::None)
+					needed = ResourceState::UnorderedAccess;
+
+				const bool writes = (res._access & RenderPassResourceAccess::WRITE) != RenderPassResourceAccess::NONE;
+
+				RGTextureState& state = states[slot];
+				const u32 firstSubresource = layout.first[(size_t)res._resourceHandle];
+
+				transitions.clear();
+				layout.ForEach(res, [&](u32 subresource)
+				{
+					RGSubresourceState& subState = state.subresources[subresource - firstSubresource];
+					if (subState.current != needed || (needed == ResourceState::UnorderedAccess && (writes || subState.written)))
+						transitions.emplace_back(subresource - firstSubresource, subState.current);
+
+					subState.current = needed;
+					subState.written = writes;
+				});
+
+				const bool uniform = transitions.size() == state.subresources.size()
+					&& std::all_of(transitions.begin(), transitions.end(), [&transitions](const auto& t) { return t.second == transitions.front().second; });
+
+				if (uniform)
+				{
+					AddBarrier(passIdx, res._resourceHandle, kAllSubresources, transitions.front().second, needed);
+				}
+				else
+				{
+					for (const auto& [subresource, before] : transitions)
+						AddBarrier(passIdx, res._resourceHandle, subresource, before, needed);
+				}
+
+				state.lastResource = res._resourceHandle;
+			}
+		}
+
+		for (const RGTextureState& state : states)
+		{
+			const ResourceState current = state.subresources.front().current;
+			const bool uniform = std::all_of(state.subresources.begin(), state.subresources.end(), [current](const RGSubresourceState& sub) { return sub.current == current; });
+
+			if (uniform)
+			{
+				if (current != state.initial)
+					AddBarrier(passCount, state.lastResource, kAllSubresources, current, state.initial);
+				continue;
+			}
+
+			for (u32 subresource = 0; subresource < (u32)state.subresources.size(); subresource++)
+			{
+				if (state.subresources[subresource].current != state.initial)
+					AddBarrier(passCount, state.lastResource, subresource, state.subresources[subresource].current, state.initial);
+			}
+		}
+	}
+
+	_stats.subgraphs = _subgraphCount;
+	_stats.addedOrderTargetSwitches = addedOrderTargetSwitches;
+	_stats.addedOrderResourceTransitions = addedOrderResourceTransitions;
+	_stats.targetSwitches = addedOrderTargetSwitches;
+	_stats.resourceTransitions = addedOrderResourceTransitions;
+
+	if (g_passReordering)
+		CountPassSwitches(_consolidatedPasses, layout, _stats.targetSwitches, _stats.resourceTransitions);
+	_stats.asyncComputePasses = (u32)std::count(_schedule.passQueues.begin(), _schedule.passQueues.end(), RenderGraphQueue::ASYNC_COMPUTE);
+	_stats.syncPoints = (u32)_schedule.syncPoints.size();
+}
+
+// Flattens everything Compile depends on so graphs can be compared without compiling them. Pass
+// names, callbacks and external views are left out, they don't change the compiled result.
+void RenderGraph::GetStructure(std::vector<uint64_t>& structure) const
 {
-	RenderFormat format = RenderFormat::UNKNOWN;
-	uint3 dimensions = {};
-	Texture_t textureHandle = Texture_t::INVALID;
+	structure.push_back(((uint64_t)g_passReordering << 2) | ((uint64_t)g_asyncCompute << 1) | (uint64_t)g_transientAliasing);
+
+	structure.push_back(_registeredResources.size());
+	for (const RenderGraphRegisteredResource& res : _registeredResources)
+	{
+		structure.push_back(((uint64_t)res.external << 8) | (uint64_t)res.type);
+
+		if (res.type == RenderGraphResourceType::TEXTURE)
+		{
+			structure.push_back(((uint64_t)res.texture.width << 32) | res.texture.height);
+			structure.push_back(((uint64_t)res.texture.format << 32) | ((uint64_t)res.texture.mipCount << 16) | res.texture.arraySize);
+		}
+		else if (res.type == RenderGraphResourceType::BUFFER)
+		{
+			structure.push_back(((uint64_t)res.buffer.elementSize << 32) | res.buffer.elementCount);
+		}
+	}
+
+	structure.push_back(_passes.size());
+	for (const RenderPass& pass : _passes)
+	{
+		structure.push_back(((uint64_t)pass._resources.size() << 24) | ((uint64_t)pass._asyncCompute << 16) | ((uint64_t)pass._root << 8) | (uint64_t)pass._type);
+
+		for (const RenderPassResource& res : pass._resources)
+		{
+			structure.push_back(((uint64_t)res._resourceHandle << 32) | ((uint64_t)res._outputAccess << 16) | ((uint64_t)res._access << 8) | (uint64_t)res._accessFlags);
+
+			// The range is unresolved here and counts can be ~0u, so keep every field whole.
+			const RenderGraphSubresourceRange& range = res._subresources;
+			structure.push_back(((uint64_t)range.firstMip << 32) | range.mipCount);
+			structure.push_back(((uint64_t)range.firstSlice << 32) | range.sliceCount);
+		}
+	}
+}
+
+void RenderGraph::Build()
+{
+	std::vector<uint64_t> structure;
+	structure.reserve(g_compiledGraph.structure.size());
+	GetStructure(structure);
+
+	uint64_t hash = 14695981039346656037ull;
+	for (uint64_t value : structure)
+		hash = (hash ^ value) * 1099511628211ull;
+
+	if (g_compiledGraphCaching && g_compiledGraph.valid && g_compiledGraph.hash == hash && g_compiledGraph.structure == structure)
+	{
+		_consolidatedPasses.reserve(g_compiledGraph.consolidatedPasses.size());
+		for (size_t passIdx : g_compiledGraph.consolidatedPasses)
+			_consolidatedPasses.push_back(&_passes[passIdx]);
+
+		_passSubgraphs = g_compiledGraph.passSubgraphs;
+		_subgraphCount = g_compiledGraph.subgraphCount;
+		_schedule = g_compiledGraph.schedule;
+		_physicalTextures = g_compiledGraph.physicalTextures;
+		_transientTextures = g_compiledGraph.transientTextures;
+		_physicalBuffers = g_compiledGraph.physicalBuffers;
+		_transientBuffers = g_compiledGraph.transientBuffers;
+		_clears = g_compiledGraph.clears;
+		_barriers = g_compiledGraph.barriers;
+		_stats = g_compiledGraph.stats;
+
+		if (_resources.size() < g_compiledGraph.resourceTypes.size())
+			_resources.resize(g_compiledGraph.resourceTypes.size(), {});
+
+		for (size_t i = 0; i < g_compiledGraph.resourceTypes.size(); i++)
+		{
+			if (!_resources[i].external)
+				_resources[i].type = g_compiledGraph.resourceTypes[i];
+		}
+
+		_stats.compiledFromCache = true;
+	}
+	else
+	{
+		Compile();
+
+		g_compiledGraph.valid = true;
+		g_compiledGraph.hash = hash;
+		g_compiledGraph.structure = std::move(structure);
+
+		g_compiledGraph.consolidatedPasses.clear();
+		for (const RenderPass* rp : _consolidatedPasses)
+			g_compiledGraph.consolidatedPasses.push_back(rp - _passes.data());
+
+		g_compiledGraph.passSubgraphs = _passSubgraphs;
+		g_compiledGraph.subgraphCount = _subgraphCount;
+		g_compiledGraph.schedule = _schedule;
+		g_compiledGraph.physicalTextures = _physicalTextures;
+		g_compiledGraph.transientTextures = _transientTextures;
+		g_compiledGraph.physicalBuffers = _physicalBuffers;
+		g_compiledGraph.transientBuffers = _transientBuffers;
+		g_compiledGraph.clears = _clears;
+		g_compiledGraph.barriers = _barriers;
+		g_compiledGraph.stats = _stats;
+
+		g_compiledGraph.resourceTypes.resize(_resources.size());
+		for (size_t i = 0; i < _resources.size(); i++)
+			g_compiledGraph.resourceTypes[i] = _resources[i].type;
+	}
+
+	_stats.views = (u32)_viewNames.size();
+
+	g_texturePool.frame++;
+	g_bufferPool.frame++;
+
+	for (RenderGraphPhysicalTexture& physical : _physicalTextures)
+	{
+		physical.tex = g_texturePool.Acquire(MakeTextureKey(physical.desc, physical.flags));
+	}
+
+	for (const auto& [handle, physicalIdx] : _transientTextures)
+	{
+		const RenderGraphPhysicalTexture& physical = _physicalTextures[physicalIdx];
+		RenderGraphResource& res = _resources[(size_t)handle];
+
+		res.texture.tex = physical.tex;
+		res.texture.format = physical.desc.format;
+		res.texture.dimensions = uint3(physical.desc.width, physical.desc.height, 1);
+		res.srv = GetTextureSRV(res.texture.tex);
+		res.rtv = GetTextureRTV(res.texture.tex);
+		res.dsv = GetTextureDSV(res.texture.tex);
+		res.uav = GetTextureUAV(res.texture.tex);
+	}
+
+	// Views of the subresource ranges passes access, created the first time a pooled texture is used
+	// for each range and kept with it. Whole textures use the texture's own views.
+	for (const RenderPass* rp : _consolidatedPasses)
+	{
+		for (const RenderPassResource& access : rp->_resources)
+		{
+			const RenderGraphRegisteredResource& registeredRes = _registeredResources[(size_t)access._resourceHandle];
+			if (registeredRes.type != RenderGraphResourceType::TEXTURE || registeredRes.external)
+				continue;
+
+			const u32 mipCount = Max(registeredRes.texture.mipCount, 1u);
+			const u32 sliceCount = Max(registeredRes.texture.arraySize, 1u);
+			const RenderGraphSubresourceRange range = ResolveSubresources(access._subresources, mipCount, sliceCount);
+			if (range.mipCount == mipCount && range.sliceCount == sliceCount)
+				continue;
+
+			const RenderGraphResource& res = _resources[(size_t)access._resourceHandle];
+			std::vector<RGSubresourceView>& views = g_subresourceViews[res.texture.tex];
+
+			const uint64_t key = GetSubresourceKey(range);
+			auto view = std::find_if(views.begin(), views.end(), [key](const RGSubresourceView& v) { return v.key == key; });
+			if (view == views.end())
+			{
+				view = views.emplace(views.end());
+				view->key = key;
+			}
+
+			if ((access._accessFlags & RenderResourceFlags::SRV) != RenderResourceFlags::None && view->srv == ShaderResourceView_t::INVALID)
+				view->srv = CreateTextureSRV(res.texture.tex, res.texture.format, TextureDimension::Tex2D, range.firstMip, range.mipCount, range.firstSlice, range.sliceCount);
+			else if ((access._accessFlags & RenderResourceFlags::RTV) != RenderResourceFlags::None && view->rtv == RenderTargetView_t::INVALID)
+				view->rtv = CreateTextureRTV(res.texture.tex, res.texture.format, range.firstMip, range.firstSlice, range.sliceCount);
+			else if ((access._accessFlags & RenderResourceFlags::DSV) != RenderResourceFlags::None && view->dsv == DepthStencilView_t::INVALID)
+				view->dsv = CreateTextureDSV(res.texture.tex, res.texture.format, range.firstMip, range.firstSlice, range.sliceCount);
+			else if ((access._accessFlags & RenderResourceFlags::UAV) != RenderResourceFlags::None && view->uav == UnorderedAccessView_t::INVALID)
+				view->uav = CreateTextureUAV(res.texture.tex, res.texture.format, range.firstMip, range.firstSlice, range.sliceCount);
+		}
+	}
+
+	for (RenderGraphPhysicalBuffer& physical : _physicalBuffers)
+	{
+		const RGPooledBuffer pooled = g_bufferPool.Acquire(MakeBufferKey(physical.desc, physical.flags));
+		physical.buf = pooled.buf;
+		physical.srv = pooled.srv;
+		physical.uav = pooled.uav;
+	}
+
+	for (const auto& [handle, physicalIdx] : _transientBuffers)
+	{
+		const RenderGraphPhysicalBuffer& physical = _physicalBuffers[physicalIdx];
+		RenderGraphResource& res = _resources[(size_t)handle];
+
+		res.buffer.buf = physical.buf;
+		res.buffer.elementCount = physical.desc.elementCount;
+		res.srv = physical.srv;
+		res.uav = physical.uav;
+	}
+
+	g_texturePool.Evict(g_poolMaxFrameAge, g_texturePool.budget);
+	g_bufferPool.Evict(g_poolMaxFrameAge, g_bufferPool.budget);
+}
+
+// Targets the graph has bound on a command list. Command lists start with nothing bound. Views are
+// compared to skip binds, resources to find targets a pass also reads.
+struct RGBoundTargets
+{
+	std::vector<RenderGraphResource_t> renderTargets;
+	std::vector<RenderTargetView_t> rtvs;
+	bool depthBound = false;
+	RenderGraphResource_t depth = RenderGraphResource_t::NONE;
+	DepthStencilView_t dsv = DepthStencilView_t::INVALID;
+	std::vector<RenderGraphResource_t> uavs;
+	std::vector<UnorderedAccessView_t> uavViews;
+
+	u32 binds = 0;
+	u32 unbinds = 0;
+
+	bool IsRenderTarget(RenderGraphResource_t resource) const
+	{
+		return (depthBound && depth == resource) || std::find(renderTargets.begin(), renderTargets.end(), resource) != renderTargets.end();
+	}
 };
 
-std::vector<RGCachedTexture> g_cachedTextures;
+static bool PassUsesResource(const RenderPass& pass, RenderGraphResource_t resource)
+{
+	return std::find_if(pass._resources.begin(), pass._resources.end(), [resource](const RenderPassResource& res) { return res._resourceHandle == resource; }) != pass._resources.end();
+}
+
+// Binds the render, depth and compute targets declared by the pass. Targets left bound by earlier
+// passes are only unbound when this pass accesses them through another view, so a run of passes
+// writing the same targets binds them once.
+void RenderGraph::BindPassTargets(const RenderPass& pass, CommandList* cl, RGBoundTargets& bound)
+{
+	std::vector<RenderGraphResource_t> renderTargets;
+	std::vector<RenderTargetView_t> rtvs;
+	bool hasDepth = false;
+	RenderGraphResource_t depth = RenderGraphResource_t::NONE;
+	DepthStencilView_t dsv = DepthStencilView_t::INVALID;
+	std::vector<RenderGraphResource_t> uavs;
+	std::vector<UnorderedAccessView_t> uavViews;
+
+	for (const RenderPassResource& res : pass._resources)
+	{
+		if ((res._accessFlags & RenderResourceFlags::RTV) != RenderResourceFlags::None)
+		{
+			renderTargets.push_back(res._resourceHandle);
+			rtvs.push_back(GetRTV(res._resourceHandle, res._subresources));
+		}
+		else if ((res._accessFlags & RenderResourceFlags::DSV) != RenderResourceFlags::None)
+		{
+			hasDepth = true;
+			depth = res._resourceHandle;
+			dsv = GetDSV(res._resourceHandle, res._subresources);
+		}
+		else if ((res._accessFlags & RenderResourceFlags::UAV) != RenderResourceFlags::None)
+		{
+			uavs.push_back(res._resourceHandle);
+			uavViews.push_back(GetUAV(res._resourceHandle, res._subresources));
+		}
+	}
 
-static Texture_t FindOrCreateTexture(RenderFormat format, u32 width, u32 height, RenderResourceFlags flags)
-{
-	u32 idx = 0;
-	for( ; idx < g_cachedTextures.size(); idx++ )
+	// UAV slots the pass rebinds are replaced, any others still holding a resource the pass uses are cleared.
+	const size_t keptUavSlots = pass._type == RenderPassType::COMPUTE ? uavs.size() : 0;
+	if (bound.uavs.size() > keptUavSlots)
 	{
-		if (g_cachedTextures[idx].format == format && g_cachedTextures[idx].dimensions.x == width && g_cachedTextures[idx].dimensions.y == height)
+		bool conflict = false;
+		for (size_t slot = keptUavSlots; slot < bound.uavs.size(); slot++)
+			conflict |= PassUsesResource(pass, bound.uavs[slot]);
+
+		if (conflict)
 		{
-			break;
+			const std::vector<UnorderedAccessView_t> empty(bound.uavs.size() - keptUavSlots, UnorderedAccessView_t::INVALID);
+			cl->BindComputeUAVs((uint32_t)keptUavSlots, (uint32_t)empty.size(), empty.data());
+
+			bound.uavs.resize(keptUavSlots);
+			bound.uavViews.resize(keptUavSlots);
+			bound.unbinds++;
 		}
 	}
 
-	if (idx < g_cachedTextures.size())
+	if (pass._type == RenderPassType::COMPUTE)
 	{
-		Texture_t found = g_cachedTextures[idx].textureHandle;
+		bool conflict = false;
+		for (const RenderPassResource& res : pass._resources)
+			conflict |= bound.IsRenderTarget(res._resourceHandle);
 
-		g_cachedTextures.erase(g_cachedTextures.begin() + idx);
+		if (conflict)
+		{
+			const RenderTargetView_t empty = RenderTargetView_t::INVALID;
+			cl->SetRenderTargets(&empty, 0, DepthStencilView_t::INVALID);
 
-		// Ensures we have all the views we need
-		if (Textures_CreateViewsForResourceFlags(found, flags))
-			return found;
+			bound.renderTargets.clear();
+			bound.rtvs.clear();
+			bound.depthBound = false;
+			bound.unbinds++;
+		}
 
-#if RG_VALIDATION
-		ASSERTMSG(0, "FindOrCreateTexture failed to create views for found texture");
-#endif
+		if (!uavViews.empty() && !(bound.uavViews.size() >= uavViews.size() && std::equal(uavViews.begin(), uavViews.end(), bound.uavViews.begin())))
+		{
+			cl->BindComputeUAVs(0, (uint32_t)uavViews.size(), uavViews.data());
+
+			if (bound.uavs.size() < uavs.size())
+			{
+				bound.uavs.resize(uavs.size());
+				bound.uavViews.resize(uavs.size());
+			}
 
-		return Texture_t::INVALID;
+			std::copy(uavs.begin(), uavs.end(), bound.uavs.begin());
+			std::copy(uavViews.begin(), uavViews.end(), bound.uavViews.begin());
+			bound.binds++;
+		}
 	}
-	else
+	else if (!renderTargets.empty() || hasDepth)
 	{
-		TextureCreateDesc texDesc = {};
-		texDesc.width = width;
-		texDesc.height = height;
-		texDesc.format = format;
-		texDesc.flags = flags;
-
-		Texture_t created = CreateTexture(texDesc);
+		if (rtvs == bound.rtvs && hasDepth == bound.depthBound && (!hasDepth || dsv == bound.dsv))
+			return;
 
-#if RG_VALIDATION
-		ASSERTMSG(created != Texture_t::INVALID, "FindOrCreateTexture failed to create texture");
-#endif
+		cl->SetRenderTargets(rtvs.data(), rtvs.size(), hasDepth ? dsv : DepthStencilView_t::INVALID);
 
-		return created;
+		bound.renderTargets = std::move(renderTargets);
+		bound.rtvs = std::move(rtvs);
+		bound.depthBound = hasDepth;
+		bound.depth = depth;
+		bound.dsv = dsv;
+		bound.binds++;
 	}
 }
 
-RenderPass& RenderPass::SetExecuteCallback(RenderGraphCallback_Func&& func)
+void RenderGraph::ClearPassTargets(size_t passIdx, CommandList* cl)
 {
-	_function = func;
+	auto it = std::lower_bound(_clears.begin(), _clears.end(), passIdx, [](const RenderGraphClear& clear, size_t pass) { return clear.pass < pass; });
 
-	return *this;
-}
+	for (; it != _clears.end() && it->pass == passIdx; it++)
+	{
+		const RenderGraphRegisteredResource& registeredRes = _registeredResources[(size_t)it->resource];
+		if (registeredRes.type == RenderGraphResourceType::BUFFER)
+		{
+			const uint32_t values[4] = { registeredRes.buffer.clearValue, registeredRes.buffer.clearValue, registeredRes.buffer.clearValue, registeredRes.buffer.clearValue };
+			cl->ClearUnorderedAccessView(GetUAV(it->resource), values);
+			continue;
+		}
 
-void RenderPass::AssertResourceUnique(RenderGraphResource_t res)
-{
-	ASSERTMSG(std::find_if(_resources.begin(), _resources.end(), [res](const RenderPassResource& a) {return a._resourceHandle == res; }) == _resources.end(),
-		"RenderPass::AssertResourceUnique failed, adding the same resource twice");
+		const RenderGraphTextureDesc& desc = _registeredResources[(size_t)it->resource].texture;
+
+		if ((it->view & RenderResourceFlags::RTV) != RenderResourceFlags::None)
+			cl->ClearRenderTarget(GetRTV(it->resource, it->subresources), desc.clearColor);
+		else if ((it->view & RenderResourceFlags::DSV) != RenderResourceFlags::None)
+			cl->ClearDepth(GetDSV(it->resource, it->subresources), desc.clearDepth);
+		else if ((it->view & RenderResourceFlags::UAV) != RenderResourceFlags::None)
+			cl->ClearUnorderedAccessView(GetUAV(it->resource, it->subresources), desc.clearColor);
+	}
 }
 
-RenderPass& RenderPass::AddResource(RenderGraphResource_t resource, RenderPassOutputAccess access, RenderResourceFlags flags)
+void RenderGraph::IssuePassBarriers(size_t passIdx, CommandList* cl)
 {
-	AssertResourceUnique(resource);
+	auto it = std::lower_bound(_barriers.begin(), _barriers.end(), passIdx, [](const RenderGraphBarrier& barrier, size_t pass) { return barrier.pass < pass; });
 
-	RenderPassResourceAccess ra = RenderPassResourceAccess::WRITE;
+	std::vector<ResourceBarrier> batch;
 
-	if (access == RenderPassOutputAccess::LOAD)
-		ra |= RenderPassResourceAccess::READ;
+	for (; it != _barriers.end() && it->pass == passIdx; it++)
+	{
+		ResourceBarrier barrier;
 
-	_resources.emplace_back(resource, ra, flags);
+		if (_resources[(size_t)it->resource].type == RenderGraphResourceType::BUFFER)
+			barrier.buffer = GetBuffer(it->resource);
+		else
+			barrier.texture = GetTexture(it->resource);
 
-	return *this;
-}
+		if (barrier.texture == Texture_t::INVALID && barrier.buffer == StructuredBuffer_t::INVALID)
+			continue;
 
-RenderPass& RenderPass::AddRenderTarget(RenderGraphResource_t resource, RenderPassOutputAccess access)
-{
-	return AddResource(resource, access, RenderResourceFlags::RTV);
-}
+		barrier.subresource = it->subresource;
+		barrier.before = it->before;
+		barrier.after = it->after;
 
-RenderPass& RenderPass::AddDepthTarget(RenderGraphResource_t resource, RenderPassOutputAccess access)
-{
-	return AddResource(resource, access, RenderResourceFlags::DSV);
+		batch.push_back(barrier);
+	}
+
+	cl->ResourceBarriers(batch.data(), batch.size());
 }
 
-RenderPass& RenderPass::AddComputeTarget(RenderGraphResource_t resource, RenderPassOutputAccess access)
+void RenderGraph::UploadConstants()
 {
-	return AddResource(resource, access, RenderResourceFlags::UAV);
+	if (_constantData.empty())
+		return;
+
+	const DynamicBuffer_t buffer = CreateDynamicConstantBuffer(_constantData.data(), _constantData.size());
+
+	for (RenderGraphConstantBlock& block : _constantBlocks)
+		block.buffer = GetDynamicConstantBufferRange(buffer, block.offset, block.size);
+
+	_stats.constantBlocks = (u32)_constantBlocks.size();
+	_stats.constantBytes = _constantData.size();
 }
 
-RenderPass& RenderPass::ReadResource(RenderGraphResource_t resource)
+static float TimePassCallback(const RenderPass& pass, RenderGraph& graph, CommandList* cl)
 {
-	AssertResourceUnique(resource);
+	const auto start = std::chrono::high_resolution_clock::now();
 
-	_resources.emplace_back(resource, RenderPassResourceAccess::READ, RenderResourceFlags::SRV);
+	pass._function(graph, cl);
 
-	return *this;
+	return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
 }
 
-RenderGraphResource_t RenderGraph::RegisterTexture(const std::string& name, const RenderGraphTextureDesc& desc)
+// Records the passes in [firstPass, endPass) into one command list, sharing the bound targets so
+// binds are only elided within the run.
+void RenderGraph::RecordPasses(size_t firstPass, size_t endPass, CommandList* cl, RGBoundTargets& bound)
 {
-	if (GetResource(name) != RenderGraphResource_t::NONE)
+	for (size_t passIdx = firstPass; passIdx < endPass; passIdx++)
 	{
-		LOGERROR("RenderGraph::RegisterTexture: %s is already registered", name.c_str());
-		return RenderGraphResource_t::NONE;
-	}
+		const RenderPass* rp = _consolidatedPasses[passIdx];
 
-	const RenderGraphResource_t handle = (RenderGraphResource_t)_registeredResources.size();
-	_registeredResourceMap[name] = handle;
+		IssuePassBarriers(passIdx, cl);
+		ClearPassTargets(passIdx, cl);
+		BindPassTargets(*rp, cl, bound);
 
-	_registeredResources.push_back({});
+		// Execute callback
+		if (_passTimes.empty())
+			rp->_function(*this, cl);
+		else
+			_passTimes[passIdx] = TimePassCallback(*rp, *this, cl);
+	}
 
-	RenderGraphRegisteredResource& res = _registeredResources.back();
+	if (endPass == _consolidatedPasses.size())
+		IssuePassBarriers(endPass, cl);
+}
 
-	res.flags = RenderResourceFlags::None;
-	res.type = RenderGraphResourceType::TEXTURE;
+void RenderGraph::Execute()
+{
+	const size_t passCount = _consolidatedPasses.size();
+	const u32 threadCount = GetRecordingThreadCount();
 
-	res.texture.format = desc.format;
-	res.texture.width = desc.width;
-	res.texture.height = desc.height;
+	_passTimes.assign(g_passTiming ? passCount : 0, 0.0f);
 
-	return handle;
-}
+	// The render layer submits to a single queue, passes are submitted in pass order which satisfies
+	// every dependency and sync point of the schedule.
 
-RenderGraphResource_t RenderGraph::AddExternalRTV(const std::string& name, RenderTargetView_t rtv, u32 width, u32 height)
-{
-	if (GetResource(name) != RenderGraphResource_t::NONE)
+	UploadConstants();
+
+	if (threadCount <= 1 || passCount <= 1)
 	{
-		LOGERROR("RenderGraph::AddExternalRTV: %s is already registered", name.c_str());
-		return RenderGraphResource_t::NONE;
+		CommandListPtr cl = CommandList::Create();
+		RGBoundTargets bound;
+
+		RecordPasses(0, passCount, cl.get(), bound);
+
+		CommandList::Execute(cl);
+
+		_stats.targetBinds = bound.binds;
+		_stats.targetUnbinds = bound.unbinds;
+
+		return;
 	}
 
-	const RenderGraphResource_t handle = (RenderGraphResource_t)_registeredResources.size();
-	_registeredResourceMap[name] = handle;
+	// Recording has no dependencies between passes, only submission does. The passes are split into
+	// one contiguous run per worker, each recorded into its own command list with its own bound
+	// targets, and the lists are submitted in pass order. Only the first pass of a run loses the
+	// targets bound by the pass before it.
+	// Command lists come from a shared free list so they are all acquired up front on this thread.
+	const size_t runCount = Min<size_t>(threadCount, passCount);
 
-	_registeredResources.push_back({});
+	std::vector<CommandListPtr> commandLists(runCount);
+	for (CommandListPtr& cl : commandLists)
+		cl = CommandList::Create();
 
-	_registeredResources.back().external = true;
+	std::vector<RGBoundTargets> boundTargets(runCount);
 
-	// Insert the rtv into the finalised resource array
-	if ((size_t)handle >= _resources.size())
+	g_workerPool.Resize(runCount - 1);
+	g_workerPool.ParallelFor(runCount, [this, passCount, runCount, &commandLists, &boundTargets](size_t run)
 	{
-		_resources.resize((size_t)handle + 1, {});
-		_resources.back().rtv = rtv;
-		_resources.back().texture.dimensions.x = width;
-		_resources.back().texture.dimensions.y = height;
+		RecordPasses(run * passCount / runCount, (run + 1) * passCount / runCount, commandLists[run].get(), boundTargets[run]);
+	});
+
+	for (CommandListPtr& cl : commandLists)
+		CommandList::Execute(cl);
+
+	_stats.targetBinds = 0;
+	_stats.targetUnbinds = 0;
+	for (const RGBoundTargets& bound : boundTargets)
+	{
+		_stats.targetBinds += bound.binds;
+		_stats.targetUnbinds += bound.unbinds;
 	}
+}
 
-	return handle;
+Texture_t RenderGraph::GetTexture(RenderGraphResource_t resource)
+{
+	return _resources[(size_t)resource].type == RenderGraphResourceType::TEXTURE ? _resources[(size_t)resource].texture.tex : Texture_t::INVALID;
 }
 
-RenderPass& RenderGraph::AddPass(const std::string& name, RenderPassType type)
+StructuredBuffer_t RenderGraph::GetBuffer(RenderGraphResource_t resource)
 {
-	_passes.emplace_back( RenderPass::Make(name, type) );
-	return _passes.back();
+	return _resources[(size_t)resource].buffer.buf;
 }
 
-RenderGraphResource_t RenderGraph::GetResource(const std::string& name)
+ShaderResourceView_t RenderGraph::GetSRV(RenderGraphResource_t resource)
 {
-	auto it = _registeredResourceMap.find(name);
-	return it != _registeredResourceMap.end() ? it->second : RenderGraphResource_t::NONE;
+	return _resources[(size_t)resource].srv;
 }
 
-struct RGNode
+RenderTargetView_t RenderGraph::GetRTV(RenderGraphResource_t resource)
 {
-	RGResourceBits reads = 0;
-	RGResourceBits writes = 0;
-	uint64_t rootAffinity = 0;
-	bool root = false;
-	bool contributes = false;
-	char const* name = nullptr;
-};
+	return _resources[(size_t)resource].rtv;
+}
 
-void RenderGraph::Build()
+DepthStencilView_t RenderGraph::GetDSV(RenderGraphResource_t resource)
 {
-	std::vector<RGNode> nodes;
-	std::array<RenderGraphResource_t, RG_MAX_RESOURCES> uniqueResources;
-	size_t numResources = 0;
+	return _resources[(size_t)resource].dsv;
+}
 
-	for (RenderPass& pass : _passes)
-	{
-		nodes.push_back({});
-		RGNode& node = nodes.back();
+UnorderedAccessView_t RenderGraph::GetUAV(RenderGraphResource_t resource)
+{
+	return _resources[(size_t)resource].uav;
+}
 
-		for (const RenderPassResource& res : pass._resources)
-		{
-			size_t resourceIdx = 0;
-			for (; resourceIdx < numResources; resourceIdx++)
-			{
-				if (uniqueResources[resourceIdx] == res._resourceHandle)
-					break;
-			}
+uint3 RenderGraph::GetResourceDimensions(RenderGraphResource_t resource)
+{
+	const RenderGraphResource& res = _resources[(size_t)resource];
+	if (res.type == RenderGraphResourceType::BUFFER)
+		return uint3(res.buffer.elementCount, 1, 1);
 
-			if (resourceIdx == numResources)
-			{
-				uniqueResources[resourceIdx] = res._resourceHandle;
-				numResources++;
+	return res.texture.dimensions;
+}
 
-				assert(numResources < RG_MAX_RESOURCES);
-			}
+// View Build created for the subresources of a transient texture, or null when the range covers the
+// whole texture or the resource only has its own views.
+const RGSubresourceView* RenderGraph::FindSubresourceView(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources) const
+{
+	const RenderGraphRegisteredResource& registeredRes = _registeredResources[(size_t)resource];
+	if (registeredRes.type != RenderGraphResourceType::TEXTURE || registeredRes.external)
+		return nullptr;
 
-			node.reads.set(resourceIdx, (res._access & RenderPassResourceAccess::READ) != RenderPassResourceAccess::NONE);
-			node.writes.set(resourceIdx, (res._access & RenderPassResourceAccess::WRITE) != RenderPassResourceAccess::NONE);
+	const u32 mipCount = Max(registeredRes.texture.mipCount, 1u);
+	const u32 sliceCount = Max(registeredRes.texture.arraySize, 1u);
+	const RenderGraphSubresourceRange range = ResolveSubresources(subresources, mipCount, sliceCount);
+	if (range.mipCount == mipCount && range.sliceCount == sliceCount)
+		return nullptr;
 
-			node.root = pass._root;
+	auto views = g_subresourceViews.find(_resources[(size_t)resource].texture.tex);
+	if (views == g_subresourceViews.end())
+		return nullptr;
 
-			node.name = pass._name.c_str();
-		}
-	}
+	const uint64_t key = GetSubresourceKey(range);
+	auto view = std::find_if(views->second.begin(), views->second.end(), [key](const RGSubresourceView& v) { return v.key == key; });
 
-	// Loop back from root nodes and track where any contributing writes are sourced from, skipping
-	// passes that dont contribute.
-	size_t rootCount = 0;
-	{
-		RGResourceBits reads;
-		
-		for (auto nodeIt = nodes.rbegin(); nodeIt != nodes.rend(); nodeIt++)
-		{
-			bool writesAreRead = (nodeIt->writes & reads).any();
+	return view != views->second.end() ? &*view : nullptr;
+}
 
-			if (!nodeIt->root && !writesAreRead)
-				continue;
+ShaderResourceView_t RenderGraph::GetSRV(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources)
+{
+	const RGSubresourceView* view = FindSubresourceView(resource, subresources);
+	return view ? view->srv : GetSRV(resource);
+}
 
-			// Any traced writes are removed, any new reads from this pass are added
-			reads = (reads & (~nodeIt->writes)) | nodeIt->reads;
+RenderTargetView_t RenderGraph::GetRTV(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources)
+{
+	const RGSubresourceView* view = FindSubresourceView(resource, subresources);
+	return view ? view->rtv : GetRTV(resource);
+}
 
-			nodeIt->contributes = true;
+DepthStencilView_t RenderGraph::GetDSV(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources)
+{
+	const RGSubresourceView* view = FindSubresourceView(resource, subresources);
+	return view ? view->dsv : GetDSV(resource);
+}
 
-			// If this root node is read by another root then it loses its status.
-			if (nodeIt->root && writesAreRead)
-				nodeIt->root = false;
+UnorderedAccessView_t RenderGraph::GetUAV(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources)
+{
+	const RGSubresourceView* view = FindSubresourceView(resource, subresources);
+	return view ? view->uav : GetUAV(resource);
+}
 
-			if (nodeIt->root)
-				rootCount++;
-		}
-	}
+uint3 RenderGraph::GetResourceDimensions(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources)
+{
+	const RenderGraphResource& res = _resources[(size_t)resource];
+	if (res.type == RenderGraphResourceType::BUFFER || res.external)
+		return GetResourceDimensions(resource);
 
-	{
-		std::vector<RGResourceBits> rootReads(rootCount);
-		std::vector<RGResourceBits> rootWrites(rootCount);
+	const u32 mip = Min(subresources.firstMip, Max(_registeredResources[(size_t)resource].texture.mipCount, 1u) - 1);
+	return uint3(Max(res.texture.dimensions.x >> mip, 1u), Max(res.texture.dimensions.y >> mip, 1u), res.texture.dimensions.z);
+}
 
-		{
-			// Test for isolated trees
+static void AppendFormat(std::string& out, const char* format, ...)
+{
+	char buffer[256];
 
-			uint64_t rootIndex = 0;
+	va_list args;
+	va_start(args, format);
+	const int length = vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
 
-			for (auto nodeIt = nodes.rbegin(); nodeIt != nodes.rend(); nodeIt++)
-			{
-				while (nodeIt != nodes.rend() && !nodeIt->root)
-					nodeIt++;
+	if (length > 0)
+		out.append(buffer, Min<size_t>((size_t)length, sizeof(buffer) - 1));
+}
 
-				if (nodeIt == nodes.rend())
-					break;
+// Quoted string for either format, both take the same escapes for quotes, backslashes and newlines.
+static void AppendQuoted(std::string& out, std::string_view str)
+{
+	out += '"';
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+			out += '\\';
+
+		if (c == '\n')
+			out += "\\n";
+		else if ((unsigned char)c < 0x20)
+			AppendFormat(out, "\\u%04x", (u32)c);
+		else
+			out += c;
+	}
+	out += '"';
+}
 
-				RGResourceBits& read = rootReads[rootIndex];
-				RGResourceBits& write = rootWrites[rootIndex];
+static const char* GetAccessName(const RenderPassResource& res)
+{
+	if ((res._accessFlags & RenderResourceFlags::RTV) != RenderResourceFlags::None)
+		return "rtv";
+	if ((res._accessFlags & RenderResourceFlags::DSV) != RenderResourceFlags::None)
+		return "dsv";
+	if ((res._accessFlags & RenderResourceFlags::UAV) != RenderResourceFlags::None)
+		return "uav";
+	return "srv";
+}
 
-				read = nodeIt->reads;
-				write = nodeIt->writes;
+static const char* GetOutputAccessName(RenderPassOutputAccess access)
+{
+	switch (access)
+	{
+	case RenderPassOutputAccess::LOAD: return "load";
+	case RenderPassOutputAccess::CLEAR: return "clear";
+	default: return "dont_care";
+	}
+}
 
-				nodeIt->rootAffinity |= (1ull << rootIndex);
+// Appends the mips and slices of a range that doesn't cover the whole resource, as " mip 1" or " slices 0-3".
+static void AppendSubresources(std::string& out, const RenderGraphSubresourceRange& range)
+{
+	auto AppendRange = [&out](const char* name, u32 first, u32 count)
+	{
+		if (count == 1)
+			AppendFormat(out, " %s %u", name, first);
+		else if (count == ~0u)
+			AppendFormat(out, " %ss %u+", name, first);
+		else
+			AppendFormat(out, " %ss %u-%u", name, first, first + count - 1);
+	};
+
+	if (range.firstMip != 0 || range.mipCount != ~0u)
+		AppendRange("mip", range.firstMip, range.mipCount);
+	if (range.firstSlice != 0 || range.sliceCount != ~0u)
+		AppendRange("slice", range.firstSlice, range.sliceCount);
+}
 
-				for (auto n = nodeIt + 1; n != nodes.rend(); n++)
-				{
-					if (n->root)
-						continue;
+std::string RenderGraph::Dump(RenderGraphDumpFormat format) const
+{
+	constexpr size_t kNotCompiled = SIZE_MAX;
 
-					// If we write to subsequent reads, add to current tree.
-					if ((n->writes & read).any())
-					{
-						read |= n->reads;
-						write |= n->writes;
+	const size_t passCount = _passes.size();
+	const size_t resourceCount = _registeredResources.size();
 
-						n->rootAffinity |= (1ull << rootIndex);
-					}
-				}
+	std::vector<size_t> compiledIndices(passCount, kNotCompiled);
+	for (size_t compiledIdx = 0; compiledIdx < _consolidatedPasses.size(); compiledIdx++)
+		compiledIndices[_consolidatedPasses[compiledIdx] - _passes.data()] = compiledIdx;
 
-				rootIndex++;
-			}
-		}
+	std::vector<std::string_view> resourceNames(resourceCount);
+	for (const auto& [name, handle] : _registeredResourceMap)
+		resourceNames[(size_t)handle] = name;
 
-		// Test isolated graphs for overlapping resource accesses and combine if detected.
+	// Lifetimes over the compiled pass order, resources only accessed by culled passes have none.
+	std::vector<std::pair<size_t, size_t>> lifetimes(resourceCount, { kNotCompiled, kNotCompiled });
+	for (size_t compiledIdx = 0; compiledIdx < _consolidatedPasses.size(); compiledIdx++)
+	{
+		for (const RenderPassResource& res : _consolidatedPasses[compiledIdx]->_resources)
 		{
-			std::vector<uint64_t> subgraphId(rootCount);
-			std::vector<int> subgraphIdIdx(rootCount);
+			auto& [firstUse, lastUse] = lifetimes[(size_t)res._resourceHandle];
+			if (firstUse == kNotCompiled)
+				firstUse = compiledIdx;
+			lastUse = compiledIdx;
+		}
+	}
 
-			for (size_t i = 0; i < rootCount; i++)
-			{
-				subgraphId[i] |= (1ull << i);
-				subgraphIdIdx[i] = (int)i;
-			}
+	std::vector<std::string> physicalNames(resourceCount);
+	for (const auto& [handle, physicalIdx] : _transientTextures)
+		physicalNames[(size_t)handle] = "texture" + std::to_string(physicalIdx);
+	for (const auto& [handle, physicalIdx] : _transientBuffers)
+		physicalNames[(size_t)handle] = "buffer" + std::to_string(physicalIdx);
 
-			for (size_t i = 0; i < rootCount; i++)
-			{
-				for (size_t j = i + 1; j < rootCount; j++)
-				{
-					// if i reads from j or j reads from i
-					if (!(rootReads[i] & rootWrites[j]).any() && !(rootReads[j] & rootWrites[i]).any())
-						continue;
+	auto GetQueueName = [this](size_t compiledIdx)
+	{
+		const bool async = compiledIdx < _schedule.passQueues.size() && _schedule.passQueues[compiledIdx] == RenderGraphQueue::ASYNC_COMPUTE;
+		return async ? "async_compute" : "graphics";
+	};
 
-					uint64_t combinedId = subgraphId[subgraphIdIdx[j]] | subgraphId[subgraphIdIdx[i]];
+	std::string out;
 
-					if (subgraphIdIdx[i] <= subgraphIdIdx[j])
-						subgraphIdIdx[j] = subgraphIdIdx[i];
-					else
-						subgraphIdIdx[i] = subgraphIdIdx[j];
+	if (format == RenderGraphDumpFormat::GRAPHVIZ)
+	{
+		out += "digraph RenderGraph\n{\n\trankdir=LR;\n";
 
-					subgraphId[subgraphIdIdx[i]] = combinedId;
-				}
+		for (size_t passIdx = 0; passIdx < passCount; passIdx++)
+		{
+			const RenderPass& pass = _passes[passIdx];
+			const size_t compiledIdx = compiledIndices[passIdx];
+
+			std::string label = pass._name;
+			if (compiledIdx == kNotCompiled)
+				label += "\nculled";
+			else
+			{
+				label += "\n#" + std::to_string(compiledIdx) + " " + GetQueueName(compiledIdx) + " subgraph " + std::to_string(_passSubgraphs[compiledIdx]);
+				if (!_passTimes.empty())
+					AppendFormat(label, "\n%.3fms", _passTimes[compiledIdx]);
 			}
 
-			subgraphIdIdx.erase(std::unique(subgraphIdIdx.begin(), subgraphIdIdx.end()), subgraphIdIdx.end());
+			AppendFormat(out, "\tp%zu [shape=box, label=", passIdx);
+			AppendQuoted(out, label);
+			if (compiledIdx == kNotCompiled)
+				out += ", style=dashed, color=gray";
+			if (pass._root)
+				out += ", peripheries=2";
+			out += "];\n";
+		}
 
-			// Consolidate and test queues dont overlap.
+		for (size_t handle = 0; handle < resourceCount; handle++)
+		{
+			const RenderGraphRegisteredResource& registeredRes = _registeredResources[handle];
+			const auto& [firstUse, lastUse] = lifetimes[handle];
+
+			std::string label(resourceNames[handle]);
+			if (registeredRes.external)
+				label += "\nexternal";
+			else if (!physicalNames[handle].empty())
+				label += "\n" + physicalNames[handle];
+			if (firstUse != kNotCompiled)
+				label += "\n#" + std::to_string(firstUse) + "-#" + std::to_string(lastUse);
+
+			AppendFormat(out, "\tr%zu [shape=ellipse, label=", handle);
+			AppendQuoted(out, label);
+			if (firstUse == kNotCompiled)
+				out += ", style=dashed, color=gray";
+			out += "];\n";
+		}
 
-			uint64_t checkSubgraph = 0;
-			for (size_t i = 0; i < subgraphIdIdx.size(); i++)
+		for (size_t passIdx = 0; passIdx < passCount; passIdx++)
+		{
+			for (const RenderPassResource& res : _passes[passIdx]._resources)
 			{
-				_affinityMasks.push_back(subgraphId[subgraphIdIdx[i]]);
+				std::string subresources;
+				AppendSubresources(subresources, res._subresources);
 
-				uint64_t q = subgraphId[subgraphIdIdx[i]];
-				assert(!(q& checkSubgraph)); // Subgraph isn't independent.
-				checkSubgraph |= q;
+				if ((res._access & RenderPassResourceAccess::READ) != RenderPassResourceAccess::NONE)
+				{
+					AppendFormat(out, "\tr%u -> p%zu", (u32)res._resourceHandle, passIdx);
+					if (!subresources.empty())
+						AppendFormat(out, " [label=\"%s\"]", subresources.c_str() + 1);
+					out += ";\n";
+				}
+				if ((res._access & RenderPassResourceAccess::WRITE) != RenderPassResourceAccess::NONE)
+					AppendFormat(out, "\tp%zu -> r%u [label=\"%s%s\"];\n", passIdx, (u32)res._resourceHandle, GetOutputAccessName(res._outputAccess), subresources.c_str());
 			}
 		}
+
+		out += "}\n";
+		return out;
 	}
 
-	// Remove non-contributing passes
+	out += "{\n\t\"passes\": [";
+
+	for (size_t passIdx = 0; passIdx < passCount; passIdx++)
 	{
-		size_t numPasses = _passes.size();
+		const RenderPass& pass = _passes[passIdx];
+		const size_t compiledIdx = compiledIndices[passIdx];
 
-		_consolidatedPasses.reserve(numPasses);
+		out += passIdx > 0 ? ",\n\t\t{ \"name\": " : "\n\t\t{ \"name\": ";
+		AppendQuoted(out, pass._name);
+		AppendFormat(out, ", \"type\": \"%s\", \"root\": %s, \"culled\": %s", pass._type == RenderPassType::COMPUTE ? "compute" : "graphics",
+			pass._root ? "true" : "false", compiledIdx == kNotCompiled ? "true" : "false");
 
-		for (size_t i = 0; i < numPasses; i++)
+		if (pass._view != ~0u)
 		{
-			if (nodes[i].contributes)
-				_consolidatedPasses.push_back(&_passes[i]);
+			out += ", \"view\": ";
+			AppendQuoted(out, _viewNames[pass._view]);
 		}
-	}
 
-	// Build textures
-	{
-		//  Assign access flags
+		if (compiledIdx != kNotCompiled)
 		{
-			for (const RenderPass* rp : _consolidatedPasses)
-			{
-				for (const RenderPassResource& res : rp->_resources)
-				{
-					_registeredResources[(size_t)res._resourceHandle].flags |= res._accessFlags;
-				}
-			}
+			AppendFormat(out, ", \"order\": %zu, \"queue\": \"%s\", \"subgraph\": %u", compiledIdx, GetQueueName(compiledIdx), _passSubgraphs[compiledIdx]);
+			if (!_passTimes.empty())
+				AppendFormat(out, ", \"cpuTimeMs\": %.4f", _passTimes[compiledIdx]);
 		}
 
-		std::unordered_set<RenderGraphResource_t> usedResources;
-		for (const RenderPass* rp : _consolidatedPasses)
+		out += ", \"resources\": [";
+		for (size_t i = 0; i < pass._resources.size(); i++)
 		{
-			for (const RenderPassResource& res : rp->_resources)
+			const RenderPassResource& res = pass._resources[i];
+			const bool reads = (res._access & RenderPassResourceAccess::READ) != RenderPassResourceAccess::NONE;
+			const bool writes = (res._access & RenderPassResourceAccess::WRITE) != RenderPassResourceAccess::NONE;
+
+			AppendFormat(out, "%s{ \"resource\": %u, \"access\": \"%s\", \"view\": \"%s\"", i > 0 ? ", " : "", (u32)res._resourceHandle,
+				reads && writes ? "read_write" : writes ? "write" : "read", GetAccessName(res));
+			if (writes)
+				AppendFormat(out, ", \"output\": \"%s\"", GetOutputAccessName(res._outputAccess));
+			if (!(res._subresources == RenderGraphSubresourceRange{}))
 			{
-				usedResources.insert(res._resourceHandle);
+				// Counts of -1 run to the last mip or slice.
+				AppendFormat(out, ", \"subresources\": { \"firstMip\": %u, \"mipCount\": %d, \"firstSlice\": %u, \"sliceCount\": %d }",
+					res._subresources.firstMip, (int)res._subresources.mipCount, res._subresources.firstSlice, (int)res._subresources.sliceCount);
 			}
+			out += " }";
 		}
+		out += "] }";
+	}
 
-		for (RenderGraphResource_t handle : usedResources)
-		{
-			if ((size_t)handle >= _resources.size())
-			{
-				_resources.resize((size_t)handle + 1, {});
-			}
+	out += "\n\t],\n\t\"resources\": [";
 
-			RenderGraphRegisteredResource registeredRes = _registeredResources[(size_t)handle];
-			RenderGraphResource& res = _resources[(size_t)handle];
+	for (size_t handle = 0; handle < resourceCount; handle++)
+	{
+		const RenderGraphRegisteredResource& registeredRes = _registeredResources[handle];
+		const auto& [firstUse, lastUse] = lifetimes[handle];
 
-			if (res.external)
-				continue;
+		out += handle > 0 ? ",\n\t\t{ \"name\": " : "\n\t\t{ \"name\": ";
+		AppendQuoted(out, resourceNames[handle]);
+		AppendFormat(out, ", \"type\": \"%s\", \"external\": %s", registeredRes.type == RenderGraphResourceType::BUFFER ? "buffer" : "texture", registeredRes.external ? "true" : "false");
 
-			res.type = registeredRes.type;
+		// External targets are described by their view, the graph has no desc for them.
+		if (registeredRes.external)
+			AppendFormat(out, ", \"view\": \"rtv\"");
+		else if (registeredRes.type == RenderGraphResourceType::BUFFER)
+			AppendFormat(out, ", \"elementSize\": %u, \"elementCount\": %u", registeredRes.buffer.elementSize, registeredRes.buffer.elementCount);
+		else
+			AppendFormat(out, ", \"width\": %u, \"height\": %u, \"mips\": %u, \"arraySize\": %u", registeredRes.texture.width, registeredRes.texture.height, registeredRes.texture.mipCount, registeredRes.texture.arraySize);
 
-			if (registeredRes.type == RenderGraphResourceType::TEXTURE)
-			{
-				res.texture.tex = FindOrCreateTexture(registeredRes.texture.format, registeredRes.texture.width, registeredRes.texture.height, registeredRes.flags);
-				res.texture.dimensions = uint3(registeredRes.texture.width, registeredRes.texture.height, 1);
-				res.srv = GetTextureSRV(res.texture.tex);
-				res.rtv = GetTextureRTV(res.texture.tex);
-				res.dsv = GetTextureDSV(res.texture.tex);
-				res.uav = GetTextureUAV(res.texture.tex);
-			}
-		}
+		if (firstUse != kNotCompiled)
+			AppendFormat(out, ", \"firstPass\": %zu, \"lastPass\": %zu", firstUse, lastUse);
 
-		// Clear cached textures
-		for (const auto& tex : g_cachedTextures)
-		{
-			Render_Release(tex.textureHandle);
-		}
+		if (!physicalNames[handle].empty())
+			AppendFormat(out, ", \"physical\": \"%s\"", physicalNames[handle].c_str());
 
-		g_cachedTextures.clear();
+		out += " }";
 	}
-}
 
-void RenderGraph::Execute()
-{
-	CommandListPtr cl = CommandList::Create();
-
-	for (const RenderPass* rp : _consolidatedPasses)
-	{
-		// If we require end barriers, we execute them here.
+	// Dependencies and sync points refer to passes by their compiled order.
+	out += "\n\t],\n\t\"dependencies\": [";
+	for (size_t i = 0; i < _schedule.dependencies.size(); i++)
+		AppendFormat(out, "%s[%u, %u]", i > 0 ? ", " : "", _schedule.dependencies[i].first, _schedule.dependencies[i].second);
 
-		// Execute callback
-		rp->_function(*this, cl.get());
+	out += "],\n\t\"syncPoints\": [";
+	for (size_t i = 0; i < _schedule.syncPoints.size(); i++)
+		AppendFormat(out, "%s[%u, %u]", i > 0 ? ", " : "", _schedule.syncPoints[i].signalPass, _schedule.syncPoints[i].waitPass);
 
-		// Insert begin barriers
-	}
+	AppendFormat(out, "],\n\t\"stats\": { \"compiledPasses\": %zu, \"views\": %zu, \"subgraphs\": %u, \"physicalTextures\": %u, \"physicalBuffers\": %u, \"unaliasedBytes\": %zu, \"aliasedBytes\": %zu, ",
+		_consolidatedPasses.size(), _viewNames.size(), _stats.subgraphs, _stats.physicalTextures, _stats.physicalBuffers, _stats.unaliasedBytes, _stats.aliasedBytes);
+	AppendFormat(out, "\"clears\": %u, \"elidedClears\": %u, \"barriers\": %u, \"compiledFromCache\": %s }\n}\n", _stats.clears, _stats.elidedClears, _stats.barriers, _stats.compiledFromCache ? "true" : "false");
 
-	CommandList::Execute(cl);
+	return out;
 }
 
-ShaderResourceView_t RenderGraph::GetSRV(RenderGraphResource_t resource)
+RenderGraph::~RenderGraph()
 {
-	return _resources[(size_t)resource].srv;
-}
+	for (const RenderGraphPhysicalTexture& physical : _physicalTextures)
+	{
+		g_texturePool.Return(MakeTextureKey(physical.desc, physical.flags), physical.tex);
+	}
 
-RenderTargetView_t RenderGraph::GetRTV(RenderGraphResource_t resource)
-{
-	return _resources[(size_t)resource].rtv;
+	for (const RenderGraphPhysicalBuffer& physical : _physicalBuffers)
+	{
+		g_bufferPool.Return(MakeBufferKey(physical.desc, physical.flags), { physical.buf, physical.srv, physical.uav });
+	}
 }
 
-DepthStencilView_t RenderGraph::GetDSV(RenderGraphResource_t resource)
+RenderGraphScheduleTiming RenderGraph_SimulateSchedule(const RenderGraphSchedule& schedule, const float* passCosts)
 {
-	return _resources[(size_t)resource].dsv;
-}
+	RenderGraphScheduleTiming timing;
 
-UnorderedAccessView_t RenderGraph::GetUAV(RenderGraphResource_t resource)
-{
-	return _resources[(size_t)resource].uav;
-}
+	const size_t passCount = schedule.passQueues.size();
 
-uint3 RenderGraph::GetResourceDimensions(RenderGraphResource_t resource)
-{
-	return _resources[(size_t)resource].texture.dimensions;
-}
+	std::vector<float> finish(passCount, 0.0f);
+	std::vector<float> earliestFinish(passCount, 0.0f);
+	float queueTime[(size_t)RenderGraphQueue::COUNT] = {};
 
-RenderGraph::~RenderGraph()
-{
-	for (const RenderGraphResource& resource : _resources)
+	size_t syncIdx = 0;
+	size_t dependencyIdx = 0;
+
+	for (size_t passIdx = 0; passIdx < passCount; passIdx++)
 	{
-		if (resource.type == RenderGraphResourceType::TEXTURE)
-		{
-			RGCachedTexture tex = {};
-			tex.format = resource.texture.format;
-			tex.dimensions = resource.texture.dimensions;
-			tex.textureHandle = resource.texture.tex;
-			g_cachedTextures.push_back(tex);
-		}
+		const size_t queue = (size_t)schedule.passQueues[passIdx];
+
+		float start = queueTime[queue];
+		for (; syncIdx < schedule.syncPoints.size() && schedule.syncPoints[syncIdx].waitPass == passIdx; syncIdx++)
+			start = Max(start, finish[schedule.syncPoints[syncIdx].signalPass]);
+
+		finish[passIdx] = start + passCosts[passIdx];
+		queueTime[queue] = finish[passIdx];
+
+		float earliestStart = 0.0f;
+		for (; dependencyIdx < schedule.dependencies.size() && schedule.dependencies[dependencyIdx].second == passIdx; dependencyIdx++)
+			earliestStart = Max(earliestStart, earliestFinish[schedule.dependencies[dependencyIdx].first]);
+
+		earliestFinish[passIdx] = earliestStart + passCosts[passIdx];
+
+		timing.serialTime += passCosts[passIdx];
+		timing.scheduledTime = Max(timing.scheduledTime, finish[passIdx]);
+		timing.criticalPathTime = Max(timing.criticalPathTime, earliestFinish[passIdx]);
 	}
-}
 
+	// A queue only waits on a pass the other queue is running, so one queue is always busy and any
+	// time saved over running serially is time both queues were busy.
+	timing.overlapTime = timing.serialTime - timing.scheduledTime;
+
+	return timing;
+}
\ No newline at end of file
@@ -14,6 +14,15 @@ enum class RenderPassType : u8
 	COMPUTE,
 };
 
+// Logical queues passes are scheduled on. Compute passes with no dependency on graphics work, or
+// marked with RenderPass::MakeAsyncCompute, run on the async compute queue.
+enum class RenderGraphQueue : u8
+{
+	GRAPHICS,
+	ASYNC_COMPUTE,
+	COUNT,
+};
+
 enum class RenderPassResourceAccess : u32
 {
 	NONE = 0,
@@ -38,23 +47,54 @@ enum class RenderGraphResourceType : u8
 };
 
 enum class RenderGraphResource_t : u32 { NONE };
+enum class RenderGraphConstants_t : u32 { NONE };
+
+// Mips and array slices of a texture a pass accesses, counts of ~0u run to the last mip or slice.
+// The default range is the whole texture. Render, depth and compute targets bind the first mip of
+// the range, reads see every mip in it. Buffers and external targets are always accessed whole.
+struct RenderGraphSubresourceRange
+{
+	u32 firstMip = 0;
+	u32 mipCount = ~0u;
+	u32 firstSlice = 0;
+	u32 sliceCount = ~0u;
+
+	static RenderGraphSubresourceRange Mip(u32 mip) { return { mip, 1, 0, ~0u }; }
+	static RenderGraphSubresourceRange Slice(u32 slice) { return { 0, ~0u, slice, 1 }; }
+	static RenderGraphSubresourceRange MipSlice(u32 mip, u32 slice) { return { mip, 1, slice, 1 }; }
+
+	bool operator==(const RenderGraphSubresourceRange& other) const
+	{
+		return firstMip == other.firstMip && mipCount == other.mipCount && firstSlice == other.firstSlice && sliceCount == other.sliceCount;
+	}
+};
 
 struct RenderPassResource
 {
 	RenderGraphResource_t _resourceHandle;	
 	RenderPassResourceAccess _access;
 	RenderResourceFlags _accessFlags;
+	RenderPassOutputAccess _outputAccess;
+	RenderGraphSubresourceRange _subresources;
 
-	RenderPassResource(RenderGraphResource_t resHandle, RenderPassResourceAccess access, RenderResourceFlags flags)
+	RenderPassResource(RenderGraphResource_t resHandle, RenderPassResourceAccess access, RenderResourceFlags flags, RenderPassOutputAccess outputAccess, const RenderGraphSubresourceRange& subresources = {})
 		: _resourceHandle(resHandle)
 		, _access(access)
 		, _accessFlags(flags)
+		, _outputAccess(outputAccess)
+		, _subresources(subresources)
 	{}
 
 	inline constexpr bool operator==(const RenderPassResource& other) { return other._resourceHandle == _resourceHandle; }
 };
 
 struct RenderGraph;
+struct RGBoundTargets;
+struct RGSubresourceView;
+
+// Execute callbacks may be called from worker threads, see RenderGraph_SetRecordingThreadCount.
+// The render, depth and compute targets a pass declares are bound before its callback runs,
+// render targets in declaration order and compute targets to UAV slots from 0.
 //typedef void (*RenderGraphCallback_Func)(RenderGraph&, CommandList* cl);
 using RenderGraphCallback_Func = std::function<void(RenderGraph&, CommandList* cl)>;
 
@@ -66,9 +106,11 @@ struct RenderPass
 	std::vector<RenderPassResource> _resources;
 
 	bool _root = false;
+	bool _asyncCompute = false;
+	u32 _view = ~0u;	// Index of the view that added the pass, ~0u for shared passes.
 	RenderGraphCallback_Func _function = nullptr;
 
-	void AssertResourceUnique(RenderGraphResource_t res);
+	void AssertResourceUnique(RenderGraphResource_t res, const RenderGraphSubresourceRange& subresources);
 
 	RenderPass(const std::string& name, RenderPassType type)
 		: _name(name)
@@ -79,48 +121,205 @@ public:
 	static RenderPass Make(const std::string& name, RenderPassType type) { return RenderPass{ name, type }; }
 
 	RenderPass& SetExecuteCallback(RenderGraphCallback_Func&& func);
-	RenderPass& AddRenderTarget(RenderGraphResource_t resource, RenderPassOutputAccess access);
-	RenderPass& AddDepthTarget(RenderGraphResource_t resource, RenderPassOutputAccess access);
-	RenderPass& AddComputeTarget(RenderGraphResource_t resource, RenderPassOutputAccess access);
-	RenderPass& AddResource(RenderGraphResource_t resource, RenderPassOutputAccess access, RenderResourceFlags flags);
-	RenderPass& ReadResource(RenderGraphResource_t tex);
+	// A pass may access a resource more than once through disjoint subresource ranges, such as reading
+	// one mip of a texture while writing the next.
+	RenderPass& AddRenderTarget(RenderGraphResource_t resource, RenderPassOutputAccess access, const RenderGraphSubresourceRange& subresources = {});
+	RenderPass& AddDepthTarget(RenderGraphResource_t resource, RenderPassOutputAccess access, const RenderGraphSubresourceRange& subresources = {});
+	RenderPass& AddComputeTarget(RenderGraphResource_t resource, RenderPassOutputAccess access, const RenderGraphSubresourceRange& subresources = {});
+	RenderPass& AddResource(RenderGraphResource_t resource, RenderPassOutputAccess access, RenderResourceFlags flags, const RenderGraphSubresourceRange& subresources = {});
+	RenderPass& ReadResource(RenderGraphResource_t tex, const RenderGraphSubresourceRange& subresources = {});
 	RenderPass& MakeRoot() { _root = true; return *this; }
+	RenderPass& MakeAsyncCompute();
 };
 
 struct RenderGraphTextureDesc
 {
 	u32 width = 0;
 	u32 height = 0;
+	u32 mipCount = 1;
+	u32 arraySize = 1;
 	RenderFormat format = RenderFormat::UNKNOWN;
+
+	// Values written by passes that add the texture with RenderPassOutputAccess::CLEAR.
+	float clearColor[4] = {};
+	float clearDepth = 1.0f;
+};
+
+// Structured buffer created by the graph, passes access it through SRVs and compute target UAVs.
+struct RenderGraphBufferDesc
+{
+	u32 elementSize = 0;
+	u32 elementCount = 0;
+
+	// Written to every word of the buffer by passes that add it with RenderPassOutputAccess::CLEAR.
+	u32 clearValue = 0;
+};
+
+// Instance of a sub-graph added by RenderGraph::AddViews. Setup callbacks use the index to look up
+// their own per view parameters such as cameras and viewports.
+struct RenderGraphView
+{
+	std::string name;
+	u32 index = 0;
+};
+
+using RenderGraphViewSetup_Func = std::function<void(RenderGraph&, const RenderGraphView&)>;
+
+// Transient textures and buffers are the non-external resources the graph creates for a frame.
+// Transients whose pass lifetimes don't overlap share a physical resource, see
+// RenderGraph_SetTransientAliasing. Memory totals cover textures and buffers.
+struct RenderGraphStats
+{
+	u32 transientTextures = 0;
+	u32 physicalTextures = 0;
+	u32 transientBuffers = 0;
+	u32 physicalBuffers = 0;
+	size_t unaliasedBytes = 0;
+	size_t aliasedBytes = 0;
+	bool compiledFromCache = false;
+	u32 subgraphs = 0;
+	u32 views = 0;
+
+	// Target clears issued at the start of passes, and CLEAR accesses skipped because the pass output is overwritten before being read.
+	u32 clears = 0;
+	u32 elidedClears = 0;
+
+	// Constant blocks added to the graph and the bytes uploaded for them, including alignment.
+	u32 constantBlocks = 0;
+	size_t constantBytes = 0;
+
+	// Passes scheduled on the async compute queue and the cross queue waits between them and graphics passes.
+	u32 asyncComputePasses = 0;
+	u32 syncPoints = 0;
+
+	// Passes binding different targets to the last pass that bound any, and resources accessed through
+	// a different view to their previous access. Counted in the compiled pass order and in the order
+	// the passes were added, which only differ with RenderGraph_SetPassReordering.
+	u32 targetSwitches = 0;
+	u32 resourceTransitions = 0;
+	u32 addedOrderTargetSwitches = 0;
+	u32 addedOrderResourceTransitions = 0;
+
+	// State transitions issued between passes, and the pass boundaries that needed any.
+	u32 barriers = 0;
+	u32 barrierBatches = 0;
+
+	// Render and compute target binds issued by Execute, and unbinds needed so a pass could access a bound target.
+	u32 targetBinds = 0;
+	u32 targetUnbinds = 0;
+};
+
+// A wait by waitPass for signalPass on the other queue to finish. Passes on a queue run in order,
+// so a pass only waits for its latest dependency on the other queue that an earlier pass on its own
+// queue hasn't already waited for.
+struct RenderGraphSyncPoint
+{
+	u32 signalPass = 0;
+	u32 waitPass = 0;
+};
+
+// Queue assignment of the consolidated passes. Sync points are ordered by waitPass, dependencies
+// are {producer, consumer} pairs of passes sharing a resource, ordered by consumer.
+struct RenderGraphSchedule
+{
+	std::vector<RenderGraphQueue> passQueues;
+	std::vector<RenderGraphSyncPoint> syncPoints;
+	std::vector<std::pair<u32, u32>> dependencies;
+};
+
+enum class RenderGraphDumpFormat : u8
+{
+	GRAPHVIZ,
+	JSON,
 };
 
 struct RenderGraph
 {
 	RenderGraphResource_t RegisterTexture(const std::string& name, const RenderGraphTextureDesc& desc);
+	RenderGraphResource_t RegisterBuffer(const std::string& name, const RenderGraphBufferDesc& desc);
 	RenderGraphResource_t AddExternalRTV(const std::string& name, RenderTargetView_t rtv, u32 width, u32 height);
 	RenderPass& AddPass(const std::string& name, RenderPassType type);
 
+	// Runs setup once per view to instantiate a sub-graph for each. Resources registered and passes
+	// added by setup are named "<view>/<name>", and GetResource called in setup finds the view's own
+	// resources before shared ones, so one setup serves any number of views. Everything added outside
+	// AddViews is shared: view independent passes like shadows are added and culled once and every
+	// view can read their outputs. The views compile, cache and submit as one graph, and their
+	// transients alias each other and come from the same pools, so N views cost less than N graphs.
+	void AddViews(const std::vector<std::string>& viewNames, const RenderGraphViewSetup_Func& setup);
+
+	// Constant data for passes is declared while setting up the graph. Execute packs every block into
+	// a single dynamic constant buffer before recording, callbacks bind their block with GetConstants.
+	RenderGraphConstants_t AddConstants(const void* data, size_t size);
+
+	template<typename T>
+	RenderGraphConstants_t AddConstants(const T& data) { return AddConstants(&data, sizeof(T)); }
+
+	DynamicBuffer_t GetConstants(RenderGraphConstants_t constants);
+
 	RenderGraphResource_t GetResource(const std::string& name);
 
 	Texture_t GetTexture(RenderGraphResource_t resource);
+	StructuredBuffer_t GetBuffer(RenderGraphResource_t resource);
 	ShaderResourceView_t GetSRV(RenderGraphResource_t resource);
 	RenderTargetView_t GetRTV(RenderGraphResource_t resource);
 	DepthStencilView_t GetDSV(RenderGraphResource_t resource);
 	UnorderedAccessView_t GetUAV(RenderGraphResource_t resource);
 	uint3 GetResourceDimensions(RenderGraphResource_t resource);
 
+	// Views of the subresource ranges passes declared, for use in their callbacks. Dimensions are
+	// those of the first mip in the range.
+	ShaderResourceView_t GetSRV(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources);
+	RenderTargetView_t GetRTV(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources);
+	DepthStencilView_t GetDSV(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources);
+	UnorderedAccessView_t GetUAV(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources);
+	uint3 GetResourceDimensions(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources);
+
 	void Build();
 
 	void Execute();
 
+	const RenderGraphStats& GetStats() const { return _stats; }
+	const RenderGraphSchedule& GetSchedule() const { return _schedule; }
+
+	// Describes what Build decided for every added pass and registered resource: culled passes,
+	// roots, queues and subgraphs, resource lifetimes over the compiled pass order and the physical
+	// resource backing each transient. After an Execute with RenderGraph_SetPassTiming enabled it
+	// also holds the CPU time of each pass callback. Graphviz output draws resources as ellipses
+	// between the passes accessing them with culled passes dashed.
+	std::string Dump(RenderGraphDumpFormat format) const;
+
 	~RenderGraph();
 
 private:
+	friend struct RGCompiledGraph;
+
+	std::string GetScopedName(const std::string& name) const;
+
+	const RGSubresourceView* FindSubresourceView(RenderGraphResource_t resource, const RenderGraphSubresourceRange& subresources) const;
+
+	void Compile();
+	void GetStructure(std::vector<uint64_t>& structure) const;
+	void BindPassTargets(const RenderPass& pass, CommandList* cl, RGBoundTargets& bound);
+	void ClearPassTargets(size_t passIdx, CommandList* cl);
+	void IssuePassBarriers(size_t passIdx, CommandList* cl);
+	void RecordPasses(size_t firstPass, size_t endPass, CommandList* cl, RGBoundTargets& bound);
+	void UploadConstants();
+
 	RenderView* _view = nullptr;
 
+	// Names of the views added so far, and the view setup is running for while in AddViews.
+	std::vector<std::string> _viewNames;
+	u32 _currentView = ~0u;
+
 	std::vector<RenderPass> _passes;
 	std::vector<RenderPass*> _consolidatedPasses;
-	std::vector<uint64_t> _affinityMasks;
+
+	// Independent subgraph of each consolidated pass, passes in different subgraphs share no resources.
+	std::vector<u32> _passSubgraphs;
+	u32 _subgraphCount = 0;
+
+	RenderGraphSchedule _schedule;
 
 	struct RenderGraphRegisteredResource
 	{
@@ -128,19 +327,8 @@ private:
 		RenderResourceFlags flags = RenderResourceFlags::None;
 		RenderGraphResourceType type = RenderGraphResourceType::NONE;
 
-		union
-		{
-			struct
-			{
-				u32 width = 0;
-				u32 height = 0;
-				RenderFormat format = RenderFormat::UNKNOWN;
-			} texture;
-			struct
-			{
-				u32 size = 0;
-			} buffer;
-		};
+		RenderGraphTextureDesc texture;
+		RenderGraphBufferDesc buffer;
 	};
 
 	std::map<std::string, RenderGraphResource_t> _registeredResourceMap;
@@ -154,6 +342,7 @@ private:
 		RenderTargetView_t rtv = RenderTargetView_t::INVALID;
 		DepthStencilView_t dsv = DepthStencilView_t::INVALID;
 		UnorderedAccessView_t uav = UnorderedAccessView_t::INVALID;
+
 		union
 		{
 			struct
@@ -163,8 +352,140 @@ private:
 				uint3 dimensions = {};
 			} texture;
 		};
+
+		struct
+		{
+			StructuredBuffer_t buf = StructuredBuffer_t::INVALID;
+			u32 elementCount = 0;
+		} buffer;
 	};
 
 	std::map<std::string, RenderGraphResource_t> _consolidatedResourceMap;
 	std::vector<RenderGraphResource> _resources;
-};
\ No newline at end of file
+
+	// Pooled textures backing the transient resources, aliased resources share an entry.
+	struct RenderGraphPhysicalTexture
+	{
+		Texture_t tex = Texture_t::INVALID;
+		RenderGraphTextureDesc desc = {};
+		RenderResourceFlags flags = RenderResourceFlags::None;
+	};
+
+	std::vector<RenderGraphPhysicalTexture> _physicalTextures;
+
+	// Transient resources and the index of the physical texture backing them.
+	std::vector<std::pair<RenderGraphResource_t, size_t>> _transientTextures;
+
+	struct RenderGraphPhysicalBuffer
+	{
+		StructuredBuffer_t buf = StructuredBuffer_t::INVALID;
+		ShaderResourceView_t srv = ShaderResourceView_t::INVALID;
+		UnorderedAccessView_t uav = UnorderedAccessView_t::INVALID;
+		RenderGraphBufferDesc desc = {};
+		RenderResourceFlags flags = RenderResourceFlags::None;
+	};
+
+	std::vector<RenderGraphPhysicalBuffer> _physicalBuffers;
+	std::vector<std::pair<RenderGraphResource_t, size_t>> _transientBuffers;
+
+	// Clears issued at the start of each consolidated pass, ordered by pass.
+	struct RenderGraphClear
+	{
+		size_t pass = 0;
+		RenderGraphResource_t resource = RenderGraphResource_t::NONE;
+		RenderResourceFlags view = RenderResourceFlags::None;
+		RenderGraphSubresourceRange subresources = {};
+	};
+
+	std::vector<RenderGraphClear> _clears;
+
+	// Transitions issued before each consolidated pass, ordered by pass. Barriers for pass count
+	// follow the last pass and return textures to the state the graph found them in. Textures whose
+	// subresources are all in the same state transition together with kAllSubresources.
+	struct RenderGraphBarrier
+	{
+		size_t pass = 0;
+		RenderGraphResource_t resource = RenderGraphResource_t::NONE;
+		u32 subresource = kAllSubresources;
+		ResourceState before = ResourceState::Common;
+		ResourceState after = ResourceState::Common;
+	};
+
+	std::vector<RenderGraphBarrier> _barriers;
+
+	// Constant blocks packed at kDynamicConstantBufferAlignment, the ranges are filled in by Execute.
+	struct RenderGraphConstantBlock
+	{
+		size_t offset = 0;
+		size_t size = 0;
+		DynamicBuffer_t buffer = DynamicBuffer_t::INVALID;
+	};
+
+	std::vector<uint8_t> _constantData;
+	std::vector<RenderGraphConstantBlock> _constantBlocks;
+
+	// CPU time in milliseconds of each consolidated pass callback, empty unless Execute timed the passes.
+	std::vector<float> _passTimes;
+
+	RenderGraphStats _stats;
+};
+
+// Number of threads RenderGraph::Execute records passes on, including the calling thread.
+// 0 uses the hardware thread count, 1 records every pass serially into a single command list.
+void RenderGraph_SetRecordingThreadCount(u32 count);
+
+// Lets transient textures with disjoint lifetimes share a physical texture, on by default.
+void RenderGraph_SetTransientAliasing(bool enabled);
+
+// Schedules compute passes on the async compute queue, on by default. When disabled every pass is
+// scheduled on the graphics queue.
+void RenderGraph_SetAsyncCompute(bool enabled);
+
+// Lets Compile reorder passes within their dependencies to group passes binding the same targets
+// and move consumers away from their producers, off by default. Transient textures may live longer
+// in the new order and alias less.
+void RenderGraph_SetPassReordering(bool enabled);
+
+// Execute records the CPU time of every pass callback for RenderGraph::Dump, off by default.
+void RenderGraph_SetPassTiming(bool enabled);
+
+// Build skips compiling a graph with the same passes and resource accesses as the last compiled
+// graph and reuses its result, on by default.
+void RenderGraph_SetCompileCaching(bool enabled);
+bool RenderGraph_GetCompileCaching();
+
+// Physical textures and buffers are pooled across graphs, in a pool each. Idle resources are released
+// after not being used for a number of graph builds, or oldest first while their pool holds more
+// than its budget.
+struct RenderGraphPoolStats
+{
+	u32 resources = 0;
+	u32 idleResources = 0;
+	size_t bytes = 0;
+	size_t idleBytes = 0;
+	size_t creates = 0;
+	size_t releases = 0;
+};
+
+void RenderGraph_SetTexturePoolBudget(size_t bytes);
+void RenderGraph_SetBufferPoolBudget(size_t bytes);
+void RenderGraph_SetPoolMaxFrameAge(u32 frames);
+const RenderGraphPoolStats& RenderGraph_GetTexturePoolStats();
+const RenderGraphPoolStats& RenderGraph_GetBufferPoolStats();
+
+// Releases every idle pooled texture and buffer, call before Render_ShutDown.
+void RenderGraph_ReleasePools();
+
+// Times from running a schedule on simulated queues, in the units of the pass costs. Serial time is
+// every pass run back to back, the critical path is the longest chain of dependent passes and the
+// lower bound for any schedule.
+struct RenderGraphScheduleTiming
+{
+	float serialTime = 0.0f;
+	float scheduledTime = 0.0f;
+	float overlapTime = 0.0f;
+	float criticalPathTime = 0.0f;
+};
+
+// Runs the schedule with one simulated executor per queue, passCosts holds a cost for each consolidated pass.
+RenderGraphScheduleTiming RenderGraph_SimulateSchedule(const RenderGraphSchedule& schedule, const float* passCosts);
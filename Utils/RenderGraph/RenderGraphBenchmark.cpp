@@ -0,0 +1,79 @@
+#include "RenderGraphBenchmark.h"
+
+#include "Utils/HighResolutionClock.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace
+{
+	constexpr u32 kPassCounts[] = { 10, 100, 1000, 2000, 10000 };
+
+	void AddLightingGraph(RenderGraph& rg, u32 passes)
+	{
+		RenderGraphTextureDesc shadowDesc;
+		shadowDesc.width = 256;
+		shadowDesc.height = 256;
+		shadowDesc.format = RenderFormat::D32_FLOAT;
+
+		RenderGraphTextureDesc colorDesc;
+		colorDesc.width = 1280;
+		colorDesc.height = 720;
+		colorDesc.format = RenderFormat::R16G16B16A16_FLOAT;
+
+		const RenderGraphResource_t accum = rg.RegisterTexture("Accum", colorDesc);
+		const RenderGraphResource_t output = rg.RegisterTexture("Output", colorDesc);
+
+		auto nop = [](RenderGraph&, CommandList*) {};
+
+		rg.AddPass("Clear", RenderPassType::GRAPHICS).AddRenderTarget(accum, RenderPassOutputAccess::CLEAR).SetExecuteCallback(nop);
+
+		// Clear and resolve are the other two passes.
+		const u32 lights = passes > 2 ? (passes - 2) / 2 : 0;
+		for (u32 light = 0; light < lights; light++)
+		{
+			const std::string index = std::to_string(light);
+			const RenderGraphResource_t shadowMap = rg.RegisterTexture("Shadow" + index, shadowDesc);
+
+			rg.AddPass("ShadowPass" + index, RenderPassType::GRAPHICS).AddDepthTarget(shadowMap, RenderPassOutputAccess::CLEAR).SetExecuteCallback(nop);
+			rg.AddPass("Light" + index, RenderPassType::GRAPHICS).AddRenderTarget(accum, RenderPassOutputAccess::LOAD).ReadResource(shadowMap).SetExecuteCallback(nop);
+		}
+
+		rg.AddPass("Resolve", RenderPassType::GRAPHICS).AddRenderTarget(output, RenderPassOutputAccess::DONT_CARE).ReadResource(accum).MakeRoot().SetExecuteCallback(nop);
+	}
+}
+
+void RenderGraph_RunScalingBenchmark(std::vector<RenderGraphBenchmarkResult>& results, u32 repeats)
+{
+	const bool compileCaching = RenderGraph_GetCompileCaching();
+	RenderGraph_SetCompileCaching(false);
+
+	results.clear();
+
+	for (u32 passes : kPassCounts)
+	{
+		RenderGraphBenchmarkResult result;
+		result.passes = passes;
+		result.buildMs = DBL_MAX;
+
+		for (u32 repeat = 0; repeat < std::max(repeats, 1u); repeat++)
+		{
+			RenderGraph rg;
+			AddLightingGraph(rg, passes);
+
+			HighResolutionClock clock;
+			clock.Reset();
+
+			rg.Build();
+
+			clock.Tick();
+			result.buildMs = std::min(result.buildMs, clock.GetDeltaMilliseconds());
+			result.transientTextures = rg.GetStats().transientTextures;
+			result.physicalTextures = rg.GetStats().physicalTextures;
+		}
+
+		results.push_back(result);
+	}
+
+	RenderGraph_SetCompileCaching(compileCaching);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "RenderGraph.h"
+
+#include <vector>
+
+// Build time of graphs from 10 to 10,000 passes: a clear, a shadow pass and a lighting pass per light
+// reading its own transient shadow map, then a resolve. buildMs is the best of the repeats.
+struct RenderGraphBenchmarkResult
+{
+	u32 passes = 0;
+	double buildMs = 0.0;
+	u32 transientTextures = 0;
+	u32 physicalTextures = 0;
+};
+
+// Compile caching is disabled while the graphs are built so every build compiles, and restored
+// afterwards. Needs an initialised renderer, the null backend keeps device cost out of the timings.
+void RenderGraph_RunScalingBenchmark(std::vector<RenderGraphBenchmarkResult>& results, u32 repeats = 5);
@@ -1,8 +1,25 @@
 #pragma once
 
 #include <assert.h>
+#include <cfloat>
+#include <cmath>
 #include <memory>
 
+// SIMD backend for the hot matrix and vector ops. SSE is used on x86 and x64, with AVX broadcasts and
+// FMA when the compiler targets them, and NEON on ARM64. Define SURFMATH_NO_SIMD to build the scalar
+// versions instead, they stay available with a Scalar suffix for comparison either way.
+#if !defined(SURFMATH_NO_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#define SURFMATH_SSE 1
+#define SURFMATH_SIMD 1
+#include <immintrin.h>
+#elif !defined(SURFMATH_NO_SIMD) && (defined(_M_ARM64) || defined(__aarch64__))
+#define SURFMATH_NEON 1
+#define SURFMATH_SIMD 1
+#include <arm_neon.h>
+#else
+#define SURFMATH_SIMD 0
+#endif
+
 typedef uint32_t u32;
 typedef int32_t i32;
 typedef uint16_t u16;
@@ -203,7 +220,6 @@ struct Vector4Component
         struct
         {
             Vector3Component<T> xyz;
-            T w;
         };
         T v[4];
     };
@@ -398,6 +414,277 @@ constexpr float4 k_FLTMAXF4 = float4(FLT_MAX);
 constexpr float4 k_FLTMINF4 = float4(-FLT_MAX);
 constexpr float4 k_HalfF4 = float4(0.5f);
 
+#if SURFMATH_SIMD
+// 4 wide float registers, kept to the operations the matrix code needs so each backend is a few
+// intrinsics. Loads and stores are unaligned, float4 and matrix have no alignment requirement.
+#if SURFMATH_SSE
+using SimdF4 = __m128;
+
+inline SimdF4 SimdLoadF4(const float* p) noexcept { return _mm_loadu_ps(p); }
+inline void SimdStoreF4(float* p, SimdF4 v) noexcept { _mm_storeu_ps(p, v); }
+inline SimdF4 SimdAddF4(SimdF4 a, SimdF4 b) noexcept { return _mm_add_ps(a, b); }
+inline SimdF4 SimdSubF4(SimdF4 a, SimdF4 b) noexcept { return _mm_sub_ps(a, b); }
+inline SimdF4 SimdMulF4(SimdF4 a, SimdF4 b) noexcept { return _mm_mul_ps(a, b); }
+inline SimdF4 SimdMergeXYF4(SimdF4 a, SimdF4 b) noexcept { return _mm_unpacklo_ps(a, b); }
+inline SimdF4 SimdMergeZWF4(SimdF4 a, SimdF4 b) noexcept { return _mm_unpackhi_ps(a, b); }
+inline float SimdGetXF4(SimdF4 v) noexcept { return _mm_cvtss_f32(v); }
+
+#if defined(__AVX__)
+inline SimdF4 SimdSplatF4(const float* p) noexcept { return _mm_broadcast_ss(p); }
+#else
+inline SimdF4 SimdSplatF4(const float* p) noexcept { return _mm_load_ps1(p); }
+#endif
+
+#if defined(__FMA__) || defined(__AVX2__)
+inline SimdF4 SimdMultiplyAddF4(SimdF4 a, SimdF4 b, SimdF4 c) noexcept { return _mm_fmadd_ps(a, b, c); }
+inline SimdF4 SimdNegativeMultiplySubtractF4(SimdF4 a, SimdF4 b, SimdF4 c) noexcept { return _mm_fnmadd_ps(a, b, c); }
+#else
+inline SimdF4 SimdMultiplyAddF4(SimdF4 a, SimdF4 b, SimdF4 c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+inline SimdF4 SimdNegativeMultiplySubtractF4(SimdF4 a, SimdF4 b, SimdF4 c) noexcept { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+#endif
+
+// Lanes i0 and i1 of a followed by lanes i2 and i3 of b.
+template<int i0, int i1, int i2, int i3>
+inline SimdF4 SimdShuffleF4(SimdF4 a, SimdF4 b) noexcept { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(i3, i2, i1, i0)); }
+
+// Lane i of v in every lane.
+template<int i>
+inline SimdF4 SimdSplatLaneF4(SimdF4 v) noexcept
+{
+#if defined(__AVX__)
+    return _mm_permute_ps(v, _MM_SHUFFLE(i, i, i, i));
+#else
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i));
+#endif
+}
+#elif SURFMATH_NEON
+using SimdF4 = float32x4_t;
+
+inline SimdF4 SimdLoadF4(const float* p) noexcept { return vld1q_f32(p); }
+inline void SimdStoreF4(float* p, SimdF4 v) noexcept { vst1q_f32(p, v); }
+inline SimdF4 SimdAddF4(SimdF4 a, SimdF4 b) noexcept { return vaddq_f32(a, b); }
+inline SimdF4 SimdSubF4(SimdF4 a, SimdF4 b) noexcept { return vsubq_f32(a, b); }
+inline SimdF4 SimdMulF4(SimdF4 a, SimdF4 b) noexcept { return vmulq_f32(a, b); }
+inline SimdF4 SimdMergeXYF4(SimdF4 a, SimdF4 b) noexcept { return vzip1q_f32(a, b); }
+inline SimdF4 SimdMergeZWF4(SimdF4 a, SimdF4 b) noexcept { return vzip2q_f32(a, b); }
+inline float SimdGetXF4(SimdF4 v) noexcept { return vgetq_lane_f32(v, 0); }
+inline SimdF4 SimdSplatF4(const float* p) noexcept { return vld1q_dup_f32(p); }
+inline SimdF4 SimdMultiplyAddF4(SimdF4 a, SimdF4 b, SimdF4 c) noexcept { return vfmaq_f32(c, a, b); }
+inline SimdF4 SimdNegativeMultiplySubtractF4(SimdF4 a, SimdF4 b, SimdF4 c) noexcept { return vfmsq_f32(c, a, b); }
+
+// Lanes i0 and i1 of a followed by lanes i2 and i3 of b.
+template<int i0, int i1, int i2, int i3>
+inline SimdF4 SimdShuffleF4(SimdF4 a, SimdF4 b) noexcept
+{
+    SimdF4 r = vdupq_n_f32(vgetq_lane_f32(a, i0));
+    r = vsetq_lane_f32(vgetq_lane_f32(a, i1), r, 1);
+    r = vsetq_lane_f32(vgetq_lane_f32(b, i2), r, 2);
+    return vsetq_lane_f32(vgetq_lane_f32(b, i3), r, 3);
+}
+
+// Lane i of v in every lane.
+template<int i>
+inline SimdF4 SimdSplatLaneF4(SimdF4 v) noexcept { return vdupq_laneq_f32(v, i); }
+#endif
+
+template<int i0, int i1, int i2, int i3>
+inline SimdF4 SimdSwizzleF4(SimdF4 v) noexcept { return SimdShuffleF4<i0, i1, i2, i3>(v, v); }
+
+inline float SimdDotF4(SimdF4 a, SimdF4 b) noexcept
+{
+    SimdF4 v = SimdMulF4(a, b);
+    v = SimdAddF4(v, SimdSwizzleF4<1, 0, 3, 2>(v));
+    v = SimdAddF4(v, SimdSwizzleF4<2, 3, 0, 1>(v));
+    return SimdGetXF4(v);
+}
+
+struct SimdMatrix
+{
+    SimdF4 r[4];
+};
+
+inline SimdMatrix SimdLoadMatrix(const matrix& m) noexcept
+{
+    return { { SimdLoadF4(m.r[0].v), SimdLoadF4(m.r[1].v), SimdLoadF4(m.r[2].v), SimdLoadF4(m.r[3].v) } };
+}
+
+inline matrix SimdStoreMatrix(const SimdMatrix& m) noexcept
+{
+    matrix result;
+    SimdStoreF4(result.r[0].v, m.r[0]);
+    SimdStoreF4(result.r[1].v, m.r[1]);
+    SimdStoreF4(result.r[2].v, m.r[2]);
+    SimdStoreF4(result.r[3].v, m.r[3]);
+    return result;
+}
+
+inline SimdMatrix SimdTransposeMatrix(const SimdMatrix& m) noexcept
+{
+    const SimdF4 p0 = SimdMergeXYF4(m.r[0], m.r[2]);
+    const SimdF4 p1 = SimdMergeXYF4(m.r[1], m.r[3]);
+    const SimdF4 p2 = SimdMergeZWF4(m.r[0], m.r[2]);
+    const SimdF4 p3 = SimdMergeZWF4(m.r[1], m.r[3]);
+
+    return { { SimdMergeXYF4(p0, p1), SimdMergeZWF4(p0, p1), SimdMergeXYF4(p2, p3), SimdMergeZWF4(p2, p3) } };
+}
+
+// Row vector a times the matrix, lane i of a scales row i.
+inline SimdF4 SimdMultiplyRowF4(SimdF4 a, const SimdMatrix& m) noexcept
+{
+    SimdF4 row = SimdMulF4(SimdSplatLaneF4<0>(a), m.r[0]);
+    row = SimdMultiplyAddF4(SimdSplatLaneF4<1>(a), m.r[1], row);
+    row = SimdMultiplyAddF4(SimdSplatLaneF4<2>(a), m.r[2], row);
+    return SimdMultiplyAddF4(SimdSplatLaneF4<3>(a), m.r[3], row);
+}
+
+// Every row of lhs is loaded before out is written, so out may alias lhs.
+inline void SimdMultiplyMatrix(const matrix& lhs, const SimdMatrix& rhs, matrix& out) noexcept
+{
+    const SimdF4 r0 = SimdMultiplyRowF4(SimdLoadF4(lhs.m[0]), rhs);
+    const SimdF4 r1 = SimdMultiplyRowF4(SimdLoadF4(lhs.m[1]), rhs);
+    const SimdF4 r2 = SimdMultiplyRowF4(SimdLoadF4(lhs.m[2]), rhs);
+    const SimdF4 r3 = SimdMultiplyRowF4(SimdLoadF4(lhs.m[3]), rhs);
+
+    SimdStoreF4(out.m[0], r0);
+    SimdStoreF4(out.m[1], r1);
+    SimdStoreF4(out.m[2], r2);
+    SimdStoreF4(out.m[3], r3);
+}
+
+inline matrix MultiplyMatrixSimd(const matrix& lhs, const matrix& rhs) noexcept
+{
+    matrix m;
+    SimdMultiplyMatrix(lhs, SimdLoadMatrix(rhs), m);
+    return m;
+}
+
+inline float3 TransformF3Simd(float3 v, const matrix& m) noexcept
+{
+    SimdF4 result = SimdMultiplyAddF4(SimdSplatF4(&v.z), SimdLoadF4(m.r[2].v), SimdLoadF4(m.r[3].v));
+    result = SimdMultiplyAddF4(SimdSplatF4(&v.y), SimdLoadF4(m.r[1].v), result);
+    result = SimdMultiplyAddF4(SimdSplatF4(&v.x), SimdLoadF4(m.r[0].v), result);
+
+    float4 out;
+    SimdStoreF4(out.v, result);
+    return out.xyz;
+}
+
+inline float4 TransformF4Simd(float4 v, const matrix& m) noexcept
+{
+    SimdF4 result = SimdMulF4(SimdSplatF4(&v.x), SimdLoadF4(m.r[0].v));
+    result = SimdMultiplyAddF4(SimdSplatF4(&v.y), SimdLoadF4(m.r[1].v), result);
+    result = SimdMultiplyAddF4(SimdSplatF4(&v.z), SimdLoadF4(m.r[2].v), result);
+    result = SimdMultiplyAddF4(SimdSplatF4(&v.w), SimdLoadF4(m.r[3].v), result);
+
+    float4 out;
+    SimdStoreF4(out.v, result);
+    return out;
+}
+
+inline matrix TransposeMatrixSimd(const matrix& m) noexcept
+{
+    return SimdStoreMatrix(SimdTransposeMatrix(SimdLoadMatrix(m)));
+}
+
+// Same cofactor expansion as InverseMatrixScalar, each float4 built from lanes of two vectors is
+// one or two shuffles.
+inline matrix InverseMatrixSimd(const matrix& m, float* outDeterminant = nullptr) noexcept
+{
+    const SimdMatrix mt = SimdTransposeMatrix(SimdLoadMatrix(m));
+
+    SimdF4 v00 = SimdSwizzleF4<0, 0, 1, 1>(mt.r[2]);
+    SimdF4 v10 = SimdSwizzleF4<2, 3, 2, 3>(mt.r[3]);
+    SimdF4 v01 = SimdSwizzleF4<0, 0, 1, 1>(mt.r[0]);
+    SimdF4 v11 = SimdSwizzleF4<2, 3, 2, 3>(mt.r[1]);
+    SimdF4 v02 = SimdShuffleF4<0, 2, 0, 2>(mt.r[2], mt.r[0]);
+    SimdF4 v12 = SimdShuffleF4<1, 3, 1, 3>(mt.r[3], mt.r[1]);
+
+    SimdF4 d0 = SimdMulF4(v00, v10);
+    SimdF4 d1 = SimdMulF4(v01, v11);
+    SimdF4 d2 = SimdMulF4(v02, v12);
+
+    v00 = SimdSwizzleF4<2, 3, 2, 3>(mt.r[2]);
+    v10 = SimdSwizzleF4<0, 0, 1, 1>(mt.r[3]);
+    v01 = SimdSwizzleF4<2, 3, 2, 3>(mt.r[0]);
+    v11 = SimdSwizzleF4<0, 0, 1, 1>(mt.r[1]);
+    v02 = SimdShuffleF4<1, 3, 1, 3>(mt.r[2], mt.r[0]);
+    v12 = SimdShuffleF4<0, 2, 0, 2>(mt.r[3], mt.r[1]);
+
+    d0 = SimdNegativeMultiplySubtractF4(v00, v10, d0);
+    d1 = SimdNegativeMultiplySubtractF4(v01, v11, d1);
+    d2 = SimdNegativeMultiplySubtractF4(v02, v12, d2);
+
+    v00 = SimdSwizzleF4<1, 2, 0, 1>(mt.r[1]);
+    v10 = SimdShuffleF4<0, 2, 3, 0>(SimdShuffleF4<1, 1, 1, 3>(d2, d0), d0);
+    v01 = SimdSwizzleF4<2, 0, 1, 0>(mt.r[0]);
+    v11 = SimdShuffleF4<0, 2, 1, 2>(SimdShuffleF4<3, 3, 1, 1>(d0, d2), d0);
+    v02 = SimdSwizzleF4<1, 2, 0, 1>(mt.r[3]);
+    v12 = SimdShuffleF4<0, 2, 3, 0>(SimdShuffleF4<3, 3, 1, 3>(d2, d1), d1);
+    SimdF4 v03 = SimdSwizzleF4<2, 0, 1, 0>(mt.r[2]);
+    SimdF4 v13 = SimdShuffleF4<0, 2, 1, 2>(SimdShuffleF4<3, 3, 3, 3>(d1, d2), d1);
+
+    SimdF4 c0 = SimdMulF4(v00, v10);
+    SimdF4 c2 = SimdMulF4(v01, v11);
+    SimdF4 c4 = SimdMulF4(v02, v12);
+    SimdF4 c6 = SimdMulF4(v03, v13);
+
+    v00 = SimdSwizzleF4<2, 3, 1, 2>(mt.r[1]);
+    v10 = SimdShuffleF4<3, 0, 0, 2>(d0, SimdShuffleF4<1, 1, 0, 0>(d0, d2));
+    v01 = SimdSwizzleF4<3, 2, 3, 1>(mt.r[0]);
+    v11 = SimdShuffleF4<2, 1, 0, 2>(d0, SimdShuffleF4<0, 0, 0, 0>(d2, d0));
+    v02 = SimdSwizzleF4<2, 3, 1, 2>(mt.r[3]);
+    v12 = SimdShuffleF4<3, 0, 0, 2>(d1, SimdShuffleF4<1, 1, 2, 2>(d1, d2));
+    v03 = SimdSwizzleF4<3, 2, 3, 1>(mt.r[2]);
+    v13 = SimdShuffleF4<2, 1, 0, 2>(d1, SimdShuffleF4<2, 2, 0, 0>(d2, d1));
+
+    c0 = SimdNegativeMultiplySubtractF4(v00, v10, c0);
+    c2 = SimdNegativeMultiplySubtractF4(v01, v11, c2);
+    c4 = SimdNegativeMultiplySubtractF4(v02, v12, c4);
+    c6 = SimdNegativeMultiplySubtractF4(v03, v13, c6);
+
+    v00 = SimdSwizzleF4<3, 0, 3, 0>(mt.r[1]);
+    v10 = SimdSwizzleF4<0, 2, 3, 0>(SimdShuffleF4<2, 2, 1, 0>(d0, d2));
+    v01 = SimdSwizzleF4<1, 3, 0, 2>(mt.r[0]);
+    v11 = SimdSwizzleF4<0, 2, 3, 1>(SimdShuffleF4<1, 0, 0, 3>(d2, d0));
+    v02 = SimdSwizzleF4<3, 0, 3, 0>(mt.r[3]);
+    v12 = SimdSwizzleF4<0, 2, 3, 0>(SimdShuffleF4<2, 2, 3, 2>(d1, d2));
+    v03 = SimdSwizzleF4<1, 3, 0, 2>(mt.r[2]);
+    v13 = SimdSwizzleF4<0, 2, 3, 1>(SimdShuffleF4<3, 2, 0, 3>(d2, d1));
+
+    const SimdF4 c1 = SimdNegativeMultiplySubtractF4(v00, v10, c0);
+    const SimdF4 c3 = SimdMultiplyAddF4(v01, v11, c2);
+    const SimdF4 c5 = SimdNegativeMultiplySubtractF4(v02, v12, c4);
+    const SimdF4 c7 = SimdMultiplyAddF4(v03, v13, c6);
+
+    c0 = SimdMultiplyAddF4(v00, v10, c0);
+    c2 = SimdNegativeMultiplySubtractF4(v01, v11, c2);
+    c4 = SimdMultiplyAddF4(v02, v12, c4);
+    c6 = SimdNegativeMultiplySubtractF4(v03, v13, c6);
+
+    // Even lanes from c0, c2, c4, c6 and odd lanes from c1, c3, c5, c7.
+    SimdMatrix r;
+    r.r[0] = SimdSwizzleF4<0, 2, 1, 3>(SimdShuffleF4<0, 2, 1, 3>(c0, c1));
+    r.r[1] = SimdSwizzleF4<0, 2, 1, 3>(SimdShuffleF4<0, 2, 1, 3>(c2, c3));
+    r.r[2] = SimdSwizzleF4<0, 2, 1, 3>(SimdShuffleF4<0, 2, 1, 3>(c4, c5));
+    r.r[3] = SimdSwizzleF4<0, 2, 1, 3>(SimdShuffleF4<0, 2, 1, 3>(c6, c7));
+
+    const float determinant = SimdDotF4(r.r[0], mt.r[0]);
+
+    if (outDeterminant)
+        *outDeterminant = determinant;
+
+    const float reciprocal = 1.0f / determinant;
+    const SimdF4 scale = SimdSplatF4(&reciprocal);
+
+    r.r[0] = SimdMulF4(r.r[0], scale);
+    r.r[1] = SimdMulF4(r.r[1], scale);
+    r.r[2] = SimdMulF4(r.r[2], scale);
+    r.r[3] = SimdMulF4(r.r[3], scale);
+
+    return SimdStoreMatrix(r);
+}
+#endif
+
 inline constexpr bool operator==(float3 lhs, float3 rhs) noexcept
 {
     return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
@@ -513,7 +800,7 @@ inline constexpr matrix2x3 operator*(matrix2 lhs, matrix2x3 rhs) noexcept
     return m;
 }
 
-inline constexpr matrix operator*(matrix lhs, matrix rhs) noexcept
+inline constexpr matrix MultiplyMatrixScalar(matrix lhs, matrix rhs) noexcept
 {
     matrix m;
     // Cache the invariants in registers
@@ -554,6 +841,15 @@ inline constexpr matrix operator*(matrix lhs, matrix rhs) noexcept
     return m;
 }
 
+inline matrix operator*(const matrix& lhs, const matrix& rhs) noexcept
+{
+#if SURFMATH_SIMD
+    return MultiplyMatrixSimd(lhs, rhs);
+#else
+    return MultiplyMatrixScalar(lhs, rhs);
+#endif
+}
+
 // Util
 template<typename T>
 inline constexpr T DivideRoundUp(T a, T b) noexcept { return (a + (b - T(1))) / b; }
@@ -693,7 +989,7 @@ inline float3 NormalizeF3(float3 f3) noexcept
     return float3(f3.x * length, f3.y * length, f3.z * length);
 }
 
-inline float3 TransformF3(float3 v, matrix m) noexcept
+inline float3 TransformF3Scalar(float3 v, matrix m) noexcept
 {
     float4 z(v.z);
     float4 y(v.y);
@@ -707,7 +1003,7 @@ inline float3 TransformF3(float3 v, matrix m) noexcept
     return result.xyz;
 }
 
-inline float4 TransformF4(float4 v, matrix m) noexcept
+inline float4 TransformF4Scalar(float4 v, matrix m) noexcept
 {
     float fX = (m.m[0][0] * v.v[0]) + (m.m[1][0] * v.v[1]) + (m.m[2][0] * v.v[2]) + (m.m[3][0] * v.v[3]);
     float fY = (m.m[0][1] * v.v[0]) + (m.m[1][1] * v.v[1]) + (m.m[2][1] * v.v[2]) + (m.m[3][1] * v.v[3]);
@@ -716,6 +1012,24 @@ inline float4 TransformF4(float4 v, matrix m) noexcept
     return float4(fX, fY, fZ, fW);
 }
 
+inline float3 TransformF3(float3 v, const matrix& m) noexcept
+{
+#if SURFMATH_SIMD
+    return TransformF3Simd(v, m);
+#else
+    return TransformF3Scalar(v, m);
+#endif
+}
+
+inline float4 TransformF4(float4 v, const matrix& m) noexcept
+{
+#if SURFMATH_SIMD
+    return TransformF4Simd(v, m);
+#else
+    return TransformF4Scalar(v, m);
+#endif
+}
+
 inline constexpr matrix3x4 MakeMatrix3x4(matrix m) noexcept
 {
     return matrix3x4(m.r[0], m.r[1], m.r[2]);
@@ -854,7 +1168,7 @@ inline matrix MakeMatrixRotationFromQuaternion(float4 quaternion)
     };
 }
 
-inline constexpr matrix TransposeMatrix(matrix m) noexcept
+inline constexpr matrix TransposeMatrixScalar(matrix m) noexcept
 {
     matrix p;
     p.r[0] = MergeXYF4(m.r[0], m.r[2]);
@@ -871,6 +1185,15 @@ inline constexpr matrix TransposeMatrix(matrix m) noexcept
     return mt;
 }
 
+inline matrix TransposeMatrix(const matrix& m) noexcept
+{
+#if SURFMATH_SIMD
+    return TransposeMatrixSimd(m);
+#else
+    return TransposeMatrixScalar(m);
+#endif
+}
+
 inline constexpr float Matrix2Determinant(matrix2 m) noexcept
 {
     return 1.0f / (m._11 * m._22 - m._12 * m._21);
@@ -891,9 +1214,9 @@ inline matrix2 InverseMatrix2(matrix2 m, float* outDeterminant = nullptr) noexce
 
 #define SWIZZLEF4(f, c0, c1, c2, c3) float4(f.c0, f.c1, f.c2, f.c3)
 
-inline matrix InverseMatrix(matrix m, float* outDeterminant = nullptr) noexcept
+inline matrix InverseMatrixScalar(matrix m, float* outDeterminant = nullptr) noexcept
 {
-    matrix mt = TransposeMatrix(m);
+    matrix mt = TransposeMatrixScalar(m);
 
     float4 v0[4], v1[4];
     v0[0] = SWIZZLEF4(mt.r[2], x, x, y, y);
@@ -987,6 +1310,15 @@ inline matrix InverseMatrix(matrix m, float* outDeterminant = nullptr) noexcept
     return result;
 }
 
+inline matrix InverseMatrix(const matrix& m, float* outDeterminant = nullptr) noexcept
+{
+#if SURFMATH_SIMD
+    return InverseMatrixSimd(m, outDeterminant);
+#else
+    return InverseMatrixScalar(m, outDeterminant);
+#endif
+}
+
 inline matrix MakeMatrixLookToLH(float3 eyePos, float3 eyeDir, float3 up) noexcept
 {
     assert(eyeDir != k_Vec3Zero);
@@ -1125,16 +1457,19 @@ struct AABB
         return (maxs - mins) * 0.5f;
     }
 
+    // Transforms the centre and projects the extents onto the absolute matrix axes, which gives the
+    // same box as growing by all 8 transformed corners for affine matrices.
     void Transform(const matrix& mat)
     {
-        float3 centre = Origin();
-        float3 extents = Extents();
+        const float3 centre = TransformF3(Origin(), mat);
+        const float3 extents = Extents();
 
-        maxs = -FLT_MAX;
-        mins = FLT_MAX;
+        float3 newExtents = float3(fabsf(mat._31), fabsf(mat._32), fabsf(mat._33)) * extents.z;
+        newExtents = MultiplyAddF3(float3(fabsf(mat._21), fabsf(mat._22), fabsf(mat._23)), float3(extents.y), newExtents);
+        newExtents = MultiplyAddF3(float3(fabsf(mat._11), fabsf(mat._12), fabsf(mat._13)), float3(extents.x), newExtents);
 
-        for (size_t i = 0; i < 8; i++)
-            Grow(TransformF3(MultiplyAddF3(extents, k_BoxOffsets[i], centre), mat));
+        mins = centre - newExtents;
+        maxs = centre + newExtents;
     }
 };
 
@@ -1216,3 +1551,134 @@ struct BoundingFrustum
     }
 };
 
+
+// Batched transforms
+// Structure-of-arrays views over caller owned storage, element i is (x[i], y[i], z[i]).
+// Each kernel reads a group of elements before writing it, so the output may be the same view as the input.
+struct Float3SoA
+{
+    float* x;
+    float* y;
+    float* z;
+};
+
+struct AABBSoA
+{
+    Float3SoA mins;
+    Float3SoA maxs;
+};
+
+inline void TransformF3SoA(const Float3SoA& points, size_t count, const matrix& m, const Float3SoA& outPoints) noexcept
+{
+    size_t i = 0;
+
+#if SURFMATH_SIMD
+    const SimdF4 m11 = SimdSplatF4(&m._11), m12 = SimdSplatF4(&m._12), m13 = SimdSplatF4(&m._13);
+    const SimdF4 m21 = SimdSplatF4(&m._21), m22 = SimdSplatF4(&m._22), m23 = SimdSplatF4(&m._23);
+    const SimdF4 m31 = SimdSplatF4(&m._31), m32 = SimdSplatF4(&m._32), m33 = SimdSplatF4(&m._33);
+    const SimdF4 m41 = SimdSplatF4(&m._41), m42 = SimdSplatF4(&m._42), m43 = SimdSplatF4(&m._43);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const SimdF4 x = SimdLoadF4(points.x + i);
+        const SimdF4 y = SimdLoadF4(points.y + i);
+        const SimdF4 z = SimdLoadF4(points.z + i);
+
+        SimdStoreF4(outPoints.x + i, SimdMultiplyAddF4(x, m11, SimdMultiplyAddF4(y, m21, SimdMultiplyAddF4(z, m31, m41))));
+        SimdStoreF4(outPoints.y + i, SimdMultiplyAddF4(x, m12, SimdMultiplyAddF4(y, m22, SimdMultiplyAddF4(z, m32, m42))));
+        SimdStoreF4(outPoints.z + i, SimdMultiplyAddF4(x, m13, SimdMultiplyAddF4(y, m23, SimdMultiplyAddF4(z, m33, m43))));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const float3 p = TransformF3Scalar(float3(points.x[i], points.y[i], points.z[i]), m);
+        outPoints.x[i] = p.x;
+        outPoints.y[i] = p.y;
+        outPoints.z[i] = p.z;
+    }
+}
+
+// Same centre and extents method as AABB::Transform, applied to 4 boxes at a time.
+inline void TransformAABBSoA(const AABBSoA& boxes, size_t count, const matrix& m, const AABBSoA& outBoxes) noexcept
+{
+    const matrix a = matrix(
+        float4(fabsf(m._11), fabsf(m._12), fabsf(m._13), 0.0f),
+        float4(fabsf(m._21), fabsf(m._22), fabsf(m._23), 0.0f),
+        float4(fabsf(m._31), fabsf(m._32), fabsf(m._33), 0.0f),
+        float4(0.0f));
+
+    size_t i = 0;
+
+#if SURFMATH_SIMD
+    const SimdF4 m11 = SimdSplatF4(&m._11), m12 = SimdSplatF4(&m._12), m13 = SimdSplatF4(&m._13);
+    const SimdF4 m21 = SimdSplatF4(&m._21), m22 = SimdSplatF4(&m._22), m23 = SimdSplatF4(&m._23);
+    const SimdF4 m31 = SimdSplatF4(&m._31), m32 = SimdSplatF4(&m._32), m33 = SimdSplatF4(&m._33);
+    const SimdF4 m41 = SimdSplatF4(&m._41), m42 = SimdSplatF4(&m._42), m43 = SimdSplatF4(&m._43);
+    const SimdF4 a11 = SimdSplatF4(&a._11), a12 = SimdSplatF4(&a._12), a13 = SimdSplatF4(&a._13);
+    const SimdF4 a21 = SimdSplatF4(&a._21), a22 = SimdSplatF4(&a._22), a23 = SimdSplatF4(&a._23);
+    const SimdF4 a31 = SimdSplatF4(&a._31), a32 = SimdSplatF4(&a._32), a33 = SimdSplatF4(&a._33);
+    const float half = 0.5f;
+    const SimdF4 halfF4 = SimdSplatF4(&half);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const SimdF4 minX = SimdLoadF4(boxes.mins.x + i);
+        const SimdF4 minY = SimdLoadF4(boxes.mins.y + i);
+        const SimdF4 minZ = SimdLoadF4(boxes.mins.z + i);
+        const SimdF4 maxX = SimdLoadF4(boxes.maxs.x + i);
+        const SimdF4 maxY = SimdLoadF4(boxes.maxs.y + i);
+        const SimdF4 maxZ = SimdLoadF4(boxes.maxs.z + i);
+
+        const SimdF4 cX = SimdMulF4(SimdAddF4(minX, maxX), halfF4);
+        const SimdF4 cY = SimdMulF4(SimdAddF4(minY, maxY), halfF4);
+        const SimdF4 cZ = SimdMulF4(SimdAddF4(minZ, maxZ), halfF4);
+        const SimdF4 eX = SimdMulF4(SimdSubF4(maxX, minX), halfF4);
+        const SimdF4 eY = SimdMulF4(SimdSubF4(maxY, minY), halfF4);
+        const SimdF4 eZ = SimdMulF4(SimdSubF4(maxZ, minZ), halfF4);
+
+        const SimdF4 centreX = SimdMultiplyAddF4(cX, m11, SimdMultiplyAddF4(cY, m21, SimdMultiplyAddF4(cZ, m31, m41)));
+        const SimdF4 centreY = SimdMultiplyAddF4(cX, m12, SimdMultiplyAddF4(cY, m22, SimdMultiplyAddF4(cZ, m32, m42)));
+        const SimdF4 centreZ = SimdMultiplyAddF4(cX, m13, SimdMultiplyAddF4(cY, m23, SimdMultiplyAddF4(cZ, m33, m43)));
+        const SimdF4 extentX = SimdMultiplyAddF4(eX, a11, SimdMultiplyAddF4(eY, a21, SimdMulF4(eZ, a31)));
+        const SimdF4 extentY = SimdMultiplyAddF4(eX, a12, SimdMultiplyAddF4(eY, a22, SimdMulF4(eZ, a32)));
+        const SimdF4 extentZ = SimdMultiplyAddF4(eX, a13, SimdMultiplyAddF4(eY, a23, SimdMulF4(eZ, a33)));
+
+        SimdStoreF4(outBoxes.mins.x + i, SimdSubF4(centreX, extentX));
+        SimdStoreF4(outBoxes.mins.y + i, SimdSubF4(centreY, extentY));
+        SimdStoreF4(outBoxes.mins.z + i, SimdSubF4(centreZ, extentZ));
+        SimdStoreF4(outBoxes.maxs.x + i, SimdAddF4(centreX, extentX));
+        SimdStoreF4(outBoxes.maxs.y + i, SimdAddF4(centreY, extentY));
+        SimdStoreF4(outBoxes.maxs.z + i, SimdAddF4(centreZ, extentZ));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const float3 mins = float3(boxes.mins.x[i], boxes.mins.y[i], boxes.mins.z[i]);
+        const float3 maxs = float3(boxes.maxs.x[i], boxes.maxs.y[i], boxes.maxs.z[i]);
+        const float3 centre = TransformF3Scalar((mins + maxs) * 0.5f, m);
+        const float3 extents = TransformF3Scalar((maxs - mins) * 0.5f, a);
+
+        outBoxes.mins.x[i] = centre.x - extents.x;
+        outBoxes.mins.y[i] = centre.y - extents.y;
+        outBoxes.mins.z[i] = centre.z - extents.z;
+        outBoxes.maxs.x[i] = centre.x + extents.x;
+        outBoxes.maxs.y[i] = centre.y + extents.y;
+        outBoxes.maxs.z[i] = centre.z + extents.z;
+    }
+}
+
+// outMatrices[i] = matrices[i] * rhs, with rhs held in registers across the batch. outMatrices may be matrices.
+inline void MultiplyMatrices(const matrix* matrices, size_t count, const matrix& rhs, matrix* outMatrices) noexcept
+{
+#if SURFMATH_SIMD
+    const SimdMatrix b = SimdLoadMatrix(rhs);
+
+    for (size_t i = 0; i < count; i++)
+        SimdMultiplyMatrix(matrices[i], b, outMatrices[i]);
+#else
+    for (size_t i = 0; i < count; i++)
+        outMatrices[i] = MultiplyMatrixScalar(matrices[i], rhs);
+#endif
+}
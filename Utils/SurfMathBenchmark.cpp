@@ -0,0 +1,251 @@
+#include "SurfMathBenchmark.h"
+
+#include "HighResolutionClock.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+namespace
+{
+	constexpr u32 kInputCount = 1024;
+
+	struct BenchmarkInputs
+	{
+		matrix matrices[kInputCount];
+		float3 points[kInputCount];
+		float4 vectors[kInputCount];
+
+		// SoA copies for the batched kernels, points in [0, 3) double as box mins and box maxs are in [3, 6).
+		float soa[6][kInputCount];
+	};
+
+	struct BenchmarkOutputs
+	{
+		matrix matrices[kInputCount];
+		float4 vectors[kInputCount];
+		float soa[6][kInputCount];
+
+		void Clear()
+		{
+			std::fill(std::begin(matrices), std::end(matrices), matrix());
+			std::fill(std::begin(vectors), std::end(vectors), float4());
+			std::fill(&soa[0][0], &soa[0][0] + 6 * kInputCount, 0.0f);
+		}
+	};
+
+	Float3SoA MakeSoA(float (&soa)[6][kInputCount], u32 first)
+	{
+		return Float3SoA{ soa[first], soa[first + 1], soa[first + 2] };
+	}
+
+	// Fixed seed so runs are comparable.
+	struct BenchmarkRandom
+	{
+		u32 state = 0x12345678u;
+
+		float Next()
+		{
+			state = state * 1664525u + 1013904223u;
+			return (float)(state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+		}
+	};
+
+	// Affine transforms with some noise in the last column so every element contributes, all invertible.
+	void FillInputs(BenchmarkInputs& inputs)
+	{
+		BenchmarkRandom random;
+
+		for (u32 i = 0; i < kInputCount; i++)
+		{
+			const float3 axis = NormalizeF3(float3(random.Next(), random.Next(), random.Next() + 2.0f));
+			matrix m = MakeMatrixRotationAxis(axis, random.Next() * K_PI) * MakeMatrixScaling(1.5f + random.Next(), 1.5f + random.Next(), 1.5f + random.Next());
+			m.r[3] = float4(random.Next() * 10.0f, random.Next() * 10.0f, random.Next() * 10.0f, 1.0f);
+			m._14 = random.Next() * 0.01f;
+			m._24 = random.Next() * 0.01f;
+			m._34 = random.Next() * 0.01f;
+
+			inputs.matrices[i] = m;
+			inputs.points[i] = float3(random.Next(), random.Next(), random.Next()) * 10.0f;
+			inputs.vectors[i] = float4(inputs.points[i], 1.0f);
+
+			for (u32 c = 0; c < 3; c++)
+			{
+				inputs.soa[c][i] = inputs.points[i].v[c];
+				inputs.soa[c + 3][i] = inputs.points[i].v[c] + 1.0f + random.Next();
+			}
+		}
+	}
+
+	template<typename Func>
+	double TimeNs(u32 iterations, Func&& func)
+	{
+		HighResolutionClock clock;
+		clock.Reset();
+
+		for (u32 i = 0; i < iterations; i++)
+			func(i % kInputCount);
+
+		clock.Tick();
+		return clock.GetDeltaNanoseconds() / iterations;
+	}
+
+	// Runs a kernel over all inputs per call, reporting time per element so results line up with TimeNs.
+	template<typename Func>
+	double TimeBatchNs(u32 iterations, Func&& func)
+	{
+		const u32 batches = Max(iterations / kInputCount, 1u);
+
+		func();
+
+		HighResolutionClock clock;
+		clock.Reset();
+
+		for (u32 i = 0; i < batches; i++)
+			func();
+
+		clock.Tick();
+		return clock.GetDeltaNanoseconds() / (batches * kInputCount);
+	}
+
+	float MaxDifference(const float* a, const float* b, u32 count)
+	{
+		float error = 0.0f;
+		for (u32 i = 0; i < count; i++)
+			error = Max(error, fabsf(a[i] - b[i]));
+		return error;
+	}
+
+	float MaxOutputDifference(const BenchmarkOutputs& a, const BenchmarkOutputs& b)
+	{
+		float error = MaxDifference(&a.matrices[0]._11, &b.matrices[0]._11, kInputCount * 16);
+		error = Max(error, MaxDifference(a.vectors[0].v, b.vectors[0].v, kInputCount * 4));
+		return Max(error, MaxDifference(a.soa[0], b.soa[0], kInputCount * 6));
+	}
+
+	// Times scalarFunc then simdFunc, each writing its result for input i to the outputs given.
+	template<typename ScalarFunc, typename SimdFunc>
+	SurfMathBenchmarkResult Benchmark(const char* name, u32 iterations, BenchmarkOutputs& scalarOut, BenchmarkOutputs& simdOut, ScalarFunc&& scalarFunc, SimdFunc&& simdFunc)
+	{
+		scalarOut.Clear();
+		simdOut.Clear();
+
+		SurfMathBenchmarkResult result;
+		result.name = name;
+		result.scalarNs = TimeNs(iterations, [&](u32 i) { scalarFunc(i, scalarOut); });
+		result.simdNs = TimeNs(iterations, [&](u32 i) { simdFunc(i, simdOut); });
+		result.maxError = MaxOutputDifference(scalarOut, simdOut);
+		return result;
+	}
+
+	// As Benchmark, but scalarFunc is the one at a time path and batchFunc the batched kernel, both covering all inputs.
+	template<typename ScalarFunc, typename BatchFunc>
+	SurfMathBenchmarkResult BenchmarkBatch(const char* name, u32 iterations, BenchmarkOutputs& scalarOut, BenchmarkOutputs& simdOut, ScalarFunc&& scalarFunc, BatchFunc&& batchFunc)
+	{
+		scalarOut.Clear();
+		simdOut.Clear();
+
+		SurfMathBenchmarkResult result;
+		result.name = name;
+		result.scalarNs = TimeBatchNs(iterations, [&]() { scalarFunc(scalarOut); });
+		result.simdNs = TimeBatchNs(iterations, [&]() { batchFunc(simdOut); });
+		result.maxError = MaxOutputDifference(scalarOut, simdOut);
+		return result;
+	}
+}
+
+const char* SurfMath_GetBackendName()
+{
+#if SURFMATH_SSE && defined(__AVX2__)
+	return "SSE AVX2";
+#elif SURFMATH_SSE && defined(__AVX__)
+	return "SSE AVX";
+#elif SURFMATH_SSE
+	return "SSE";
+#elif SURFMATH_NEON
+	return "NEON";
+#else
+	return "Scalar";
+#endif
+}
+
+void SurfMath_RunBenchmarks(std::vector<SurfMathBenchmarkResult>& results, u32 iterations)
+{
+	std::unique_ptr<BenchmarkInputs> inputs = std::make_unique<BenchmarkInputs>();
+	std::unique_ptr<BenchmarkOutputs> scalarOut = std::make_unique<BenchmarkOutputs>();
+	std::unique_ptr<BenchmarkOutputs> simdOut = std::make_unique<BenchmarkOutputs>();
+
+	FillInputs(*inputs);
+
+	BenchmarkInputs& in = *inputs;
+
+	results.clear();
+
+	results.push_back(Benchmark("MatrixMultiply", iterations, *scalarOut, *simdOut,
+		[&in](u32 i, BenchmarkOutputs& out) { out.matrices[i] = MultiplyMatrixScalar(in.matrices[i], in.matrices[(i + 1) % kInputCount]); },
+		[&in](u32 i, BenchmarkOutputs& out) { out.matrices[i] = in.matrices[i] * in.matrices[(i + 1) % kInputCount]; }));
+
+	results.push_back(Benchmark("TransformF3", iterations, *scalarOut, *simdOut,
+		[&in](u32 i, BenchmarkOutputs& out) { out.vectors[i] = float4(TransformF3Scalar(in.points[i], in.matrices[i]), 0.0f); },
+		[&in](u32 i, BenchmarkOutputs& out) { out.vectors[i] = float4(TransformF3(in.points[i], in.matrices[i]), 0.0f); }));
+
+	results.push_back(Benchmark("TransformF4", iterations, *scalarOut, *simdOut,
+		[&in](u32 i, BenchmarkOutputs& out) { out.vectors[i] = TransformF4Scalar(in.vectors[i], in.matrices[i]); },
+		[&in](u32 i, BenchmarkOutputs& out) { out.vectors[i] = TransformF4(in.vectors[i], in.matrices[i]); }));
+
+	results.push_back(Benchmark("TransposeMatrix", iterations, *scalarOut, *simdOut,
+		[&in](u32 i, BenchmarkOutputs& out) { out.matrices[i] = TransposeMatrixScalar(in.matrices[i]); },
+		[&in](u32 i, BenchmarkOutputs& out) { out.matrices[i] = TransposeMatrix(in.matrices[i]); }));
+
+	results.push_back(Benchmark("InverseMatrix", iterations, *scalarOut, *simdOut,
+		[&in](u32 i, BenchmarkOutputs& out) { out.matrices[i] = InverseMatrixScalar(in.matrices[i], &out.vectors[i].x); },
+		[&in](u32 i, BenchmarkOutputs& out) { out.matrices[i] = InverseMatrix(in.matrices[i], &out.vectors[i].x); }));
+
+	const Float3SoA inPoints = MakeSoA(in.soa, 0);
+	const AABBSoA inBoxes = { MakeSoA(in.soa, 0), MakeSoA(in.soa, 3) };
+
+	results.push_back(BenchmarkBatch("TransformF3SoA", iterations, *scalarOut, *simdOut,
+		[&in](BenchmarkOutputs& out)
+		{
+			for (u32 i = 0; i < kInputCount; i++)
+			{
+				const float3 p = TransformF3(in.points[i], in.matrices[0]);
+				out.soa[0][i] = p.x;
+				out.soa[1][i] = p.y;
+				out.soa[2][i] = p.z;
+			}
+		},
+		[&in, &inPoints](BenchmarkOutputs& out) { TransformF3SoA(inPoints, kInputCount, in.matrices[0], MakeSoA(out.soa, 0)); }));
+
+	results.push_back(BenchmarkBatch("TransformAABBSoA", iterations, *scalarOut, *simdOut,
+		[&in](BenchmarkOutputs& out)
+		{
+			// The per corner path AABB::Transform used before the batched kernels.
+			for (u32 i = 0; i < kInputCount; i++)
+			{
+				const BoundingBox box(AABB(float3(in.soa[0][i], in.soa[1][i], in.soa[2][i]), float3(in.soa[3][i], in.soa[4][i], in.soa[5][i])));
+
+				float3 corners[8];
+				box.GetCorners(corners);
+
+				AABB result;
+				for (const float3& corner : corners)
+					result.Grow(TransformF3(corner, in.matrices[0]));
+
+				for (u32 c = 0; c < 3; c++)
+				{
+					out.soa[c][i] = result.mins.v[c];
+					out.soa[c + 3][i] = result.maxs.v[c];
+				}
+			}
+		},
+		[&in, &inBoxes](BenchmarkOutputs& out) { TransformAABBSoA(inBoxes, kInputCount, in.matrices[0], AABBSoA{ MakeSoA(out.soa, 0), MakeSoA(out.soa, 3) }); }));
+
+	results.push_back(BenchmarkBatch("MultiplyMatrices", iterations, *scalarOut, *simdOut,
+		[&in](BenchmarkOutputs& out)
+		{
+			for (u32 i = 0; i < kInputCount; i++)
+				out.matrices[i] = in.matrices[i] * in.matrices[0];
+		},
+		[&in](BenchmarkOutputs& out) { MultiplyMatrices(in.matrices, kInputCount, in.matrices[0], out.matrices); }));
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SurfMath.h"
+
+// Time per call of the matrix and vector ops with a SIMD path, against their scalar versions on
+// the same inputs. maxError is the largest relative difference between the two results. Batched
+// kernels report time per element against transforming the elements one at a time.
+struct SurfMathBenchmarkResult
+{
+	const char* name = nullptr;
+	double scalarNs = 0.0;
+	double simdNs = 0.0;
+	float maxError = 0.0f;
+};
+
+// Backend the SurfMath API is built with, "Scalar" when SIMD is unavailable or disabled.
+const char* SurfMath_GetBackendName();
+
+// Runs each op over a fixed set of inputs iterations times in both versions. Without a SIMD backend
+// the SIMD timings are of the scalar API.
+void SurfMath_RunBenchmarks(std::vector<SurfMathBenchmarkResult>& results, u32 iterations = 1u << 18);
@@ -28,5 +28,34 @@ void ImGui_RenderDebug()
 	ImGui::Text("Compute Shaders: %d", Shaders_GetComputeShaderCount());
 	ImGui::Text("Textures: %d", Texture_GetTextureCount());
 
+	ImGui::Separator();
+
+	const CommandListStats& clStats = CommandList_GetStats();
+	ImGui::Text("Bind Calls: %zu", clStats.bindCalls);
+	ImGui::Text("Bind Calls Skipped: %zu", clStats.bindCallsSkipped);
+	ImGui::Text("Bind Slots Skipped: %zu", clStats.slotsSkipped);
+	ImGui::Text("Bind Calls Issued: %zu", clStats.bindCallsIssued);
+	ImGui::Text("Pipeline Changes Skipped: %zu", clStats.pipelineChangesSkipped);
+
+	ImGui::Separator();
+
+	const DynamicBufferStats& dbStats = DynamicBuffers_GetStats();
+	ImGui::Text("Dynamic Allocations: %zu", dbStats.allocations);
+	ImGui::Text("Dynamic Bytes: %zu", dbStats.bytes);
+	ImGui::Text("Dynamic Alignment Bytes: %zu", dbStats.alignmentBytes);
+	ImGui::Text("Dynamic Pages: %zu (%zu bytes)", dbStats.pageCount, dbStats.pageBytes);
+
+	ImGui::Separator();
+
+	std::vector<ResourceTableMemoryReport> tableReports;
+	Textures_GetMemoryReports(tableReports);
+	Buffers_GetMemoryReports(tableReports);
+	Bindings_GetMemoryReports(tableReports);
+	Shaders_GetMemoryReports(tableReports);
+	PipelineStates_GetMemoryReports(tableReports);
+
+	for (const ResourceTableMemoryReport& report : tableReports)
+		ImGui::Text("%s Table: %zu/%zu (%zu bytes)", report.name, report.used, report.capacity, report.bytes);
+
 	ImGui::End();
 }